@@ -38,6 +38,7 @@
 #include <boost/asio/basic_readable_pipe.hpp>
 #include <boost/asio/basic_seq_packet_socket.hpp>
 #include <boost/asio/basic_serial_port.hpp>
+#include <boost/asio/basic_sharded_acceptor.hpp>
 #include <boost/asio/basic_signal_set.hpp>
 #include <boost/asio/basic_socket.hpp>
 #include <boost/asio/basic_socket_acceptor.hpp>
@@ -53,6 +54,7 @@
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/bind_immediate_executor.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/buffer_lease.hpp>
 #include <boost/asio/buffer_registration.hpp>
 #include <boost/asio/buffered_read_stream_fwd.hpp>
 #include <boost/asio/buffered_read_stream.hpp>
@@ -69,6 +71,7 @@
 #include <boost/asio/compose.hpp>
 #include <boost/asio/connect.hpp>
 #include <boost/asio/connect_pipe.hpp>
+#include <boost/asio/connection_arena.hpp>
 #include <boost/asio/consign.hpp>
 #include <boost/asio/coroutine.hpp>
 #include <boost/asio/deadline_timer.hpp>
@@ -102,7 +105,9 @@
 #include <boost/asio/handler_continuation_hook.hpp>
 #include <boost/asio/high_resolution_timer.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/io_context_group.hpp>
 #include <boost/asio/io_context_strand.hpp>
+#include <boost/asio/io_uring_options.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/io_service_strand.hpp>
 #include <boost/asio/ip/address.hpp>
@@ -177,6 +182,8 @@
 #include <boost/asio/this_coro.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <boost/asio/time_traits.hpp>
+#include <boost/asio/timer_wheel_traits.hpp>
+#include <boost/asio/transfer_file.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <boost/asio/use_future.hpp>
 #include <boost/asio/uses_executor.hpp>
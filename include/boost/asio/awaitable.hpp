@@ -25,6 +25,7 @@
 # include <experimental/coroutine>
 #endif // defined(BOOST_ASIO_HAS_STD_COROUTINE)
 
+#include <cstddef>
 #include <utility>
 #include <boost/asio/any_io_executor.hpp>
 
@@ -132,6 +133,34 @@ private:
   detail::awaitable_frame<T, Executor>* frame_;
 };
 
+/// Statistics on the allocation of coroutine frames.
+/**
+ * The frames of coroutines that return an @c awaitable are allocated from a
+ * pool owned by the thread that runs the coroutine, when that thread is
+ * running an @c io_context or is part of a @c thread_pool. Other threads take
+ * frames from a pool shared by all threads. Frames that do not fit in a pool,
+ * or that are allocated when the pools are empty, come from the heap.
+ */
+struct awaitable_frame_statistics
+{
+  /// The number of frames allocated from a pool.
+  std::size_t hits;
+
+  /// The number of frames allocated from the heap.
+  std::size_t misses;
+
+  /// The total size of all frames allocated, in bytes.
+  std::size_t bytes;
+};
+
+/// Get statistics on the allocation of coroutine frames.
+/**
+ * The statistics cover the frames allocated by all threads since the program
+ * started, including threads that are still running. Counts from other
+ * threads may lag slightly behind their allocations.
+ */
+inline awaitable_frame_statistics get_awaitable_frame_statistics();
+
 } // namespace asio
 } // namespace boost
 
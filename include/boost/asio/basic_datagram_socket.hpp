@@ -18,6 +18,7 @@
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
 #include <boost/asio/basic_socket.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/non_const_lvalue.hpp>
 #include <boost/asio/detail/throw_error.hpp>
@@ -63,6 +64,14 @@ private:
   class initiate_async_send_to;
   class initiate_async_receive;
   class initiate_async_receive_from;
+#if defined(BOOST_ASIO_HAS_MMSG)
+  class initiate_async_send_many_to;
+  class initiate_async_receive_many_from;
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+  class initiate_async_send_segments_to;
+  class initiate_async_receive_segments_from;
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
 
 public:
   /// The type of the executor associated with the object.
@@ -90,6 +99,32 @@ public:
   /// The endpoint type.
   typedef typename Protocol::endpoint endpoint_type;
 
+  /// Describes one datagram of a batch sent by async_send_many_to.
+  struct send_slot
+  {
+    /// The data to be sent as the datagram.
+    const_buffer buffer;
+
+    /// The remote endpoint to which the datagram is sent.
+    endpoint_type endpoint;
+
+    /// Set to the number of bytes sent.
+    std::size_t size;
+  };
+
+  /// Describes one datagram of a batch received by async_receive_many_from.
+  struct receive_slot
+  {
+    /// The buffer into which the datagram is received.
+    mutable_buffer buffer;
+
+    /// Set to the endpoint of the remote sender of the datagram.
+    endpoint_type endpoint;
+
+    /// Set to the number of bytes received.
+    std::size_t size;
+  };
+
   /// Construct a basic_datagram_socket without opening it.
   /**
    * This constructor creates a datagram socket without opening it. The open()
@@ -773,6 +808,304 @@ public:
         buffers, destination, flags);
   }
 
+#if defined(BOOST_ASIO_HAS_MMSG) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send a batch of datagrams, each to
+   * its own remote endpoint, using as few system calls as possible. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * The operation completes once at least one datagram has been sent. The
+   * datagrams are sent in order, and those that have not been sent when the
+   * operation completes may be passed to a subsequent call. At most 32
+   * datagrams are sent by one operation.
+   *
+   * @param slots An array of slots, each of which describes a datagram and its
+   * destination. The @c size member of each slot that is sent is set to the
+   * number of bytes sent. Ownership of the slots, and of the underlying memory
+   * blocks, is retained by the caller, which must guarantee that they remain
+   * valid until the completion handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @par Example
+   * @code
+   * boost::asio::ip::udp::socket::send_slot slots[2] = {
+   *   { boost::asio::buffer(data1, size1), destination1, 0 },
+   *   { boost::asio::buffer(data2, size2), destination2, 0 }
+   * };
+   * socket.async_send_many_to(slots, 2, handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_many_to(send_slot* slots, std::size_t count,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_send_many_to>(), token,
+          slots, count, socket_base::message_flags(0)))
+  {
+    return async_initiate<WriteToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_send_many_to(this), token,
+        slots, count, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send a batch of datagrams, each to
+   * its own remote endpoint, using as few system calls as possible. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * The operation completes once at least one datagram has been sent. The
+   * datagrams are sent in order, and those that have not been sent when the
+   * operation completes may be passed to a subsequent call. At most 32
+   * datagrams are sent by one operation.
+   *
+   * @param slots An array of slots, each of which describes a datagram and its
+   * destination. The @c size member of each slot that is sent is set to the
+   * number of bytes sent. Ownership of the slots, and of the underlying memory
+   * blocks, is retained by the caller, which must guarantee that they remain
+   * valid until the completion handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_many_to(send_slot* slots, std::size_t count,
+      socket_base::message_flags flags,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_send_many_to>(), token,
+          slots, count, flags))
+  {
+    return async_initiate<WriteToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_send_many_to(this), token,
+        slots, count, flags);
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a buffer as a train of datagrams.
+  /**
+   * This function is used to asynchronously send data to the specified remote
+   * endpoint as a sequence of datagrams, each holding @c segment_size bytes
+   * except the last, which holds the remainder. The data is passed through the
+   * network stack once and split into datagrams by the kernel or the network
+   * interface, rather than being sent with one system call per datagram. It is
+   * an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param segment_size The size of each datagram. If zero, the size set on
+   * the socket using the ip::udp::segment_size option is used.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @note The kernel limits the total size of the data to that of a single
+   * UDP datagram, and the number of datagrams to 64. Larger sends fail with
+   * boost::asio::error::invalid_argument.
+   *
+   * @par Example
+   * To send 16 datagrams of 1200 bytes each:
+   * @code
+   * socket.async_send_segments_to(
+   *     boost::asio::buffer(data, 16 * 1200), 1200, destination, handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ConstBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_segments_to(const ConstBufferSequence& buffers,
+      std::size_t segment_size, const endpoint_type& destination,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_send_segments_to>(), token, buffers,
+          segment_size, destination, socket_base::message_flags(0)))
+  {
+    return async_initiate<WriteToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_send_segments_to(this), token, buffers,
+        segment_size, destination, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous send of a buffer as a train of datagrams.
+  /**
+   * This function is used to asynchronously send data to the specified remote
+   * endpoint as a sequence of datagrams, each holding @c segment_size bytes
+   * except the last, which holds the remainder. The data is passed through the
+   * network stack once and split into datagrams by the kernel or the network
+   * interface, rather than being sent with one system call per datagram. It is
+   * an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately.
+   *
+   * @param buffers One or more data buffers to be sent to the remote endpoint.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param segment_size The size of each datagram. If zero, the size set on
+   * the socket using the ip::udp::segment_size option is used.
+   *
+   * @param destination The remote endpoint to which the data will be sent.
+   * Copies will be made of the endpoint as required.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes. Potential
+   * completion tokens include @ref use_future, @ref use_awaitable, @ref
+   * yield_context, or a function object with the correct completion signature.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @note The kernel limits the total size of the data to that of a single
+   * UDP datagram, and the number of datagrams to 64. Larger sends fail with
+   * boost::asio::error::invalid_argument.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ConstBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_segments_to(const ConstBufferSequence& buffers,
+      std::size_t segment_size, const endpoint_type& destination,
+      socket_base::message_flags flags,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_send_segments_to>(), token,
+          buffers, segment_size, destination, flags))
+  {
+    return async_initiate<WriteToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_send_segments_to(this), token,
+        buffers, segment_size, destination, flags);
+  }
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Receive some data on a connected socket.
   /**
    * This function is used to receive data on the datagram socket. The function
@@ -1213,6 +1546,312 @@ public:
         buffers, &sender_endpoint, flags);
   }
 
+#if defined(BOOST_ASIO_HAS_MMSG) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive a batch of datagrams using
+   * as few system calls as possible. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * The operation completes once at least one datagram has been received, with
+   * as many of the datagrams already queued on the socket as fit into the
+   * slots. At most 32 datagrams are received by one operation.
+   *
+   * @param slots An array of slots, each of which provides a buffer into which
+   * a datagram will be received. The @c endpoint and @c size members of each
+   * slot that is filled are set to the sender of the datagram and the number
+   * of bytes received. Ownership of the slots, and of the underlying memory
+   * blocks, is retained by the caller, which must guarantee that they remain
+   * valid until the completion handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @par Example
+   * @code
+   * boost::asio::ip::udp::socket::receive_slot slots[2];
+   * slots[0].buffer = boost::asio::buffer(data1, size1);
+   * slots[1].buffer = boost::asio::buffer(data2, size2);
+   * socket.async_receive_many_from(slots, 2, handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_many_from(receive_slot* slots, std::size_t count,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_receive_many_from>(), token,
+          slots, count, socket_base::message_flags(0)))
+  {
+    return async_initiate<ReadToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_receive_many_from(this), token,
+        slots, count, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive a batch of datagrams using
+   * as few system calls as possible. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * The operation completes once at least one datagram has been received, with
+   * as many of the datagrams already queued on the socket as fit into the
+   * slots. At most 32 datagrams are received by one operation.
+   *
+   * @param slots An array of slots, each of which provides a buffer into which
+   * a datagram will be received. The @c endpoint and @c size members of each
+   * slot that is filled are set to the sender of the datagram and the number
+   * of bytes received. Ownership of the slots, and of the underlying memory
+   * blocks, is retained by the caller, which must guarantee that they remain
+   * valid until the completion handler is called.
+   *
+   * @param count The number of slots in the array.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams // Number of datagrams received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive_many_from(receive_slot* slots, std::size_t count,
+      socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_receive_many_from>(), token,
+          slots, count, flags))
+  {
+    return async_initiate<ReadToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_receive_many_from(this), token,
+        slots, count, flags);
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous receive of datagrams that may have been coalesced.
+  /**
+   * This function is used to asynchronously receive data that the kernel may
+   * have coalesced from several consecutive datagrams of the same size from
+   * the same sender. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * Datagrams are only coalesced once the ip::udp::generic_receive_offload
+   * option has been enabled on the socket. The completion handler is passed
+   * the size of the original datagrams, so that the data can be split at
+   * their boundaries: every @c segment_size bytes, with the last datagram
+   * possibly shorter. If the data was not coalesced, @c segment_size is equal
+   * to @c bytes_transferred.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * To receive a coalesced train the buffers should be large enough to hold
+   * a maximum size UDP datagram. Although the buffers object may be copied as
+   * necessary, ownership of the underlying memory blocks is retained by the
+   * caller, which must guarantee that they remain valid until the completion
+   * handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the completion handler is called.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred, // Number of bytes received.
+   *   std::size_t segment_size // Size of each datagram received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t, std::size_t) @endcode
+   *
+   * @par Example
+   * @code
+   * socket.set_option(boost::asio::ip::udp::generic_receive_offload(true));
+   * ...
+   * socket.async_receive_segments_from(boost::asio::buffer(data, 65536),
+   *     sender_endpoint,
+   *     [&](boost::system::error_code ec, std::size_t n, std::size_t size)
+   *     {
+   *       for (std::size_t i = 0; !ec && i < n; i += size)
+   *         process(data + i, std::min(size, n - i));
+   *     });
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t, std::size_t)) ReadToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_segments_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (boost::system::error_code, std::size_t, std::size_t)>(
+          declval<initiate_async_receive_segments_from>(), token, buffers,
+          &sender_endpoint, socket_base::message_flags(0)))
+  {
+    return async_initiate<ReadToken,
+      void (boost::system::error_code, std::size_t, std::size_t)>(
+        initiate_async_receive_segments_from(this), token, buffers,
+        &sender_endpoint, socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous receive of datagrams that may have been coalesced.
+  /**
+   * This function is used to asynchronously receive data that the kernel may
+   * have coalesced from several consecutive datagrams of the same size from
+   * the same sender. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * Datagrams are only coalesced once the ip::udp::generic_receive_offload
+   * option has been enabled on the socket. The completion handler is passed
+   * the size of the original datagrams, so that the data can be split at
+   * their boundaries: every @c segment_size bytes, with the last datagram
+   * possibly shorter. If the data was not coalesced, @c segment_size is equal
+   * to @c bytes_transferred.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * To receive a coalesced train the buffers should be large enough to hold
+   * a maximum size UDP datagram. Although the buffers object may be copied as
+   * necessary, ownership of the underlying memory blocks is retained by the
+   * caller, which must guarantee that they remain valid until the completion
+   * handler is called.
+   *
+   * @param sender_endpoint An endpoint object that receives the endpoint of
+   * the remote sender of the datagrams. Ownership of the sender_endpoint
+   * object is retained by the caller, which must guarantee that it is valid
+   * until the completion handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred, // Number of bytes received.
+   *   std::size_t segment_size // Size of each datagram received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t, std::size_t) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t, std::size_t)) ReadToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_segments_from(const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_base::message_flags flags,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (boost::system::error_code, std::size_t, std::size_t)>(
+          declval<initiate_async_receive_segments_from>(), token,
+          buffers, &sender_endpoint, flags))
+  {
+    return async_initiate<ReadToken,
+      void (boost::system::error_code, std::size_t, std::size_t)>(
+        initiate_async_receive_segments_from(this), token,
+        buffers, &sender_endpoint, flags);
+  }
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Disallow copying and assignment.
   basic_datagram_socket(const basic_datagram_socket&) = delete;
@@ -1354,6 +1993,141 @@ private:
   private:
     basic_datagram_socket* self_;
   };
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+  class initiate_async_send_many_to
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_many_to(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler>
+    void operator()(WriteHandler&& handler, send_slot* slots,
+        std::size_t count, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_many_to(
+          self_->impl_.get_implementation(), slots, count,
+          flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_many_from
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_many_from(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler>
+    void operator()(ReadHandler&& handler, receive_slot* slots,
+        std::size_t count, socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_many_from(
+          self_->impl_.get_implementation(), slots, count,
+          flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+  class initiate_async_send_segments_to
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_segments_to(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler, typename ConstBufferSequence>
+    void operator()(WriteHandler&& handler,
+        const ConstBufferSequence& buffers, std::size_t segment_size,
+        const endpoint_type& destination,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_segments_to(
+          self_->impl_.get_implementation(), buffers, segment_size,
+          destination, flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+
+  class initiate_async_receive_segments_from
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_segments_from(basic_datagram_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers, endpoint_type* sender_endpoint,
+        socket_base::message_flags flags) const
+    {
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+      self_->impl_.get_service().async_receive_segments_from(
+          self_->impl_.get_implementation(), buffers, *sender_endpoint,
+          flags, handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_datagram_socket* self_;
+  };
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
 };
 
 } // namespace asio
@@ -0,0 +1,267 @@
+//
+// basic_sharded_acceptor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BASIC_SHARDED_ACCEPTOR_HPP
+#define BOOST_ASIO_BASIC_SHARDED_ACCEPTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/basic_socket_acceptor.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context_group.hpp>
+#include <boost/asio/socket_base.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides a set of acceptors that share a single listening endpoint.
+/**
+ * The basic_sharded_acceptor class template opens one listening socket per
+ * execution context, each bound to the same endpoint using the
+ * socket_base::reuse_port option. The kernel then distributes incoming
+ * connections among the listening sockets, so that each context accepts and
+ * serves its own share of the connections without a single acceptor becoming a
+ * bottleneck.
+ *
+ * When constructed from an io_context_group, each shard may optionally be
+ * steered using the socket_base::incoming_cpu option, so that connections are
+ * preferentially accepted by the context whose thread is bound to the CPU that
+ * handled the connection's incoming packets.
+ *
+ * The acceptor for each shard is accessed using shard(), and asynchronous
+ * accept operations are started on it in the usual way.
+ *
+ * @par Example
+ * @code boost::asio::io_context_group group;
+ * boost::asio::basic_sharded_acceptor<boost::asio::ip::tcp> acceptors(
+ *     group, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), 80),
+ *     true);
+ *
+ * for (std::size_t i = 0; i < acceptors.size(); ++i)
+ *   start_accept(acceptors.shard(i)); @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @note Sharding requires support for the @c SO_REUSEPORT socket option.
+ * Where it is not available, construction fails unless only one shard is
+ * requested.
+ */
+template <typename Protocol, typename Executor = any_io_executor>
+class basic_sharded_acceptor
+{
+public:
+  /// The type of the executor associated with each shard.
+  typedef Executor executor_type;
+
+  /// The protocol type.
+  typedef Protocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// The type of the acceptor used for each shard.
+  typedef basic_socket_acceptor<Protocol, Executor> acceptor_type;
+
+  /// Construct a sharded acceptor with one shard per io_context in a group.
+  /**
+   * This constructor opens, binds and listens on one acceptor for each
+   * io_context in the group. If the endpoint's port is zero, the port chosen
+   * for the first shard is used for all of the others.
+   *
+   * @param group The group whose contexts will each own one shard.
+   *
+   * @param endpoint The endpoint on which the shards will listen.
+   *
+   * @param steer_by_cpu Whether to set the socket_base::incoming_cpu option on
+   * each shard to the CPU to which its context's thread is bound. This has no
+   * effect where the option is not supported, or for threads that are not
+   * bound to a CPU.
+   *
+   * @param backlog The maximum length of the queue of pending connections for
+   * each shard.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  basic_sharded_acceptor(io_context_group& group,
+      const endpoint_type& endpoint, bool steer_by_cpu = false,
+      int backlog = socket_base::max_listen_connections)
+  {
+    acceptors_.reserve(group.size());
+    for (std::size_t i = 0; i < group.size(); ++i)
+    {
+      acceptors_.push_back(acceptor_type(group.get_context(i)));
+      open_shard(acceptors_.back(), endpoint,
+          steer_by_cpu ? group.get_cpu(i) : -1, backlog);
+    }
+  }
+
+  /// Construct a sharded acceptor with one shard per executor in a range.
+  /**
+   * This constructor opens, binds and listens on one acceptor for each
+   * executor in the range. If the endpoint's port is zero, the port chosen for
+   * the first shard is used for all of the others.
+   *
+   * @param first The beginning of a range of executors.
+   *
+   * @param last The end of a range of executors.
+   *
+   * @param endpoint The endpoint on which the shards will listen.
+   *
+   * @param backlog The maximum length of the queue of pending connections for
+   * each shard.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  template <typename Iterator>
+  basic_sharded_acceptor(Iterator first, Iterator last,
+      const endpoint_type& endpoint,
+      int backlog = socket_base::max_listen_connections)
+  {
+    for (; first != last; ++first)
+    {
+      acceptors_.push_back(acceptor_type(*first));
+      open_shard(acceptors_.back(), endpoint, -1, backlog);
+    }
+  }
+
+  /// Move-construct a sharded acceptor from another.
+  basic_sharded_acceptor(basic_sharded_acceptor&& other) noexcept
+    : acceptors_(std::move(other.acceptors_))
+  {
+  }
+
+  /// Move-assign a sharded acceptor from another.
+  basic_sharded_acceptor& operator=(basic_sharded_acceptor&& other)
+  {
+    acceptors_ = std::move(other.acceptors_);
+    return *this;
+  }
+
+  /// Get the number of shards.
+  std::size_t size() const noexcept
+  {
+    return acceptors_.size();
+  }
+
+  /// Get the acceptor for the specified shard.
+  acceptor_type& shard(std::size_t index)
+  {
+    return acceptors_[index];
+  }
+
+  /// Get the acceptor for the specified shard.
+  const acceptor_type& shard(std::size_t index) const
+  {
+    return acceptors_[index];
+  }
+
+  /// Get the local endpoint on which the shards are listening.
+  /**
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  endpoint_type local_endpoint() const
+  {
+    return acceptors_.empty()
+      ? endpoint_type() : acceptors_.front().local_endpoint();
+  }
+
+  /// Cancel all asynchronous operations associated with every shard.
+  /**
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  void cancel()
+  {
+    for (std::size_t i = 0; i < acceptors_.size(); ++i)
+      acceptors_[i].cancel();
+  }
+
+  /// Close every shard.
+  /**
+   * Any asynchronous accept operations will be cancelled immediately.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  void close()
+  {
+    boost::system::error_code ec;
+    close(ec);
+    boost::asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close every shard.
+  /**
+   * Any asynchronous accept operations will be cancelled immediately. If
+   * several shards fail to close, the first error is reported.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  BOOST_ASIO_SYNC_OP_VOID close(boost::system::error_code& ec)
+  {
+    ec = boost::system::error_code();
+    for (std::size_t i = 0; i < acceptors_.size(); ++i)
+    {
+      boost::system::error_code shard_ec;
+      acceptors_[i].close(shard_ec);
+      if (shard_ec && !ec)
+        ec = shard_ec;
+    }
+    BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+private:
+  basic_sharded_acceptor(const basic_sharded_acceptor&) = delete;
+  basic_sharded_acceptor& operator=(
+      const basic_sharded_acceptor&) = delete;
+
+  // Open a shard and start it listening. All shards after the first bind to
+  // the endpoint chosen for the first.
+  void open_shard(acceptor_type& acceptor,
+      const endpoint_type& endpoint, int cpu, int backlog)
+  {
+    endpoint_type bind_endpoint = endpoint;
+    if (&acceptor != &acceptors_.front())
+      bind_endpoint = acceptors_.front().local_endpoint();
+
+    acceptor.open(bind_endpoint.protocol());
+    acceptor.set_option(socket_base::reuse_address(true));
+#if defined(SO_REUSEPORT)
+    acceptor.set_option(socket_base::reuse_port(true));
+#endif // defined(SO_REUSEPORT)
+#if defined(SO_INCOMING_CPU)
+    if (cpu >= 0)
+      acceptor.set_option(socket_base::incoming_cpu(cpu));
+#else // defined(SO_INCOMING_CPU)
+    (void)cpu;
+#endif // defined(SO_INCOMING_CPU)
+    acceptor.bind(bind_endpoint);
+    acceptor.listen(backlog);
+  }
+
+  // The acceptor for each shard.
+  std::vector<acceptor_type> acceptors_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_BASIC_SHARDED_ACCEPTOR_HPP
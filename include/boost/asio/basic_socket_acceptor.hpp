@@ -19,6 +19,7 @@
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/basic_socket.hpp>
+#include <boost/asio/detail/accept_many_op.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/io_object_impl.hpp>
 #include <boost/asio/detail/non_const_lvalue.hpp>
@@ -86,6 +87,7 @@ private:
   class initiate_async_wait;
   class initiate_async_accept;
   class initiate_async_move_accept;
+  class initiate_async_accept_many;
 
 public:
   /// The type of the executor associated with the object.
@@ -2028,6 +2030,101 @@ public:
               typename ExecutionContext::executor_type>::other*>(0));
   }
 
+  /// Start an asynchronous operation to accept many new connections.
+  /**
+   * This function is used to asynchronously accept a stream of new connections.
+   * It returns immediately. The operation then continues to accept connections,
+   * invoking a copy of the handler for each one, until an error occurs or the
+   * operation is cancelled.
+   *
+   * Where the io_uring backend is in use and supports it, a single multishot
+   * accept remains submitted for the lifetime of the operation, and each new
+   * connection is delivered as its completion arrives. Otherwise, the next
+   * accept is started before each connection is delivered, and first attempts
+   * a non-blocking accept so that a backlog of pending connections is drained
+   * without waiting for further readiness notifications.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called for each new connection. Copies
+   * will be made of the handler as required. Because the handler is called
+   * more than once, tokens that produce a handler which may be called only
+   * once, such as boost::asio::use_future, must not be used. Potential
+   * completion tokens include a function object, or one adapted by
+   * boost::asio::bind_executor or boost::asio::bind_cancellation_slot. The
+   * function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const boost::system::error_code& error,
+   *
+   *   // On success, the newly accepted socket.
+   *   typename Protocol::socket::template
+   *     rebind_executor<executor_type>::other peer
+   * ); @endcode
+   * The handler is called with a successful error code once for each accepted
+   * connection. It is called a final time, with the error that ended the
+   * operation and a socket that is not open, when the operation ends. Closing
+   * or cancelling the acceptor ends the operation with the
+   * boost::asio::error::operation_aborted error. Regardless of whether the
+   * asynchronous operation completes immediately or not, the completion
+   * handler will not be invoked from within this function. On immediate
+   * completion, invocation of the handler will be performed in a manner
+   * equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code,
+   *    typename Protocol::socket::template
+   *      rebind_executor<executor_type>::other)) @endcode
+   *
+   * @par Example
+   * @code
+   * void accept_handler(const boost::system::error_code& error,
+   *     boost::asio::ip::tcp::socket peer)
+   * {
+   *   if (!error)
+   *   {
+   *     // Accept succeeded. More connections will follow.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.async_accept_many(accept_handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        typename Protocol::socket::template rebind_executor<
+          executor_type>::other)) MultishotAcceptToken
+            = default_completion_token_t<executor_type>>
+  auto async_accept_many(MultishotAcceptToken&& token
+        = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<MultishotAcceptToken,
+        void (boost::system::error_code, typename Protocol::socket::template
+          rebind_executor<executor_type>::other)>(
+            declval<initiate_async_accept_many>(), token))
+  {
+    return async_initiate<MultishotAcceptToken,
+      void (boost::system::error_code, typename Protocol::socket::template
+        rebind_executor<executor_type>::other)>(
+          initiate_async_accept_many(this), token);
+  }
+
   /// Accept a new connection.
   /**
    * This function is used to accept a new connection from a peer. The function
@@ -2687,6 +2784,56 @@ private:
     basic_socket_acceptor* self_;
   };
 
+  class initiate_async_accept_many
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_accept_many(basic_socket_acceptor* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename MultishotAcceptHandler>
+    void operator()(MultishotAcceptHandler&& handler) const
+    {
+      typedef typename Protocol::socket::template
+        rebind_executor<executor_type>::other peer_socket_type;
+
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a MoveAcceptHandler.
+      BOOST_ASIO_MOVE_ACCEPT_HANDLER_CHECK(
+          MultishotAcceptHandler, handler, peer_socket_type) type_check;
+
+      // The handler is called once for each new connection, and so a copy is
+      // made for each call.
+      static_assert(
+          is_copy_constructible<decay_t<MultishotAcceptHandler>>::value,
+          "MultishotAcceptHandler must be copy constructible");
+
+      detail::non_const_lvalue<MultishotAcceptHandler> handler2(handler);
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT) \
+  && defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+      self_->impl_.get_service().async_move_accept_many(
+          self_->impl_.get_implementation(), self_->impl_.get_executor(),
+          handler2.value, self_->impl_.get_executor());
+#else // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+      //   && defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+      detail::accept_many_op<basic_socket_acceptor,
+        decay_t<MultishotAcceptHandler>>(*self_, handler2.value).start();
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+       //   && defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+    }
+
+  private:
+    basic_socket_acceptor* self_;
+  };
+
 #if defined(BOOST_ASIO_WINDOWS_RUNTIME)
   detail::io_object_impl<
     detail::null_socket_service<Protocol>, Executor> impl_;
@@ -19,8 +19,13 @@
 #include <cstddef>
 #include <boost/asio/async_result.hpp>
 #include <boost/asio/basic_socket.hpp>
+#include <boost/asio/buffer_lease.hpp>
+#include <boost/asio/detail/chrono.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/non_const_lvalue.hpp>
+#include <boost/asio/detail/receive_deadline_op.hpp>
+#include <boost/asio/detail/receive_stream_op.hpp>
 #include <boost/asio/detail/throw_error.hpp>
 #include <boost/asio/error.hpp>
 
@@ -64,6 +69,10 @@ class basic_stream_socket
 private:
   class initiate_async_send;
   class initiate_async_receive;
+  class initiate_async_receive_stream;
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  class initiate_async_send_file;
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
 
 public:
   /// The type of the executor associated with the object.
@@ -822,6 +831,270 @@ public:
         initiate_async_receive(this), token, buffers, flags);
   }
 
+  /// Start an asynchronous receive with a deadline.
+  /**
+   * This function is used to asynchronously receive data from the stream
+   * socket, failing if no data has been received by the specified deadline.
+   * It is an initiating function for an @ref asynchronous_operation, and
+   * always returns immediately.
+   *
+   * Where the io_uring backend is the default, the receive is submitted
+   * together with a linked timeout, so that the kernel enforces the deadline
+   * without a separate timer. Otherwise, the operation starts a timer that
+   * cancels the receive when the deadline expires.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param deadline The time by which data must have been received.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @note If the deadline expires before any data is received, the handler is
+   * called with the boost::asio::error::timed_out error.
+   *
+   * @par Example
+   * @code
+   * socket.async_receive(boost::asio::buffer(data, size),
+   *     std::chrono::steady_clock::now() + std::chrono::seconds(5),
+   *     handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive(const MutableBufferSequence& buffers,
+      const chrono::steady_clock::time_point& deadline,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_receive>(), token,
+          buffers, socket_base::message_flags(0), deadline))
+  {
+    return async_initiate<ReadToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_receive(this), token,
+        buffers, socket_base::message_flags(0), deadline);
+  }
+
+  /// Start an asynchronous receive with a deadline.
+  /**
+   * This function is used to asynchronously receive data, with the specified
+   * flags, from the stream socket, failing if no data has been received by
+   * the specified deadline. It is an initiating function for an
+   * @ref asynchronous_operation, and always returns immediately. It behaves
+   * as the overload without flags.
+   *
+   * @param buffers One or more buffers into which the data will be received.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param deadline The time by which data must have been received.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the receive completes.
+   * The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes received.
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   */
+  template <typename MutableBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_receive(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags,
+      const chrono::steady_clock::time_point& deadline,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_receive>(), token, buffers, flags, deadline))
+  {
+    return async_initiate<ReadToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_receive(this), token, buffers, flags, deadline);
+  }
+
+  /// Start an asynchronous operation to receive a stream of data.
+  /**
+   * This function is used to asynchronously receive data from the stream
+   * socket into buffers that are chosen by the implementation only once data
+   * has arrived. It returns immediately. The operation then continues to
+   * receive data, invoking a copy of the handler with each buffer, until an
+   * error occurs or the operation is cancelled. Buffer memory is therefore
+   * held only by connections with received data that has not yet been
+   * consumed, rather than by every connection with a pending receive.
+   *
+   * Where the io_uring backend is in use and supports it, a single multishot
+   * receive remains submitted for the lifetime of the operation, and the
+   * kernel fills buffers taken from a ring shared by all sockets on the
+   * execution context. Otherwise, each buffer is allocated when the socket
+   * becomes readable.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called for each buffer of received data.
+   * Copies will be made of the handler as required. Because the handler is
+   * called more than once, tokens that produce a handler which may be called
+   * only once, such as boost::asio::use_future, must not be used. Potential
+   * completion tokens include a function object, or one adapted by
+   * boost::asio::bind_executor or boost::asio::bind_cancellation_slot. The
+   * function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const boost::system::error_code& error,
+   *
+   *   // On success, a lease on the buffer holding the received data.
+   *   boost::asio::buffer_lease lease
+   * ); @endcode
+   * The handler is called with a successful error code once for each buffer
+   * of received data. It is called a final time, with the error that ended
+   * the operation and an empty lease, when the operation ends. The
+   * boost::asio::error::eof error indicates that the peer closed the
+   * connection, and closing or cancelling the socket ends the operation with
+   * the boost::asio::error::operation_aborted error. Regardless of whether the
+   * asynchronous operation completes immediately or not, the completion
+   * handler will not be invoked from within this function. On immediate
+   * completion, invocation of the handler will be performed in a manner
+   * equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, boost::asio::buffer_lease) @endcode
+   *
+   * @note Each buffer is returned for reuse when its lease is released or
+   * destroyed. Where buffers are taken from a shared ring, the operation ends
+   * with the boost::asio::error::no_buffer_space error if leases are held for
+   * long enough that the ring is exhausted.
+   *
+   * @par Example
+   * @code
+   * void receive_handler(const boost::system::error_code& error,
+   *     boost::asio::buffer_lease lease)
+   * {
+   *   if (!error)
+   *   {
+   *     process(lease.data());
+   *   }
+   * }
+   *
+   * ...
+   *
+   * socket.async_receive_stream(receive_handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        buffer_lease)) StreamReceiveToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_stream(StreamReceiveToken&& token
+        = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<StreamReceiveToken,
+        void (boost::system::error_code, buffer_lease)>(
+          declval<initiate_async_receive_stream>(), token,
+          socket_base::message_flags(0)))
+  {
+    return async_initiate<StreamReceiveToken,
+      void (boost::system::error_code, buffer_lease)>(
+        initiate_async_receive_stream(this), token,
+        socket_base::message_flags(0));
+  }
+
+  /// Start an asynchronous operation to receive a stream of data.
+  /**
+   * This function is used to asynchronously receive data, with the specified
+   * flags, from the stream socket into buffers that are chosen by the
+   * implementation only once data has arrived. It returns immediately, and
+   * behaves as the overload without flags.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called for each buffer of received data.
+   * Copies will be made of the handler as required. Tokens that produce a
+   * handler which may be called only once must not be used. The function
+   * signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const boost::system::error_code& error,
+   *
+   *   // On success, a lease on the buffer holding the received data.
+   *   boost::asio::buffer_lease lease
+   * ); @endcode
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, boost::asio::buffer_lease) @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        buffer_lease)) StreamReceiveToken
+          = default_completion_token_t<executor_type>>
+  auto async_receive_stream(socket_base::message_flags flags,
+      StreamReceiveToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<StreamReceiveToken,
+        void (boost::system::error_code, buffer_lease)>(
+          declval<initiate_async_receive_stream>(), token, flags))
+  {
+    return async_initiate<StreamReceiveToken,
+      void (boost::system::error_code, buffer_lease)>(
+        initiate_async_receive_stream(this), token, flags);
+  }
+
   /// Write some data to the socket.
   /**
    * This function is used to write data to the stream socket. The function call
@@ -951,6 +1224,79 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
+#if defined(BOOST_ASIO_HAS_SENDFILE) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous send of a range of a file.
+  /**
+   * This function is used to asynchronously send a range of a file's contents
+   * on the stream socket without copying the data through user space. It is
+   * an initiating function for an @ref asynchronous_operation, and always
+   * returns immediately. The operation continues until the whole range has
+   * been sent or an error occurs, and completes once.
+   *
+   * Where the io_uring backend is the default, the data is spliced from the
+   * file into a pipe and from the pipe to the socket. Otherwise, the data is
+   * sent using @c sendfile each time the socket becomes writable.
+   *
+   * @param file The file from which the data is sent, such as a
+   * basic_random_access_file or basic_stream_file. Its native handle must
+   * remain open until the completion handler is called. The file's current
+   * position, if any, is neither used nor changed.
+   *
+   * @param offset The offset within the file at which the range begins.
+   *
+   * @param length The number of bytes to send.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the send completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @note If the operation fails, @c bytes_transferred is the number of bytes
+   * sent before the failure. The boost::asio::error::eof error indicates that
+   * the file ended before the whole range was sent.
+   *
+   * @par Per-Operation Cancellation
+   * This asynchronous operation supports cancellation for the following
+   * boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename File,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) WriteToken = default_completion_token_t<executor_type>>
+  auto async_send_file(File& file, uint64_t offset, uint64_t length,
+      WriteToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<WriteToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_send_file>(), token,
+          file.native_handle(), offset, length))
+  {
+    return async_initiate<WriteToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_send_file(this), token,
+        file.native_handle(), offset, length);
+  }
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Read some data from the socket.
   /**
    * This function is used to read data from the stream socket. The function
@@ -1083,6 +1429,73 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
+  /// Start an asynchronous read with a deadline.
+  /**
+   * This function is used to asynchronously read data from the stream socket,
+   * failing if no data has been read by the specified deadline. It is an
+   * initiating function for an @ref asynchronous_operation, and always returns
+   * immediately.
+   *
+   * Where the io_uring backend is the default, the read is submitted together
+   * with a linked timeout, so that the kernel enforces the deadline without a
+   * separate timer. Otherwise, the operation starts a timer that cancels the
+   * read when the deadline expires.
+   *
+   * @param buffers One or more buffers into which the data will be read.
+   * Although the buffers object may be copied as necessary, ownership of the
+   * underlying memory blocks is retained by the caller, which must guarantee
+   * that they remain valid until the completion handler is called.
+   *
+   * @param deadline The time by which data must have been read.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the read completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes read.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::post().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code, std::size_t) @endcode
+   *
+   * @note If the deadline expires before any data is read, the handler is
+   * called with the boost::asio::error::timed_out error.
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename MutableBufferSequence,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+        std::size_t)) ReadToken = default_completion_token_t<executor_type>>
+  auto async_read_some(const MutableBufferSequence& buffers,
+      const chrono::steady_clock::time_point& deadline,
+      ReadToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReadToken,
+        void (boost::system::error_code, std::size_t)>(
+          declval<initiate_async_receive>(), token,
+          buffers, socket_base::message_flags(0), deadline))
+  {
+    return async_initiate<ReadToken,
+      void (boost::system::error_code, std::size_t)>(
+        initiate_async_receive(this), token,
+        buffers, socket_base::message_flags(0), deadline);
+  }
+
 private:
   // Disallow copying and assignment.
   basic_stream_socket(const basic_stream_socket&) = delete;
@@ -1152,9 +1565,116 @@ private:
           handler2.value, self_->impl_.get_executor());
     }
 
+    template <typename ReadHandler, typename MutableBufferSequence>
+    void operator()(ReadHandler&& handler,
+        const MutableBufferSequence& buffers,
+        socket_base::message_flags flags,
+        const chrono::steady_clock::time_point& deadline) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ReadHandler.
+      BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReadHandler> handler2(handler);
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+      self_->impl_.get_service().async_receive(
+          self_->impl_.get_implementation(), buffers, flags, deadline,
+          handler2.value, self_->impl_.get_executor());
+#else // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+      detail::receive_deadline_op<basic_stream_socket,
+        decay_t<ReadHandler>>(*self_, self_->impl_.get_service().context(),
+          handler2.value).start(buffers, flags, deadline);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+
+  class initiate_async_receive_stream
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_stream(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename StreamReceiveHandler>
+    void operator()(StreamReceiveHandler&& handler,
+        socket_base::message_flags flags) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a
+      // StreamReceiveHandler.
+      BOOST_ASIO_STREAM_RECEIVE_HANDLER_CHECK(
+          StreamReceiveHandler, handler) type_check;
+
+      // The handler is called once for each buffer of received data, and so a
+      // copy is made for each call.
+      static_assert(
+          is_copy_constructible<decay_t<StreamReceiveHandler>>::value,
+          "StreamReceiveHandler must be copy constructible");
+
+      detail::non_const_lvalue<StreamReceiveHandler> handler2(handler);
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT) \
+  && defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+      self_->impl_.get_service().async_receive_stream(
+          self_->impl_.get_implementation(), flags,
+          handler2.value, self_->impl_.get_executor());
+#else // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+      //   && defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+      detail::receive_stream_op<basic_stream_socket,
+        decay_t<StreamReceiveHandler>>(
+          *self_, flags, handler2.value).start();
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+       //   && defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  class initiate_async_send_file
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_send_file(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename WriteHandler>
+    void operator()(WriteHandler&& handler,
+        int file, uint64_t offset, uint64_t length) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WriteHandler.
+      BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+      detail::non_const_lvalue<WriteHandler> handler2(handler);
+      self_->impl_.get_service().async_send_file(
+          self_->impl_.get_implementation(), file, offset, length,
+          handler2.value, self_->impl_.get_executor());
+    }
+
   private:
     basic_stream_socket* self_;
   };
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
 };
 
 } // namespace asio
@@ -622,6 +622,81 @@ public:
     return s;
   }
 
+  /// Move the timer's expiry time, as an absolute time, without cancelling
+  /// pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_at(), any pending
+   * asynchronous wait operations are not cancelled. They remain pending and
+   * complete successfully once the new expiry time is reached, which may be
+   * earlier or later than the old one.
+   *
+   * This suits timeouts that are pushed back on every event, such as an idle
+   * timeout on a connection, as it avoids both the cancellation of the
+   * outstanding wait and the need to start a new one. Moving the expiry time
+   * later is especially cheap, as the timer is only repositioned among the
+   * other timers when its old expiry time is reached.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @note If the timer has already expired when reschedule_at() is called,
+   * then the handlers for asynchronous wait operations will:
+   *
+   * @li have already been invoked; or
+   *
+   * @li have been queued for invocation in the near future.
+   *
+   * These handlers are not affected by the new expiry time.
+   */
+  void reschedule_at(const time_point& expiry_time)
+  {
+    boost::system::error_code ec;
+    impl_.get_service().reschedule_at(
+        impl_.get_implementation(), expiry_time, ec);
+    boost::asio::detail::throw_error(ec, "reschedule_at");
+  }
+
+  /// Move the timer's expiry time, relative to now, without cancelling
+  /// pending waits.
+  /**
+   * This function sets the expiry time. Unlike expires_after(), any pending
+   * asynchronous wait operations are not cancelled. They remain pending and
+   * complete successfully once the new expiry time is reached, which may be
+   * earlier or later than the old one.
+   *
+   * @param expiry_time The expiry time to be used for the timer.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @note If the timer has already expired when reschedule_after() is called,
+   * then the handlers for asynchronous wait operations will:
+   *
+   * @li have already been invoked; or
+   *
+   * @li have been queued for invocation in the near future.
+   *
+   * These handlers are not affected by the new expiry time.
+   *
+   * @par Example
+   * @code
+   * void on_message(boost::asio::steady_timer& idle_timer)
+   * {
+   *   // Push back the idle timeout. The wait started when the connection
+   *   // was accepted stays pending, and completes only if no message
+   *   // arrives within the next thirty seconds.
+   *   idle_timer.reschedule_after(std::chrono::seconds(30));
+   * }
+   * @endcode
+   */
+  void reschedule_after(const duration& expiry_time)
+  {
+    boost::system::error_code ec;
+    impl_.get_service().reschedule_after(
+        impl_.get_implementation(), expiry_time, ec);
+    boost::asio::detail::throw_error(ec, "reschedule_after");
+  }
+
 #if !defined(BOOST_ASIO_NO_DEPRECATED)
   /// (Deprecated: Use expiry().) Get the timer's expiry time relative to now.
   /**
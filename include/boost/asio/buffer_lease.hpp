@@ -0,0 +1,172 @@
+//
+// buffer_lease.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_BUFFER_LEASE_HPP
+#define BOOST_ASIO_BUFFER_LEASE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/buffer.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+// The size of each buffer used to receive data into a buffer_lease.
+#if !defined(BOOST_ASIO_PROVIDED_BUFFER_SIZE)
+# define BOOST_ASIO_PROVIDED_BUFFER_SIZE 4096
+#endif // !defined(BOOST_ASIO_PROVIDED_BUFFER_SIZE)
+
+namespace boost {
+namespace asio {
+
+/// Holds a buffer of received data on loan from the implementation.
+/**
+ * A buffer_lease is passed to the handler of an operation, such as
+ * basic_stream_socket::async_receive_stream(), where the implementation
+ * chooses the buffer only once data has arrived. The buffer is returned to
+ * the implementation when the lease is released or destroyed, and so the
+ * lease should be released as soon as the data has been consumed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @note A lease must be released before the execution context that provided
+ * it is destroyed.
+ */
+class buffer_lease
+{
+public:
+  /// The type of a function used to return a buffer to its owner.
+  typedef void (*release_function)(void* owner, unsigned int id, void* data);
+
+  /// Construct an empty lease.
+  buffer_lease() noexcept
+    : release_(0),
+      owner_(0),
+      id_(0),
+      data_(0),
+      size_(0)
+  {
+  }
+
+  /// Construct a lease on a buffer.
+  /**
+   * @param release The function called to return the buffer to its owner.
+   *
+   * @param owner The owner argument passed to @c release.
+   *
+   * @param id The identifier argument passed to @c release.
+   *
+   * @param data The buffer memory, which is also passed to @c release.
+   *
+   * @param size The number of bytes of valid data in the buffer.
+   */
+  buffer_lease(release_function release, void* owner,
+      unsigned int id, void* data, std::size_t size) noexcept
+    : release_(release),
+      owner_(owner),
+      id_(id),
+      data_(data),
+      size_(size)
+  {
+  }
+
+  /// Move-construct a lease from another.
+  buffer_lease(buffer_lease&& other) noexcept
+    : release_(other.release_),
+      owner_(other.owner_),
+      id_(other.id_),
+      data_(other.data_),
+      size_(other.size_)
+  {
+    other.release_ = 0;
+    other.data_ = 0;
+    other.size_ = 0;
+  }
+
+  /// Move-assign a lease from another.
+  /**
+   * Any buffer currently held by the lease is first released.
+   */
+  buffer_lease& operator=(buffer_lease&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      release_ = other.release_;
+      owner_ = other.owner_;
+      id_ = other.id_;
+      data_ = other.data_;
+      size_ = other.size_;
+      other.release_ = 0;
+      other.data_ = 0;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /// Destructor releases the buffer.
+  ~buffer_lease()
+  {
+    release();
+  }
+
+  /// Get the received data.
+  const_buffer data() const noexcept
+  {
+    return const_buffer(data_, size_);
+  }
+
+  /// Get the number of bytes of received data.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// Determine whether the lease holds a buffer.
+  bool valid() const noexcept
+  {
+    return release_ != 0;
+  }
+
+  /// Return the buffer to its owner, leaving the lease empty.
+  void release() noexcept
+  {
+    if (release_)
+    {
+      release_function release = release_;
+      release_ = 0;
+      release(owner_, id_, data_);
+    }
+    data_ = 0;
+    size_ = 0;
+  }
+
+private:
+  buffer_lease(const buffer_lease&) = delete;
+  buffer_lease& operator=(const buffer_lease&) = delete;
+
+  release_function release_;
+  void* owner_;
+  unsigned int id_;
+  void* data_;
+  std::size_t size_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_BUFFER_LEASE_HPP
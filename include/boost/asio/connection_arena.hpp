@@ -0,0 +1,265 @@
+//
+// connection_arena.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_CONNECTION_ARENA_HPP
+#define BOOST_ASIO_CONNECTION_ARENA_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/slab_cache.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+#ifndef BOOST_ASIO_CONNECTION_ARENA_BLOCK_SIZE
+# define BOOST_ASIO_CONNECTION_ARENA_BLOCK_SIZE 4096
+#endif // BOOST_ASIO_CONNECTION_ARENA_BLOCK_SIZE
+
+namespace boost {
+namespace asio {
+
+template <typename T>
+class connection_arena_allocator;
+
+/// A memory arena for the asynchronous operations of a single connection.
+/**
+ * The @c connection_arena class carves memory out of large blocks obtained
+ * from the heap. Memory that is returned to the arena is kept on per-size
+ * free lists and reused for later allocations of a similar size, so a
+ * connection that repeatedly starts the same operations settles into a fixed
+ * footprint with no further heap traffic. All blocks are returned to the heap
+ * together when the arena is destroyed.
+ *
+ * An arena is bound to the operations of a connection by associating its
+ * allocator with their completion handlers, using @c bind_allocator. Composed
+ * operations such as @c async_read, @c async_write and @c async_read_until
+ * allocate their intermediate state using the associated allocator, as does
+ * @c co_spawn for the state of the coroutine thread it launches.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe. The operations that use an arena must not run
+ * concurrently, such as when they are all run on a single thread or through a
+ * single strand.
+ *
+ * @note The arena must outlive every operation that uses its allocator, and
+ * all memory obtained from it must be returned before it is destroyed.
+ *
+ * @par Example
+ * @code
+ * struct connection : std::enable_shared_from_this<connection>
+ * {
+ *   boost::asio::connection_arena arena_;
+ *   tcp::socket socket_;
+ *   char data_[1024];
+ *
+ *   void start_read()
+ *   {
+ *     socket_.async_read_some(boost::asio::buffer(data_),
+ *         boost::asio::bind_allocator(arena_.get_allocator(),
+ *           [self = shared_from_this()](error_code ec, std::size_t n)
+ *           {
+ *             ...
+ *           }));
+ *   }
+ * };
+ * @endcode
+ */
+class connection_arena
+  : private noncopyable
+{
+public:
+  /// The type of allocator used to allocate from the arena.
+  typedef connection_arena_allocator<void> allocator_type;
+
+  /// Construct an arena that obtains memory in blocks of the given size.
+  BOOST_ASIO_DECL explicit connection_arena(
+      std::size_t block_size = BOOST_ASIO_CONNECTION_ARENA_BLOCK_SIZE);
+
+  /// Destructor. Returns all memory held by the arena to the heap.
+  BOOST_ASIO_DECL ~connection_arena();
+
+  /// Obtain an allocator that allocates from the arena.
+  allocator_type get_allocator() noexcept;
+
+  /// Allocate memory from the arena.
+  /**
+   * Requests larger than the biggest size class, or with an alignment greater
+   * than that of the fundamental types, bypass the arena and go directly to
+   * the heap.
+   */
+  BOOST_ASIO_DECL void* allocate(std::size_t size,
+      std::size_t align = BOOST_ASIO_DEFAULT_ALIGN);
+
+  /// Return memory to the arena for reuse.
+  /**
+   * The size and alignment must be those given when the memory was
+   * allocated.
+   */
+  BOOST_ASIO_DECL void deallocate(void* p, std::size_t size,
+      std::size_t align = BOOST_ASIO_DEFAULT_ALIGN) noexcept;
+
+  /// Get the number of bytes obtained from the heap for the arena's blocks.
+  std::size_t bytes_reserved() const noexcept
+  {
+    return bytes_reserved_;
+  }
+
+private:
+  typedef detail::recycling_size_classes size_classes;
+
+  // Allocate a new block with room for at least the given number of bytes.
+  BOOST_ASIO_DECL void add_block(std::size_t size);
+
+  // The blocks that memory is carved from, linked through their first word.
+  void* blocks_;
+
+  // The unused part of the current block.
+  unsigned char* next_;
+  unsigned char* end_;
+
+  // The size of each block allocated from the heap.
+  std::size_t block_size_;
+
+  // The total number of bytes in all blocks.
+  std::size_t bytes_reserved_;
+
+  // The memory that has been returned to the arena, by size class.
+  detail::slab_free_list free_lists_[size_classes::num_classes];
+};
+
+/// An allocator that allocates memory from a @c connection_arena.
+template <typename T>
+class connection_arena_allocator
+{
+public:
+  /// The type of object allocated by the allocator.
+  typedef T value_type;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef connection_arena_allocator<U> other;
+  };
+
+  /// Construct an allocator that allocates from the given arena.
+  explicit connection_arena_allocator(connection_arena& arena) noexcept
+    : arena_(&arena)
+  {
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  connection_arena_allocator(
+      const connection_arena_allocator<U>& other) noexcept
+    : arena_(other.arena_)
+  {
+  }
+
+  /// Equality operator. Returns true if both allocators use the same arena.
+  bool operator==(const connection_arena_allocator& other) const noexcept
+  {
+    return arena_ == other.arena_;
+  }
+
+  /// Inequality operator.
+  bool operator!=(const connection_arena_allocator& other) const noexcept
+  {
+    return arena_ != other.arena_;
+  }
+
+  /// Allocate memory for the specified number of values.
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(arena_->allocate(sizeof(T) * n, alignof(T)));
+  }
+
+  /// Deallocate memory for the specified number of values.
+  void deallocate(T* p, std::size_t n)
+  {
+    arena_->deallocate(p, sizeof(T) * n, alignof(T));
+  }
+
+private:
+  template <typename> friend class connection_arena_allocator;
+
+  connection_arena* arena_;
+};
+
+/// A proto-allocator that allocates memory from a @c connection_arena.
+template <>
+class connection_arena_allocator<void>
+{
+public:
+  /// No values are allocated by a proto-allocator.
+  typedef void value_type;
+
+  /// Rebind the allocator to another value_type.
+  template <typename U>
+  struct rebind
+  {
+    /// The rebound @c allocator type.
+    typedef connection_arena_allocator<U> other;
+  };
+
+  /// Construct an allocator that allocates from the given arena.
+  explicit connection_arena_allocator(connection_arena& arena) noexcept
+    : arena_(&arena)
+  {
+  }
+
+  /// Converting constructor.
+  template <typename U>
+  connection_arena_allocator(
+      const connection_arena_allocator<U>& other) noexcept
+    : arena_(other.arena_)
+  {
+  }
+
+  /// Equality operator. Returns true if both allocators use the same arena.
+  bool operator==(const connection_arena_allocator& other) const noexcept
+  {
+    return arena_ == other.arena_;
+  }
+
+  /// Inequality operator.
+  bool operator!=(const connection_arena_allocator& other) const noexcept
+  {
+    return arena_ != other.arena_;
+  }
+
+private:
+  template <typename> friend class connection_arena_allocator;
+
+  connection_arena* arena_;
+};
+
+inline connection_arena::allocator_type
+connection_arena::get_allocator() noexcept
+{
+  return allocator_type(*this);
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/connection_arena.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_CONNECTION_ARENA_HPP
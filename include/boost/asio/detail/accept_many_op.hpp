@@ -0,0 +1,132 @@
+//
+// detail/accept_many_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_ACCEPT_MANY_OP_HPP
+#define BOOST_ASIO_DETAIL_ACCEPT_MANY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/associator.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Accepts connections one at a time, starting the next accept before handing
+// each new connection to a copy of the handler. Where the reactor supports
+// speculative operations, each new accept first tries a non-blocking accept,
+// so that a backlog of pending connections is drained without waiting for
+// another readiness notification.
+template <typename Acceptor, typename Handler>
+class accept_many_op
+{
+public:
+  typedef typename Acceptor::protocol_type::socket::template
+    rebind_executor<typename Acceptor::executor_type>::other peer_socket_type;
+
+  accept_many_op(Acceptor& acceptor, Handler& handler)
+    : acceptor_(acceptor),
+      start_(0),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  accept_many_op(const accept_many_op& other)
+    : acceptor_(other.acceptor_),
+      start_(other.start_),
+      handler_(other.handler_)
+  {
+  }
+
+  accept_many_op(accept_many_op&& other)
+    : acceptor_(other.acceptor_),
+      start_(other.start_),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  void start()
+  {
+    acceptor_.async_accept(static_cast<accept_many_op&&>(*this));
+  }
+
+  void operator()(const boost::system::error_code& ec, peer_socket_type peer)
+  {
+    start_ = 1;
+    if (!ec)
+    {
+      Handler handler(handler_);
+      acceptor_.async_accept(static_cast<accept_many_op&&>(*this));
+      static_cast<Handler&&>(handler)(ec,
+          static_cast<peer_socket_type&&>(peer));
+    }
+    else
+    {
+      static_cast<Handler&&>(handler_)(ec,
+          static_cast<peer_socket_type&&>(peer));
+    }
+  }
+
+//private:
+  Acceptor& acceptor_;
+  int start_;
+  Handler handler_;
+};
+
+template <typename Acceptor, typename Handler>
+inline bool asio_handler_is_continuation(
+    accept_many_op<Acceptor, Handler>* this_handler)
+{
+  return this_handler->start_ == 0
+    ? boost_asio_handler_cont_helpers::is_continuation(
+        this_handler->handler_)
+    : true;
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Acceptor, typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::accept_many_op<Acceptor, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::accept_many_op<Acceptor, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::accept_many_op<Acceptor, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_ACCEPT_MANY_OP_HPP
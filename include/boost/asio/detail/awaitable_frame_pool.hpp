@@ -0,0 +1,155 @@
+//
+// detail/awaitable_frame_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_AWAITABLE_FRAME_POOL_HPP
+#define BOOST_ASIO_DETAIL_AWAITABLE_FRAME_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <boost/asio/detail/slab_cache.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+#ifndef BOOST_ASIO_AWAITABLE_FRAME_CACHE_SIZE
+# define BOOST_ASIO_AWAITABLE_FRAME_CACHE_SIZE 32
+#endif // BOOST_ASIO_AWAITABLE_FRAME_CACHE_SIZE
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The size classes used to pool coroutine frames. Most frames are a few
+// hundred bytes, and a single request may keep several of them alive at
+// once, so small frames are pooled in fine steps of 64 bytes to limit the
+// waste within each frame. Frames above 1KB fall into doubling classes.
+struct awaitable_frame_size_classes
+{
+  enum
+  {
+    step = 64,
+    num_steps = 16,
+    max_step_size = step * num_steps,
+    max_size = 16384,
+    num_classes = num_steps + 4,
+    cache_size = BOOST_ASIO_AWAITABLE_FRAME_CACHE_SIZE,
+    cache_bytes_per_class = 262144
+  };
+
+  static std::size_t class_of(std::size_t size)
+  {
+    if (size <= max_step_size)
+      return size > 0 ? (size - 1) / step : 0;
+    std::size_t index = num_steps;
+    for (std::size_t s = max_step_size * 2; s < size; s <<= 1)
+      ++index;
+    return index;
+  }
+
+  static std::size_t class_size(std::size_t index)
+  {
+    if (index < num_steps)
+      return step * (index + 1);
+    return static_cast<std::size_t>(max_step_size) << (index - num_steps + 1);
+  }
+
+  static std::size_t cache_depth(std::size_t index)
+  {
+    std::size_t limit = cache_bytes_per_class / class_size(index);
+    limit = limit < 2 ? 2 : limit;
+    std::size_t depth = cache_size;
+    return depth < limit ? depth : limit;
+  }
+
+  static std::size_t depot_depth(std::size_t index)
+  {
+    return 4 * cache_depth(index);
+  }
+};
+
+// A per-thread pool of coroutine frames.
+typedef slab_cache<awaitable_frame_size_classes> awaitable_frame_pool;
+
+// The frame allocation counters. The counters are split into shards, each on
+// its own cache line, and each thread's pool counts into one shard, so that
+// threads allocating frames at the same time rarely contend. The counters are
+// read by summing the shards.
+class awaitable_frame_counters
+{
+public:
+  // Get the shard for a new pool. Pools are given shards in turn.
+  static slab_cache_counters& next_shard()
+  {
+    awaitable_frame_counters& c = instance();
+    std::size_t n = c.next_.fetch_add(1, std::memory_order_relaxed);
+    return c.shards_[n % num_shards];
+  }
+
+  // Get the shard for allocations by threads that have no pool.
+  static slab_cache_counters& shared_shard()
+  {
+    return instance().shards_[0];
+  }
+
+  // Get the sum of the counters.
+  static slab_cache_statistics get()
+  {
+    awaitable_frame_counters& c = instance();
+    slab_cache_statistics s = { 0, 0, 0 };
+    for (std::size_t i = 0; i < num_shards; ++i)
+    {
+      s.hits += c.shards_[i].hits.load(std::memory_order_relaxed);
+      s.misses += c.shards_[i].misses.load(std::memory_order_relaxed);
+      s.bytes += c.shards_[i].bytes.load(std::memory_order_relaxed);
+    }
+    return s;
+  }
+
+private:
+  enum { num_shards = 16 };
+
+  struct alignas(64) shard : slab_cache_counters
+  {
+  };
+
+  awaitable_frame_counters()
+    : next_(1)
+  {
+    for (std::size_t i = 0; i < num_shards; ++i)
+    {
+      shards_[i].hits.store(0, std::memory_order_relaxed);
+      shards_[i].misses.store(0, std::memory_order_relaxed);
+      shards_[i].bytes.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // The counters are never destroyed, so that threads can still allocate
+  // frames during static destruction.
+  static awaitable_frame_counters& instance()
+  {
+    static awaitable_frame_counters* counters = new awaitable_frame_counters;
+    return *counters;
+  }
+
+  shard shards_[num_shards];
+  std::atomic<std::size_t> next_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_AWAITABLE_FRAME_POOL_HPP
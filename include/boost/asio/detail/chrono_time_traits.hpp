@@ -46,6 +46,9 @@ struct chrono_time_traits
   // The period of the clock.
   typedef typename duration_type::period period_type;
 
+  // The wait traits.
+  typedef WaitTraits wait_traits_type;
+
   // Get the current time.
   static time_type now()
   {
@@ -797,7 +797,8 @@
 # include <unistd.h>
 #endif // defined(BOOST_ASIO_HAS_UNISTD_H)
 
-// Linux: epoll, eventfd, timerfd and io_uring.
+// Linux: epoll, eventfd, timerfd, io_uring, sendfile, recvmmsg/sendmmsg and UDP
+// segmentation offload.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(BOOST_ASIO_HAS_EPOLL)
@@ -826,6 +827,27 @@
 #   error Linux kernel 5.10 or later is required to support io_uring
 #  endif // LINUX_VERSION_CODE < KERNEL_VERSION(5,10,0)
 # endif // defined(BOOST_ASIO_HAS_IO_URING)
+# if !defined(BOOST_ASIO_HAS_SENDFILE)
+#  if !defined(BOOST_ASIO_DISABLE_SENDFILE)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,33)
+#    define BOOST_ASIO_HAS_SENDFILE 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,33)
+#  endif // !defined(BOOST_ASIO_DISABLE_SENDFILE)
+# endif // !defined(BOOST_ASIO_HAS_SENDFILE)
+# if !defined(BOOST_ASIO_HAS_MMSG)
+#  if !defined(BOOST_ASIO_DISABLE_MMSG)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0) && defined(_GNU_SOURCE)
+#    define BOOST_ASIO_HAS_MMSG 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(3,0,0) && ...
+#  endif // !defined(BOOST_ASIO_DISABLE_MMSG)
+# endif // !defined(BOOST_ASIO_HAS_MMSG)
+# if !defined(BOOST_ASIO_HAS_UDP_GSO)
+#  if !defined(BOOST_ASIO_DISABLE_UDP_GSO)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(5,0,0)
+#    define BOOST_ASIO_HAS_UDP_GSO 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,0,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_UDP_GSO)
+# endif // !defined(BOOST_ASIO_HAS_UDP_GSO)
 #endif // defined(__linux__)
 
 // Linux: io_uring is used instead of epoll.
@@ -835,6 +857,54 @@
 # endif // !defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_IO_URING)
 #endif // !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
 
+// Linux: io_uring multishot accept, which requires kernel 5.19 and liburing
+// 2.2 or later.
+#if defined(BOOST_ASIO_HAS_IO_URING)
+# if !defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+#  if !defined(BOOST_ASIO_DISABLE_IO_URING_MULTISHOT)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(5,19,0)
+#    define BOOST_ASIO_HAS_IO_URING_MULTISHOT 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,19,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_IO_URING_MULTISHOT)
+# endif // !defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+// Linux: io_uring multishot receive into provided buffer rings, which
+// requires kernel 6.0 and liburing 2.2 or later.
+#if defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+# if !defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+#  if !defined(BOOST_ASIO_DISABLE_IO_URING_PROVIDED_BUFFERS)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(6,0,0)
+#    define BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(6,0,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_IO_URING_PROVIDED_BUFFERS)
+# endif // !defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+
+// Linux: io_uring zero-copy send, which requires kernel 6.0 and liburing 2.3
+// or later.
+#if defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+# if !defined(BOOST_ASIO_HAS_IO_URING_SEND_ZC)
+#  if !defined(BOOST_ASIO_DISABLE_IO_URING_SEND_ZC)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(6,0,0)
+#    define BOOST_ASIO_HAS_IO_URING_SEND_ZC 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(6,0,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_IO_URING_SEND_ZC)
+# endif // !defined(BOOST_ASIO_HAS_IO_URING_SEND_ZC)
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+
+// Linux: io_uring wakeups sent from ring to ring, which require kernel 5.18
+// and liburing 2.2 or later.
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+# if !defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+#  if !defined(BOOST_ASIO_DISABLE_IO_URING_MSG_RING)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(5,18,0)
+#    define BOOST_ASIO_HAS_IO_URING_MSG_RING 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(5,18,0)
+#  endif // !defined(BOOST_ASIO_DISABLE_IO_URING_MSG_RING)
+# endif // !defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
 #if (defined(__MACH__) && defined(__APPLE__)) \
   || defined(__FreeBSD__) \
@@ -1067,6 +1137,17 @@
 # endif // defined(BOOST_ASIO_HAS_THREADS)
 #endif // !defined(BOOST_ASIO_HAS_PTHREADS)
 
+// Linux: binding POSIX threads to CPUs.
+#if !defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+# if !defined(BOOST_ASIO_DISABLE_THREAD_AFFINITY)
+#  if defined(__linux__) && defined(_GNU_SOURCE) \
+    && defined(BOOST_ASIO_HAS_PTHREADS)
+#   define BOOST_ASIO_HAS_THREAD_AFFINITY 1
+#  endif // defined(__linux__) && defined(_GNU_SOURCE)
+         //   && defined(BOOST_ASIO_HAS_PTHREADS)
+# endif // !defined(BOOST_ASIO_DISABLE_THREAD_AFFINITY)
+#endif // !defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+
 // Helper to prevent macro expansion.
 #define BOOST_ASIO_PREVENT_MACRO_SUBSTITUTION
 
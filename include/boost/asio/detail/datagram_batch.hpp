@@ -0,0 +1,108 @@
+//
+// detail/datagram_batch.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_DATAGRAM_BATCH_HPP
+#define BOOST_ASIO_DETAIL_DATAGRAM_BATCH_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+#include <cstddef>
+#include <boost/asio/detail/socket_types.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The message headers used to receive or send a batch of datagrams with a
+// single call. Each datagram is described by a slot, which has buffer,
+// endpoint and size members.
+template <typename Slot>
+class datagram_batch
+{
+public:
+  // The largest number of datagrams transferred by one operation.
+  enum { max_datagrams = 32 };
+
+  datagram_batch(Slot* slots, std::size_t count, bool is_receive)
+    : slots_(slots),
+      count_(count < max_datagrams
+          ? count : static_cast<std::size_t>(max_datagrams)),
+      is_receive_(is_receive)
+  {
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      iov_[i].iov_base = const_cast<void*>(
+          static_cast<const void*>(slots_[i].buffer.data()));
+      iov_[i].iov_len = slots_[i].buffer.size();
+      msgs_[i].msg_hdr = msghdr();
+      msgs_[i].msg_hdr.msg_iov = &iov_[i];
+      msgs_[i].msg_hdr.msg_iovlen = 1;
+      msgs_[i].msg_hdr.msg_name = slots_[i].endpoint.data();
+      msgs_[i].msg_hdr.msg_namelen = static_cast<socklen_t>(is_receive_
+          ? slots_[i].endpoint.capacity() : slots_[i].endpoint.size());
+      msgs_[i].msg_len = 0;
+    }
+  }
+
+  // The number of datagrams in the batch.
+  std::size_t count() const
+  {
+    return count_;
+  }
+
+  // The message headers, starting at the given datagram.
+  mmsghdr* msgs(std::size_t first = 0)
+  {
+    return msgs_ + first;
+  }
+
+  // Record the number of bytes transferred for a datagram that was not
+  // transferred as part of a batch.
+  void set_size(std::size_t i, std::size_t size)
+  {
+    msgs_[i].msg_len = static_cast<unsigned int>(size);
+  }
+
+  // Copy the results for the first n datagrams into their slots.
+  void complete(std::size_t n)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      slots_[i].size = msgs_[i].msg_len;
+      if (is_receive_)
+        slots_[i].endpoint.resize(msgs_[i].msg_hdr.msg_namelen);
+    }
+  }
+
+private:
+  Slot* slots_;
+  std::size_t count_;
+  bool is_receive_;
+  mmsghdr msgs_[max_datagrams];
+  iovec iov_[max_datagrams];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#endif // BOOST_ASIO_DETAIL_DATAGRAM_BATCH_HPP
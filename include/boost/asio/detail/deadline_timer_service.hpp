@@ -230,6 +230,31 @@ public:
         Time_Traits::add(Time_Traits::now(), expiry_time), ec);
   }
 
+  // Set the expiry time for the timer as an absolute time, without cancelling
+  // any pending asynchronous waits.
+  void reschedule_at(implementation_type& impl,
+      const time_type& expiry_time, boost::system::error_code& ec)
+  {
+    impl.expiry = expiry_time;
+    if (impl.might_have_pending_waits)
+    {
+      BOOST_ASIO_HANDLER_OPERATION((scheduler_.context(),
+            "deadline_timer", &impl, 0, "reschedule"));
+
+      scheduler_.reschedule_timer(timer_queue_, expiry_time, impl.timer_data);
+    }
+    ec = boost::system::error_code();
+  }
+
+  // Set the expiry time for the timer relative to now, without cancelling any
+  // pending asynchronous waits.
+  void reschedule_after(implementation_type& impl,
+      const duration_type& expiry_time, boost::system::error_code& ec)
+  {
+    reschedule_at(impl,
+        Time_Traits::add(Time_Traits::now(), expiry_time), ec);
+  }
+
   // Perform a blocking wait on the timer.
   void wait(implementation_type& impl, boost::system::error_code& ec)
   {
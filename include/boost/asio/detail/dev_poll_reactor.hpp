@@ -168,12 +168,23 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data* timer,
       void* cancellation_key);
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+  // Set the slack, in microseconds, by which timer expiries may be deferred
+  // so that timers expiring close together complete in a single batch.
+  BOOST_ASIO_DECL void set_timer_slack(long usec);
+
   // Run /dev/poll once until interrupted or events are ready to be dispatched.
   BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
@@ -19,6 +19,7 @@
 
 #if defined(BOOST_ASIO_HAS_EPOLL)
 
+#include <vector>
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/conditionally_enabled_mutex.hpp>
 #include <boost/asio/detail/limits.hpp>
@@ -33,12 +34,30 @@
 #include <boost/asio/detail/wait_op.hpp>
 #include <boost/asio/execution_context.hpp>
 
+#include <sys/epoll.h>
 #if defined(BOOST_ASIO_HAS_TIMERFD)
 # include <sys/timerfd.h>
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 
 #include <boost/asio/detail/push_options.hpp>
 
+// The number of events initially retrieved by each call to epoll_wait.
+#if !defined(BOOST_ASIO_EPOLL_REACTOR_EVENTS)
+# define BOOST_ASIO_EPOLL_REACTOR_EVENTS 128
+#endif // !defined(BOOST_ASIO_EPOLL_REACTOR_EVENTS)
+
+// The number of events to which the batch may grow when epoll_wait keeps
+// returning a full batch.
+#if !defined(BOOST_ASIO_EPOLL_REACTOR_MAX_EVENTS)
+# define BOOST_ASIO_EPOLL_REACTOR_MAX_EVENTS 4096
+#endif // !defined(BOOST_ASIO_EPOLL_REACTOR_MAX_EVENTS)
+
+// The maximum number of additional non-blocking calls to epoll_wait made
+// within one run of the reactor when the previous call returned a full batch.
+#if !defined(BOOST_ASIO_EPOLL_REACTOR_MAX_EXTRA_WAITS)
+# define BOOST_ASIO_EPOLL_REACTOR_MAX_EXTRA_WAITS 4
+#endif // !defined(BOOST_ASIO_EPOLL_REACTOR_MAX_EXTRA_WAITS)
+
 namespace boost {
 namespace asio {
 namespace detail {
@@ -200,18 +219,54 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data* timer,
       void* cancellation_key);
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+  // Set the slack, in microseconds, by which timer expiries may be deferred
+  // so that timers expiring close together complete in a single batch.
+  BOOST_ASIO_DECL void set_timer_slack(long usec);
+
   // Run epoll once until interrupted or events are ready to be dispatched.
   BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
 
   // Interrupt the select loop.
   BOOST_ASIO_DECL void interrupt();
 
+  // Set the number of events initially retrieved by each call to epoll_wait,
+  // and the number to which it may grow. May be called while the reactor is
+  // running, in which case the change takes effect on its next run.
+  BOOST_ASIO_DECL void set_event_batch_size(
+      std::size_t initial_events, std::size_t max_events);
+
+  // Statistics describing the calls made to epoll_wait.
+  struct wait_statistics
+  {
+    // The number of calls made to epoll_wait.
+    std::size_t waits;
+
+    // The total number of events returned by those calls.
+    std::size_t events;
+
+    // The number of calls that returned a full batch of events.
+    std::size_t full_batches;
+
+    // The current batch size.
+    std::size_t batch_size;
+  };
+
+  // Get the statistics describing the calls made to epoll_wait.
+  BOOST_ASIO_DECL wait_statistics get_wait_statistics() const;
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
@@ -276,6 +331,25 @@ private:
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
 
+  // The buffer of events filled by epoll_wait. Only accessed by the thread
+  // that is running the reactor.
+  std::vector<epoll_event> events_;
+
+  // The configured initial and maximum sizes of the event buffer.
+  atomic_count initial_events_;
+  atomic_count max_events_;
+
+  // Whether the event buffer size has been reconfigured.
+  atomic_count events_resized_;
+
+  // The current size of the event buffer.
+  atomic_count batch_size_;
+
+  // Counters for the calls made to epoll_wait.
+  atomic_count waits_;
+  atomic_count waited_events_;
+  atomic_count full_batches_;
+
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
@@ -253,6 +253,33 @@ struct handler_type_requirements
             boost::asio::detail::rvref<socket_type>()), \
         char(0))> BOOST_ASIO_UNUSED_TYPEDEF
 
+#define BOOST_ASIO_STREAM_RECEIVE_HANDLER_CHECK( \
+    handler_type, handler) \
+  \
+  typedef BOOST_ASIO_HANDLER_TYPE(handler_type, \
+      void(boost::system::error_code, boost::asio::buffer_lease)) \
+    asio_true_handler_type; \
+  \
+  BOOST_ASIO_HANDLER_TYPE_REQUIREMENTS_ASSERT( \
+      sizeof(boost::asio::detail::two_arg_move_handler_test( \
+          boost::asio::detail::rvref< \
+            asio_true_handler_type>(), \
+          static_cast<const boost::system::error_code*>(0), \
+          static_cast<boost::asio::buffer_lease*>(0))) == 1, \
+      "StreamReceiveHandler type requirements not met") \
+  \
+  typedef boost::asio::detail::handler_type_requirements< \
+      sizeof( \
+        boost::asio::detail::argbyv( \
+          boost::asio::detail::rvref< \
+            asio_true_handler_type>())) + \
+      sizeof( \
+        boost::asio::detail::rorlvref< \
+          asio_true_handler_type>()( \
+            boost::asio::detail::lvref<const boost::system::error_code>(), \
+            boost::asio::detail::rvref<boost::asio::buffer_lease>()), \
+        char(0))> BOOST_ASIO_UNUSED_TYPEDEF
+
 #define BOOST_ASIO_CONNECT_HANDLER_CHECK( \
     handler_type, handler) \
   \
@@ -510,6 +537,10 @@ struct handler_type_requirements
     handler_type, handler, socket_type) \
   typedef int BOOST_ASIO_UNUSED_TYPEDEF
 
+#define BOOST_ASIO_STREAM_RECEIVE_HANDLER_CHECK( \
+    handler_type, handler) \
+  typedef int BOOST_ASIO_UNUSED_TYPEDEF
+
 #define BOOST_ASIO_CONNECT_HANDLER_CHECK( \
     handler_type, handler) \
   typedef int BOOST_ASIO_UNUSED_TYPEDEF
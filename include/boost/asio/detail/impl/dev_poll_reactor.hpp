@@ -89,6 +89,16 @@ void dev_poll_reactor::cancel_timer_by_key(timer_queue<Time_Traits>& queue,
   scheduler_.post_deferred_completions(ops);
 }
 
+template <typename Time_Traits>
+void dev_poll_reactor::reschedule_timer(timer_queue<Time_Traits>& queue,
+    const typename Time_Traits::time_type& time,
+    typename timer_queue<Time_Traits>::per_timer_data& timer)
+{
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+  if (queue.reschedule_timer(time, timer))
+    interrupter_.interrupt();
+}
+
 template <typename Time_Traits>
 void dev_poll_reactor::move_timer(timer_queue<Time_Traits>& queue,
     typename timer_queue<Time_Traits>::per_timer_data& target,
@@ -418,6 +418,12 @@ void dev_poll_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void dev_poll_reactor::set_timer_slack(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.set_slack(usec);
+}
+
 int dev_poll_reactor::get_timeout(int msec)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
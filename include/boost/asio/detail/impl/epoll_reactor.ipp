@@ -19,6 +19,7 @@
 
 #if defined(BOOST_ASIO_HAS_EPOLL)
 
+#include <algorithm>
 #include <cstddef>
 #include <sys/epoll.h>
 #include <boost/asio/detail/epoll_reactor.hpp>
@@ -45,7 +46,15 @@ epoll_reactor::epoll_reactor(boost::asio::execution_context& ctx)
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    events_(BOOST_ASIO_EPOLL_REACTOR_EVENTS),
+    initial_events_(BOOST_ASIO_EPOLL_REACTOR_EVENTS),
+    max_events_(BOOST_ASIO_EPOLL_REACTOR_MAX_EVENTS),
+    events_resized_(0),
+    batch_size_(BOOST_ASIO_EPOLL_REACTOR_EVENTS),
+    waits_(0),
+    waited_events_(0),
+    full_batches_(0)
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -505,39 +514,14 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     }
   }
 
-  // Block on the epoll descriptor.
-  epoll_event events[128];
-  int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
-
-#if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
-  // Trace the waiting events.
-  for (int i = 0; i < num_events; ++i)
+  // Apply any change to the configured size of the event buffer.
+  if (events_resized_ != 0)
   {
-    void* ptr = events[i].data.ptr;
-    if (ptr == &interrupter_)
-    {
-      // Ignore.
-    }
-# if defined(BOOST_ASIO_HAS_TIMERFD)
-    else if (ptr == &timer_fd_)
-    {
-      // Ignore.
-    }
-# endif // defined(BOOST_ASIO_HAS_TIMERFD)
-    else
-    {
-      unsigned event_mask = 0;
-      if ((events[i].events & EPOLLIN) != 0)
-        event_mask |= BOOST_ASIO_HANDLER_REACTOR_READ_EVENT;
-      if ((events[i].events & EPOLLOUT))
-        event_mask |= BOOST_ASIO_HANDLER_REACTOR_WRITE_EVENT;
-      if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
-        event_mask |= BOOST_ASIO_HANDLER_REACTOR_ERROR_EVENT;
-      BOOST_ASIO_HANDLER_REACTOR_EVENTS((context(),
-            reinterpret_cast<uintmax_t>(ptr), event_mask));
-    }
+    events_resized_ = 0;
+    events_.resize(static_cast<std::size_t>(
+          static_cast<long>(initial_events_)));
+    batch_size_ = static_cast<long>(events_.size());
   }
-#endif // defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
   bool check_timers = (timer_fd_ == -1);
@@ -545,46 +529,109 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   bool check_timers = true;
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 
-  // Dispatch the waiting events.
-  for (int i = 0; i < num_events; ++i)
+  for (int extra_waits = 0;; ++extra_waits)
   {
-    void* ptr = events[i].data.ptr;
-    if (ptr == &interrupter_)
+    // Block on the epoll descriptor.
+    epoll_event* events = &events_[0];
+    int max_events = static_cast<int>(events_.size());
+    int num_events = epoll_wait(epoll_fd_, events, max_events, timeout);
+
+    ++waits_;
+    if (num_events > 0)
+      boost::asio::detail::increment(waited_events_, num_events);
+
+#if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
+    // Trace the waiting events.
+    for (int i = 0; i < num_events; ++i)
+    {
+      void* ptr = events[i].data.ptr;
+      if (ptr == &interrupter_)
+      {
+        // Ignore.
+      }
+# if defined(BOOST_ASIO_HAS_TIMERFD)
+      else if (ptr == &timer_fd_)
+      {
+        // Ignore.
+      }
+# endif // defined(BOOST_ASIO_HAS_TIMERFD)
+      else
+      {
+        unsigned event_mask = 0;
+        if ((events[i].events & EPOLLIN) != 0)
+          event_mask |= BOOST_ASIO_HANDLER_REACTOR_READ_EVENT;
+        if ((events[i].events & EPOLLOUT))
+          event_mask |= BOOST_ASIO_HANDLER_REACTOR_WRITE_EVENT;
+        if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+          event_mask |= BOOST_ASIO_HANDLER_REACTOR_ERROR_EVENT;
+        BOOST_ASIO_HANDLER_REACTOR_EVENTS((context(),
+              reinterpret_cast<uintmax_t>(ptr), event_mask));
+      }
+    }
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
+
+    // Dispatch the waiting events.
+    for (int i = 0; i < num_events; ++i)
     {
-      // No need to reset the interrupter since we're leaving the descriptor
-      // in a ready-to-read state and relying on edge-triggered notifications
-      // to make it so that we only get woken up when the descriptor's epoll
-      // registration is updated.
+      void* ptr = events[i].data.ptr;
+      if (ptr == &interrupter_)
+      {
+        // No need to reset the interrupter since we're leaving the descriptor
+        // in a ready-to-read state and relying on edge-triggered
+        // notifications to make it so that we only get woken up when the
+        // descriptor's epoll registration is updated.
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
-      if (timer_fd_ == -1)
-        check_timers = true;
+        if (timer_fd_ == -1)
+          check_timers = true;
 #else // defined(BOOST_ASIO_HAS_TIMERFD)
-      check_timers = true;
+        check_timers = true;
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
-    }
+      }
 #if defined(BOOST_ASIO_HAS_TIMERFD)
-    else if (ptr == &timer_fd_)
-    {
-      check_timers = true;
-    }
-#endif // defined(BOOST_ASIO_HAS_TIMERFD)
-    else
-    {
-      // The descriptor operation doesn't count as work in and of itself, so we
-      // don't call work_started() here. This still allows the scheduler to
-      // stop if the only remaining operations are descriptor operations.
-      descriptor_state* descriptor_data = static_cast<descriptor_state*>(ptr);
-      if (!ops.is_enqueued(descriptor_data))
+      else if (ptr == &timer_fd_)
       {
-        descriptor_data->set_ready_events(events[i].events);
-        ops.push(descriptor_data);
+        check_timers = true;
       }
+#endif // defined(BOOST_ASIO_HAS_TIMERFD)
       else
       {
-        descriptor_data->add_ready_events(events[i].events);
+        // The descriptor operation doesn't count as work in and of itself, so
+        // we don't call work_started() here. This still allows the scheduler
+        // to stop if the only remaining operations are descriptor operations.
+        descriptor_state* descriptor_data
+          = static_cast<descriptor_state*>(ptr);
+        if (!ops.is_enqueued(descriptor_data))
+        {
+          descriptor_data->set_ready_events(events[i].events);
+          ops.push(descriptor_data);
+        }
+        else
+        {
+          descriptor_data->add_ready_events(events[i].events);
+        }
       }
     }
+
+    // A partial batch means that all ready events have been collected.
+    if (num_events < max_events)
+      break;
+
+    // Otherwise more events are probably ready. Grow the buffer so that
+    // subsequent calls are more likely to collect everything in one go, and
+    // poll again without blocking rather than returning to the scheduler.
+    ++full_batches_;
+    std::size_t limit = static_cast<std::size_t>(
+        static_cast<long>(max_events_));
+    if (events_.size() < limit)
+    {
+      events_.resize((std::min)(events_.size() * 2, limit));
+      batch_size_ = static_cast<long>(events_.size());
+    }
+
+    if (extra_waits >= BOOST_ASIO_EPOLL_REACTOR_MAX_EXTRA_WAITS)
+      break;
+    timeout = 0;
   }
 
   if (check_timers)
@@ -593,7 +640,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     timer_queues_.get_ready_timers(ops);
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
-    if (timer_fd_ != -1)
+    if (timer_fd_ != -1 && !timer_queues_.wakeup_within_slack())
     {
       itimerspec new_timeout;
       itimerspec old_timeout;
@@ -604,6 +651,30 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   }
 }
 
+void epoll_reactor::set_event_batch_size(
+    std::size_t initial_events, std::size_t max_events)
+{
+  if (initial_events == 0)
+    initial_events = 1;
+  if (max_events < initial_events)
+    max_events = initial_events;
+  initial_events_ = static_cast<long>(initial_events);
+  max_events_ = static_cast<long>(max_events);
+  events_resized_ = 1;
+}
+
+epoll_reactor::wait_statistics epoll_reactor::get_wait_statistics() const
+{
+  wait_statistics stats;
+  stats.waits = static_cast<std::size_t>(static_cast<long>(waits_));
+  stats.events = static_cast<std::size_t>(static_cast<long>(waited_events_));
+  stats.full_batches = static_cast<std::size_t>(
+      static_cast<long>(full_batches_));
+  stats.batch_size = static_cast<std::size_t>(
+      static_cast<long>(batch_size_));
+  return stats;
+}
+
 void epoll_reactor::interrupt()
 {
   epoll_event ev = { 0, { 0 } };
@@ -686,11 +757,22 @@ void epoll_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void epoll_reactor::set_timer_slack(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.set_slack(usec);
+}
+
 void epoll_reactor::update_timeout()
 {
 #if defined(BOOST_ASIO_HAS_TIMERFD)
   if (timer_fd_ != -1)
   {
+    // With timer slack, the timerfd is left alone while it is due to fire
+    // within the slack of the earliest timer.
+    if (timer_queues_.wakeup_within_slack())
+      return;
+
     itimerspec new_timeout;
     itimerspec old_timeout;
     int flags = get_timeout(new_timeout);
@@ -716,7 +798,7 @@ int epoll_reactor::get_timeout(itimerspec& ts)
   ts.it_interval.tv_sec = 0;
   ts.it_interval.tv_nsec = 0;
 
-  long usec = timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
+  long usec = timer_queues_.wakeup_duration_usec(5 * 60 * 1000 * 1000);
   ts.it_value.tv_sec = usec / 1000000;
   ts.it_value.tv_nsec = usec ? (usec % 1000000) * 1000 : 1;
 
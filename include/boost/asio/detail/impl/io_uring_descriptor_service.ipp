@@ -106,7 +106,8 @@ boost::system::error_code io_uring_descriptor_service::assign(
     return ec;
   }
 
-  io_uring_service_.register_io_object(impl.io_object_data_);
+  io_uring_service_.register_io_object(
+      impl.io_object_data_, native_descriptor);
 
   impl.descriptor_ = native_descriptor;
   impl.state_ = descriptor_ops::possible_dup;
@@ -58,7 +58,7 @@ void io_uring_service::schedule_timer(timer_queue<Time_Traits>& queue,
 
   bool earliest = queue.enqueue_timer(time, timer, op);
   scheduler_.work_started();
-  if (earliest)
+  if (earliest && !timer_queues_.wakeup_within_slack())
   {
     update_timeout();
     post_submit_sqes_op(lock);
@@ -90,6 +90,20 @@ void io_uring_service::cancel_timer_by_key(timer_queue<Time_Traits>& queue,
   scheduler_.post_deferred_completions(ops);
 }
 
+template <typename Time_Traits>
+void io_uring_service::reschedule_timer(timer_queue<Time_Traits>& queue,
+    const typename Time_Traits::time_type& time,
+    typename timer_queue<Time_Traits>::per_timer_data& timer)
+{
+  mutex::scoped_lock lock(mutex_);
+  bool earliest = queue.reschedule_timer(time, timer);
+  if (earliest && !timer_queues_.wakeup_within_slack())
+  {
+    update_timeout();
+    post_submit_sqes_op(lock);
+  }
+}
+
 template <typename Time_Traits>
 void io_uring_service::move_timer(timer_queue<Time_Traits>& queue,
     typename timer_queue<Time_Traits>::per_timer_data& target,
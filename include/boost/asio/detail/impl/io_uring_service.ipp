@@ -19,8 +19,13 @@
 
 #if defined(BOOST_ASIO_HAS_IO_URING)
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include <sys/eventfd.h>
+#include <time.h>
 #include <boost/asio/detail/io_uring_service.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/scheduler.hpp>
@@ -42,14 +47,25 @@ io_uring_service::io_uring_service(boost::asio::execution_context& ctx)
     submit_sqes_op_(this),
     pending_sqes_(0),
     pending_submit_sqes_op_(false),
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+    msg_ring_supported_(true),
+    msg_ring_operations_(0),
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
     shutdown_(false),
     timeout_(),
     registration_mutex_(mutex_.enabled()),
     reactor_(use_service<reactor>(ctx)),
     reactor_data_(),
-    event_fd_(-1)
+    event_fd_(-1),
+    registered_files_state_(registered_files_none)
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+    , buffer_ring_(0),
+    buffer_memory_(0),
+    buffer_generation_(0)
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
 {
   reactor_.init_task();
+  init_options(use_service<io_uring_options>(ctx));
   init_ring();
   register_with_reactor();
 }
@@ -60,6 +76,10 @@ io_uring_service::~io_uring_service()
     ::io_uring_queue_exit(&ring_);
   if (event_fd_ != -1)
     ::close(event_fd_);
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+  ::free(buffer_ring_);
+  delete[] buffer_memory_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
 }
 
 void io_uring_service::shutdown()
@@ -82,6 +102,14 @@ void io_uring_service::shutdown()
           ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
       }
     }
+    while (io_uring_operation* op = io_obj->multishot_ops_.front())
+    {
+      io_obj->multishot_ops_.pop();
+      ops.push(op);
+      if (::io_uring_sqe* sqe = get_sqe())
+        ::io_uring_prep_cancel(sqe, multishot_data(
+              static_cast<io_uring_multishot_operation*>(op)), 0);
+    }
     io_obj->shutdown_ = true;
     registered_io_objects_.free(io_obj);
   }
@@ -99,6 +127,31 @@ void io_uring_service::shutdown()
       break;
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  // Operations sent to this ring from other rings are destroyed along with
+  // this service's own, and the operations of failed messages sent from this
+  // ring are returned to their targets.
+  ::io_uring_cqe* cqe = 0;
+  while (::io_uring_peek_cqe(&ring_, &cqe) == 0)
+  {
+    void* ptr = ::io_uring_cqe_get_data(cqe);
+    if (msg_ring_message* msg = msg_ring_msg(ptr))
+      complete_send_operation(msg, cqe->res);
+    else if (operation* op = msg_ring_op(ptr))
+      ops.push(op);
+    ::io_uring_cqe_seen(&ring_, cqe);
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
+  // Release the registered files so that closing a descriptor is not delayed
+  // until the ring is destroyed.
+  if (registered_files_state_ == registered_files_active)
+  {
+    ::io_uring_unregister_files(&ring_);
+    registered_files_state_ = registered_files_unavailable;
+    free_registered_files_.clear();
+  }
+
   timer_queues_.get_all_timers(ops);
 
   scheduler_.abandon_operations(ops);
@@ -128,6 +181,22 @@ void io_uring_service::notify_fork(
               ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
           }
         }
+        op_queue<io_uring_operation> multishot_ops;
+        while (io_uring_operation* op = io_obj->multishot_ops_.front())
+        {
+          io_obj->multishot_ops_.pop();
+          multishot_ops.push(op);
+          io_uring_multishot_operation* m_op =
+            static_cast<io_uring_multishot_operation*>(op);
+          if (!m_op->cancel_requested_)
+          {
+            m_op->cancel_requested_ = true;
+            mutex::scoped_lock lock(mutex_);
+            if (::io_uring_sqe* sqe = get_sqe())
+              ::io_uring_prep_cancel(sqe, multishot_data(m_op), 0);
+          }
+        }
+        io_obj->multishot_ops_.push(multishot_ops);
       }
 
       // Cancel the timeout operation.
@@ -141,7 +210,8 @@ void io_uring_service::notify_fork(
       // Wait for all completions to come back, and post all completed I/O
       // queues to the scheduler. Note that some operations may have already
       // completed, or were explicitly cancelled. All others will be
-      // automatically restarted.
+      // automatically restarted. Multishot operations are not restarted, and
+      // instead complete with the operation_aborted error.
       op_queue<operation> ops;
       for (; outstanding_work_ > 0; --outstanding_work_)
       {
@@ -150,13 +220,30 @@ void io_uring_service::notify_fork(
           break;
         if (void* ptr = ::io_uring_cqe_get_data(cqe))
         {
-          if (ptr != this && ptr != &timer_queues_ && ptr != &timeout_)
+          if (io_uring_multishot_operation* m_op = multishot_op(ptr))
+          {
+            complete_multishot_op(m_op, cqe->res, cqe->flags, ops);
+            if ((cqe->flags & IORING_CQE_F_MORE) != 0)
+              ++outstanding_work_;
+          }
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+          else if (msg_ring_message* msg = msg_ring_msg(ptr))
+          {
+            complete_send_operation(msg, cqe->res);
+          }
+          else if (operation* op = msg_ring_op(ptr))
+          {
+            ops.push(op);
+          }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+          else if (ptr != this && ptr != &timer_queues_ && ptr != &timeout_)
           {
             io_queue* io_q = static_cast<io_queue*>(ptr);
             io_q->set_result(cqe->res);
             ops.push(io_q);
           }
         }
+        ::io_uring_cqe_seen(&ring_, cqe);
       }
       scheduler_.post_deferred_completions(ops);
 
@@ -177,6 +264,43 @@ void io_uring_service::notify_fork(
       ::io_uring_queue_exit(&ring_);
       init_ring();
       register_with_reactor();
+
+      // Place the descriptors of all registered I/O objects into the new
+      // ring's registered file table.
+      if (registered_files_state_ == registered_files_active)
+      {
+        int result = ::io_uring_register_files_sparse(
+            &ring_, BOOST_ASIO_IO_URING_REGISTERED_FILES);
+        for (io_object* io_obj = registered_io_objects_.first();
+            io_obj != 0; io_obj = io_obj->next_)
+        {
+          if (io_obj->registered_file_ >= 0)
+          {
+            if (result < 0 || ::io_uring_register_files_update(&ring_,
+                  io_obj->registered_file_, &io_obj->descriptor_, 1) < 1)
+            {
+              free_registered_files_.push_back(io_obj->registered_file_);
+              io_obj->registered_file_ = -1;
+            }
+          }
+        }
+        if (result < 0)
+        {
+          registered_files_state_ = registered_files_unavailable;
+          free_registered_files_.clear();
+        }
+      }
+
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+      // Give all of the provided buffers to the new ring.
+      if (buffer_ring_)
+      {
+        ++buffer_generation_;
+        boost::system::error_code ec;
+        init_buffer_ring(ec);
+        boost::asio::detail::throw_error(ec, "io_uring_register_buf_ring");
+      }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
     }
     break;
   default:
@@ -190,7 +314,7 @@ void io_uring_service::init_task()
 }
 
 void io_uring_service::register_io_object(
-    io_uring_service::per_io_object_data& io_obj)
+    io_uring_service::per_io_object_data& io_obj, int descriptor)
 {
   io_obj = allocate_io_object();
 
@@ -198,11 +322,16 @@ void io_uring_service::register_io_object(
 
   io_obj->service_ = this;
   io_obj->shutdown_ = false;
+  io_obj->descriptor_ = descriptor;
+  io_obj->registered_file_ = -1;
   for (int i = 0; i < max_ops; ++i)
   {
     io_obj->queues_[i].io_object_ = io_obj;
     io_obj->queues_[i].cancel_requested_ = false;
   }
+
+  if (descriptor >= 0)
+    io_obj->registered_file_ = allocate_registered_file(descriptor);
 }
 
 void io_uring_service::register_internal_io_object(
@@ -215,6 +344,8 @@ void io_uring_service::register_internal_io_object(
 
   io_obj->service_ = this;
   io_obj->shutdown_ = false;
+  io_obj->descriptor_ = -1;
+  io_obj->registered_file_ = -1;
   for (int i = 0; i < max_ops; ++i)
   {
     io_obj->queues_[i].io_object_ = io_obj;
@@ -286,9 +417,9 @@ void io_uring_service::start_op(int op_type,
       io_obj->queues_[op_type].op_queue_.push(op);
       io_object_lock.unlock();
       mutex::scoped_lock lock(mutex_);
-      if (::io_uring_sqe* sqe = get_sqe())
+      if (::io_uring_sqe* sqe = get_sqe(op->link_timeout_ ? 2 : 1))
       {
-        op->prepare(sqe);
+        prepare_op(io_obj, op, sqe);
         ::io_uring_sqe_set_data(sqe, &io_obj->queues_[op_type]);
         scheduler_.work_started();
         post_submit_sqes_op(lock);
@@ -308,6 +439,47 @@ void io_uring_service::start_op(int op_type,
   }
 }
 
+void io_uring_service::start_multishot_op(
+    io_uring_service::per_io_object_data& io_obj,
+    io_uring_multishot_operation* op, bool is_continuation)
+{
+  if (!io_obj)
+  {
+    op->ec_ = boost::asio::error::bad_descriptor;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+
+  if (io_obj->shutdown_)
+  {
+    io_object_lock.unlock();
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  op->io_object_ = io_obj;
+  op->cancel_requested_ = false;
+
+  mutex::scoped_lock lock(mutex_);
+  if (::io_uring_sqe* sqe = get_sqe())
+  {
+    prepare_op(io_obj, op, sqe);
+    ::io_uring_sqe_set_data(sqe, multishot_data(op));
+    io_obj->multishot_ops_.push(op);
+    scheduler_.work_started();
+    post_submit_sqes_op(lock);
+  }
+  else
+  {
+    lock.unlock();
+    io_object_lock.unlock();
+    op->ec_ = boost::asio::error::no_buffer_space;
+    post_immediate_completion(op, is_continuation);
+  }
+}
+
 void io_uring_service::cancel_ops(io_uring_service::per_io_object_data& io_obj)
 {
   if (!io_obj)
@@ -363,6 +535,28 @@ void io_uring_service::cancel_ops_by_key(
   }
   io_obj->queues_[op_type].op_queue_.push(other_ops);
 
+  // A multishot operation remains submitted until the kernel confirms that
+  // it has been cancelled, and it is completed from that final result.
+  op_queue<io_uring_operation> multishot_ops;
+  while (io_uring_operation* op = io_obj->multishot_ops_.front())
+  {
+    io_obj->multishot_ops_.pop();
+    multishot_ops.push(op);
+    io_uring_multishot_operation* m_op =
+      static_cast<io_uring_multishot_operation*>(op);
+    if (op->cancellation_key_ == cancellation_key && !m_op->cancel_requested_)
+    {
+      m_op->cancel_requested_ = true;
+      mutex::scoped_lock lock(mutex_);
+      if (::io_uring_sqe* sqe = get_sqe())
+      {
+        ::io_uring_prep_cancel(sqe, multishot_data(m_op), 0);
+        submit_sqes();
+      }
+    }
+  }
+  io_obj->multishot_ops_.push(multishot_ops);
+
   io_object_lock.unlock();
 
   scheduler_.post_deferred_completions(ops);
@@ -375,6 +569,11 @@ void io_uring_service::deregister_io_object(
     return;
 
   mutex::scoped_lock io_object_lock(io_obj->mutex_);
+  if (io_obj->registered_file_ >= 0)
+  {
+    free_registered_file(io_obj->registered_file_);
+    io_obj->registered_file_ = -1;
+  }
   if (!io_obj->shutdown_)
   {
     op_queue<operation> ops;
@@ -453,6 +652,8 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
 
   bool check_timers = false;
   int count = 0;
+  int more = 0;
+  int received = 0;
   while (result == 0 || local_ops > 0)
   {
     if (result == 0)
@@ -477,6 +678,30 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
         {
           --local_ops;
         }
+        else if (io_uring_multishot_operation* m_op = multishot_op(ptr))
+        {
+          // Only the final completion of a multishot operation accounts for
+          // its submission.
+          complete_multishot_op(m_op, cqe->res, cqe->flags, ops);
+          if ((cqe->flags & IORING_CQE_F_MORE) != 0)
+            ++more;
+        }
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+        else if (msg_ring_message* msg = msg_ring_msg(ptr))
+        {
+          complete_send_operation(msg, cqe->res);
+        }
+        else if (operation* op = msg_ring_op(ptr))
+        {
+          // An operation sent from another service's ring. The sender counted
+          // the message as work here before preparing it, so discounting it
+          // before the operation is used orders the sender's writes to the
+          // operation before this thread's use of it.
+          decrement(outstanding_work_, 1);
+          ++received;
+          ops.push(op);
+        }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
         else
         {
           io_queue* io_q = static_cast<io_queue*>(ptr);
@@ -487,11 +712,11 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
       ::io_uring_cqe_seen(&ring_, cqe);
       ++count;
     }
-    result = (count < complete_batch_size || local_ops > 0)
+    result = (count < complete_batch_size_ || local_ops > 0)
       ? ::io_uring_peek_cqe(&ring_, &cqe) : -EAGAIN;
   }
 
-  decrement(outstanding_work_, count);
+  decrement(outstanding_work_, count - more - received);
 
   if (check_timers)
   {
@@ -521,9 +746,141 @@ void io_uring_service::interrupt()
   submit_sqes();
 }
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+bool io_uring_service::send_operation(
+    io_uring_service* target, operation* op)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (!msg_ring_supported_ || shutdown_)
+    return false;
+
+  msg_ring_message* msg = msg_ring_messages_.alloc();
+  ::io_uring_sqe* sqe = get_sqe();
+  if (!sqe)
+  {
+    msg_ring_messages_.free(msg);
+    return false;
+  }
+  msg->target_ = target;
+  msg->op_ = op;
+
+  // The completion posted to the target ring is counted as work there, so that
+  // the target service is not shut down while the message is in flight.
+  increment(target->outstanding_work_, 1);
+  ::io_uring_prep_msg_ring(sqe, target->ring_.ring_fd, 0,
+      reinterpret_cast<__u64>(msg_ring_op_data(op)), 0);
+  ::io_uring_sqe_set_data(sqe, msg_ring_data(msg));
+
+  post_submit_sqes_op(lock);
+  return true;
+}
+
+void io_uring_service::complete_send_operation(
+    io_uring_service::msg_ring_message* msg, int result)
+{
+  mutex::scoped_lock lock(mutex_);
+  io_uring_service* target = msg->target_;
+  operation* op = msg->op_;
+  msg_ring_messages_.free(msg);
+  if (result < 0)
+  {
+    // Older kernels reject the operation as invalid.
+    if (result == -EINVAL)
+      msg_ring_supported_ = false;
+    lock.unlock();
+
+    // Nothing was posted to the target ring, so the operation goes through the
+    // target scheduler's queue. The work for the operation has already been
+    // counted there, and the queue of operations is used so that the
+    // operation is not sent back to the target's ring.
+    op_queue<operation> ops;
+    ops.push(op);
+    target->scheduler_.post_deferred_completions(ops);
+    decrement(target->outstanding_work_, 1);
+  }
+  else
+  {
+    ++msg_ring_operations_;
+  }
+}
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
+void io_uring_service::init_options(const io_uring_options& options)
+{
+  ring_size_ = static_cast<unsigned>(options.ring_size());
+  ring_params_ = ::io_uring_params();
+
+  if (options.completion_queue_size() != 0)
+  {
+    ring_params_.flags |= IORING_SETUP_CQSIZE;
+    ring_params_.cq_entries =
+      static_cast<__u32>(options.completion_queue_size());
+  }
+
+  submission_queue_polling_ = options.submission_queue_polling();
+  if (submission_queue_polling_)
+  {
+    ring_params_.flags |= IORING_SETUP_SQPOLL;
+    ring_params_.sq_thread_idle = options.submission_queue_polling_idle();
+    if (options.submission_queue_polling_cpu() >= 0)
+    {
+      ring_params_.flags |= IORING_SETUP_SQ_AFF;
+      ring_params_.sq_thread_cpu =
+        static_cast<__u32>(options.submission_queue_polling_cpu());
+    }
+  }
+
+#if defined(IORING_SETUP_COOP_TASKRUN)
+  if (options.cooperative_task_run())
+    ring_params_.flags |= IORING_SETUP_COOP_TASKRUN;
+#endif // defined(IORING_SETUP_COOP_TASKRUN)
+
+#if defined(IORING_SETUP_SINGLE_ISSUER)
+  if (options.single_issuer())
+    ring_params_.flags |= IORING_SETUP_SINGLE_ISSUER;
+#endif // defined(IORING_SETUP_SINGLE_ISSUER)
+
+#if defined(IORING_SETUP_DEFER_TASKRUN) \
+  && defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  if (options.defer_task_run())
+  {
+    ring_params_.flags |=
+      IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+  }
+#endif // defined(IORING_SETUP_DEFER_TASKRUN)
+       //   && defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  std::size_t max_batch_size = (std::numeric_limits<int>::max)();
+  submit_batch_size_ = static_cast<int>((std::min)(max_batch_size,
+        (std::max)(options.submit_batch_size(), std::size_t(1))));
+  complete_batch_size_ = static_cast<int>((std::min)(max_batch_size,
+        (std::max)(options.complete_batch_size(), std::size_t(1))));
+}
+
 void io_uring_service::init_ring()
 {
-  int result = ::io_uring_queue_init(ring_size, &ring_, 0);
+  ::io_uring_params params = ring_params_;
+  int result = ::io_uring_queue_init_params(ring_size_, &ring_, &params);
+
+  // The task run flags are only hints, so drop them if the kernel does not
+  // support them.
+  unsigned hint_flags = 0;
+#if defined(IORING_SETUP_COOP_TASKRUN)
+  hint_flags |= IORING_SETUP_COOP_TASKRUN;
+#endif // defined(IORING_SETUP_COOP_TASKRUN)
+#if defined(IORING_SETUP_SINGLE_ISSUER)
+  hint_flags |= IORING_SETUP_SINGLE_ISSUER;
+#endif // defined(IORING_SETUP_SINGLE_ISSUER)
+#if defined(IORING_SETUP_DEFER_TASKRUN)
+  hint_flags |= IORING_SETUP_DEFER_TASKRUN;
+#endif // defined(IORING_SETUP_DEFER_TASKRUN)
+  if (result == -EINVAL && (ring_params_.flags & hint_flags) != 0)
+  {
+    ring_params_.flags &= ~hint_flags;
+    params = ring_params_;
+    result = ::io_uring_queue_init_params(ring_size_, &ring_, &params);
+  }
+
   if (result < 0)
   {
     ring_.ring_fd = -1;
@@ -645,6 +1002,9 @@ bool io_uring_service::do_cancel_ops(
     }
   }
 
+  if (!io_obj->multishot_ops_.empty())
+    cancel_op = true;
+
   if (cancel_op)
   {
     mutex::scoped_lock lock(mutex_);
@@ -658,12 +1018,252 @@ bool io_uring_service::do_cancel_ops(
           ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
       }
     }
+    op_queue<io_uring_operation> multishot_ops;
+    while (io_uring_operation* op = io_obj->multishot_ops_.front())
+    {
+      io_obj->multishot_ops_.pop();
+      multishot_ops.push(op);
+      io_uring_multishot_operation* m_op =
+        static_cast<io_uring_multishot_operation*>(op);
+      if (!m_op->cancel_requested_)
+      {
+        m_op->cancel_requested_ = true;
+        if (::io_uring_sqe* sqe = get_sqe())
+          ::io_uring_prep_cancel(sqe, multishot_data(m_op), 0);
+      }
+    }
+    io_obj->multishot_ops_.push(multishot_ops);
     submit_sqes();
   }
 
   return cancel_op;
 }
 
+int io_uring_service::allocate_registered_file(int descriptor)
+{
+  if (BOOST_ASIO_IO_URING_REGISTERED_FILES <= 0)
+    return -1;
+
+  mutex::scoped_lock lock(mutex_);
+
+  if (registered_files_state_ == registered_files_none)
+  {
+    // Create the table on first use. Where registered files are not supported
+    // or the table cannot be created, descriptors are used directly.
+    int result = ::io_uring_register_files_sparse(
+        &ring_, BOOST_ASIO_IO_URING_REGISTERED_FILES);
+    if (result < 0)
+    {
+      registered_files_state_ = registered_files_unavailable;
+      return -1;
+    }
+
+    registered_files_state_ = registered_files_active;
+    free_registered_files_.reserve(BOOST_ASIO_IO_URING_REGISTERED_FILES);
+    for (int i = BOOST_ASIO_IO_URING_REGISTERED_FILES - 1; i >= 0; --i)
+      free_registered_files_.push_back(i);
+  }
+
+  // When the table is full, the descriptor is used directly.
+  if (registered_files_state_ != registered_files_active
+      || free_registered_files_.empty())
+    return -1;
+
+  int registered_file = free_registered_files_.back();
+  if (::io_uring_register_files_update(&ring_,
+        registered_file, &descriptor, 1) < 1)
+    return -1;
+
+  free_registered_files_.pop_back();
+  return registered_file;
+}
+
+void io_uring_service::free_registered_file(int registered_file)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  if (registered_files_state_ != registered_files_active)
+    return;
+
+  // Entries that are still waiting to be submitted refer to the slot, which
+  // may be reused as soon as it is freed.
+  submit_sqes();
+
+  int descriptor = -1;
+  ::io_uring_register_files_update(&ring_, registered_file, &descriptor, 1);
+  free_registered_files_.push_back(registered_file);
+}
+
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+int io_uring_service::provided_buffer_group(boost::system::error_code& ec)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (!buffer_ring_)
+  {
+    if (!buffer_memory_)
+    {
+      buffer_memory_ = new (std::nothrow) unsigned char[
+        BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT
+          * std::size_t(BOOST_ASIO_PROVIDED_BUFFER_SIZE)];
+    }
+
+    void* ring_memory = 0;
+    if (!buffer_memory_ || ::posix_memalign(&ring_memory, 4096,
+          BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT
+            * sizeof(::io_uring_buf)) != 0)
+    {
+      ec = boost::asio::error::no_memory;
+      return -1;
+    }
+
+    buffer_ring_ = static_cast< ::io_uring_buf_ring*>(ring_memory);
+    init_buffer_ring(ec);
+    if (ec)
+    {
+      ::free(buffer_ring_);
+      buffer_ring_ = 0;
+      return -1;
+    }
+  }
+
+  ec = boost::system::error_code();
+  return provided_buffer_group_id;
+}
+
+void io_uring_service::init_buffer_ring(boost::system::error_code& ec)
+{
+  std::memset(buffer_ring_, 0,
+      BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT * sizeof(::io_uring_buf));
+
+  ::io_uring_buf_reg reg;
+  std::memset(&reg, 0, sizeof(reg));
+  reg.ring_addr = reinterpret_cast<__u64>(buffer_ring_);
+  reg.ring_entries = BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT;
+  reg.bgid = provided_buffer_group_id;
+  int result = ::io_uring_register_buf_ring(&ring_, &reg, 0);
+  if (result < 0)
+  {
+    ec.assign(-result, boost::asio::error::get_system_category());
+    return;
+  }
+
+  for (int i = 0; i < BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT; ++i)
+  {
+    add_provided_buffer(buffer_memory_
+        + i * std::size_t(BOOST_ASIO_PROVIDED_BUFFER_SIZE),
+        static_cast<unsigned short>(i), i);
+  }
+  ::io_uring_buf_ring_advance(buffer_ring_,
+      BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT);
+  ec = boost::system::error_code();
+}
+
+void io_uring_service::add_provided_buffer(
+    void* data, unsigned short bid, int offset)
+{
+  // The entries are addressed from the start of the ring rather than through
+  // io_uring_buf_ring_add(). When compiled as C++, some kernel headers place
+  // the ring's bufs member after an empty struct, so that its first entry
+  // overlaps the tail.
+  ::io_uring_buf* buf = reinterpret_cast< ::io_uring_buf*>(buffer_ring_)
+    + ((buffer_ring_->tail + offset)
+        & (BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT - 1));
+  buf->addr = reinterpret_cast<__u64>(data);
+  buf->len = BOOST_ASIO_PROVIDED_BUFFER_SIZE;
+  buf->bid = bid;
+}
+
+void io_uring_service::release_provided_buffer(
+    void* owner, unsigned int id, void* data)
+{
+  io_uring_service* s = static_cast<io_uring_service*>(owner);
+  mutex::scoped_lock lock(s->mutex_);
+  if (s->buffer_ring_ && (id >> 16) == s->buffer_generation_)
+  {
+    s->add_provided_buffer(data, static_cast<unsigned short>(id), 0);
+    ::io_uring_buf_ring_advance(s->buffer_ring_, 1);
+  }
+}
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+
+void io_uring_service::complete_multishot_op(
+    io_uring_multishot_operation* op, int result,
+    unsigned flags, op_queue<operation>& ops)
+{
+  if ((flags & IORING_CQE_F_MORE) != 0)
+  {
+    // The operation remains submitted, so deliver this result separately. The
+    // new completion is a user-initiated operation in its own right.
+    if (operation* result_op = op->deliver(result, flags))
+    {
+      scheduler_.work_started();
+      ops.push(result_op);
+    }
+    return;
+  }
+
+  io_object* io_obj = op->io_object_;
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+
+  if (result >= 0)
+  {
+    // The kernel may end a multishot operation after a successful result,
+    // such as when the completion queue overflows. Deliver the result and,
+    // unless the operation has been cancelled or has ended itself, submit it
+    // again.
+    if (operation* result_op = op->deliver(result, flags))
+    {
+      scheduler_.work_started();
+      ops.push(result_op);
+    }
+
+    if (op->ended_)
+    {
+      // The operation has ended itself, with any error set by deliver.
+    }
+    else if (!op->cancel_requested_ && !io_obj->shutdown_)
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (::io_uring_sqe* sqe = get_sqe())
+      {
+        prepare_op(io_obj, op, sqe);
+        ::io_uring_sqe_set_data(sqe, multishot_data(op));
+        push_submit_sqes_op(ops);
+        return;
+      }
+      result = -ENOBUFS;
+    }
+    else
+    {
+      result = -ECANCELED;
+    }
+  }
+
+  // Remove the operation from the I/O object and complete it.
+  op_queue<io_uring_operation> other_ops;
+  while (io_uring_operation* o = io_obj->multishot_ops_.front())
+  {
+    io_obj->multishot_ops_.pop();
+    if (o != op)
+      other_ops.push(o);
+  }
+  io_obj->multishot_ops_.push(other_ops);
+
+  if (result < 0)
+    op->ec_.assign(-result, boost::asio::error::get_system_category());
+  ops.push(op);
+
+  // The last operation to complete on a shut down object must free it.
+  if (io_obj->shutdown_ && io_obj->multishot_ops_.empty())
+  {
+    for (int i = 0; i < max_ops; ++i)
+      if (!io_obj->queues_[i].op_queue_.empty())
+        return;
+    io_object_lock.unlock();
+    free_io_object(io_obj);
+  }
+}
+
 void io_uring_service::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -676,6 +1276,12 @@ void io_uring_service::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void io_uring_service::set_timer_slack(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.set_slack(usec);
+}
+
 void io_uring_service::update_timeout()
 {
   if (::io_uring_sqe* sqe = get_sqe())
@@ -685,17 +1291,20 @@ void io_uring_service::update_timeout()
   }
 }
 
-__kernel_timespec io_uring_service::get_timeout() const
+__kernel_timespec io_uring_service::get_timeout()
 {
   __kernel_timespec ts;
-  long usec = timer_queues_.wait_duration_usec(5 * 60 * 1000 * 1000);
+  long usec = timer_queues_.wakeup_duration_usec(5 * 60 * 1000 * 1000);
   ts.tv_sec = usec / 1000000;
   ts.tv_nsec = usec ? (usec % 1000000) * 1000 : 1;
   return ts;
 }
 
-::io_uring_sqe* io_uring_service::get_sqe()
+::io_uring_sqe* io_uring_service::get_sqe(unsigned count)
 {
+  if (count > 1 && ::io_uring_sq_space_left(&ring_) < count)
+    submit_sqes();
+
   ::io_uring_sqe* sqe = ::io_uring_get_sqe(&ring_);
   if (!sqe)
   {
@@ -710,6 +1319,19 @@ __kernel_timespec io_uring_service::get_timeout() const
   return sqe;
 }
 
+void io_uring_service::prepare_link_timeout(
+    io_uring_operation* op, ::io_uring_sqe* sqe)
+{
+  if (::io_uring_sqe* timeout_sqe = ::io_uring_get_sqe(&ring_))
+  {
+    sqe->flags |= IOSQE_IO_LINK;
+    ::io_uring_prep_link_timeout(timeout_sqe,
+        op->link_timeout_, IORING_TIMEOUT_ABS);
+    ::io_uring_sqe_set_data(timeout_sqe, 0);
+    ++pending_sqes_;
+  }
+}
+
 void io_uring_service::submit_sqes()
 {
   if (pending_sqes_ != 0)
@@ -725,7 +1347,7 @@ void io_uring_service::submit_sqes()
 
 void io_uring_service::post_submit_sqes_op(mutex::scoped_lock& lock)
 {
-  if (pending_sqes_ >= submit_batch_size)
+  if (submission_queue_polling_ || pending_sqes_ >= submit_batch_size_)
   {
     submit_sqes();
   }
@@ -739,7 +1361,11 @@ void io_uring_service::post_submit_sqes_op(mutex::scoped_lock& lock)
 
 void io_uring_service::push_submit_sqes_op(op_queue<operation>& ops)
 {
-  if (pending_sqes_ != 0 && !pending_submit_sqes_op_)
+  if (submission_queue_polling_)
+  {
+    submit_sqes();
+  }
+  else if (pending_sqes_ != 0 && !pending_submit_sqes_op_)
   {
     pending_submit_sqes_op_ = true;
     ops.push(&submit_sqes_op_);
@@ -818,6 +1444,22 @@ operation* io_uring_service::io_queue::perform_io(int result)
   perform_io_cleanup_on_block_exit io_cleanup(io_object_->service_);
   mutex::scoped_lock io_object_lock(io_object_->mutex_);
 
+  // An operation is cancelled by the kernel when its linked timeout expires.
+  // Otherwise, an unrequested cancellation restarts the operation.
+  if (result == -ECANCELED && !cancel_requested_)
+  {
+    io_uring_operation* op = op_queue_.front();
+    if (op && op->link_timeout_)
+    {
+      timespec now;
+      ::clock_gettime(CLOCK_MONOTONIC, &now);
+      if (now.tv_sec > op->link_timeout_->tv_sec
+          || (now.tv_sec == op->link_timeout_->tv_sec
+            && now.tv_nsec >= op->link_timeout_->tv_nsec))
+        result = -ETIMEDOUT;
+    }
+  }
+
   if (result != -ECANCELED || cancel_requested_)
   {
     if (io_uring_operation* op = op_queue_.front())
@@ -852,9 +1494,10 @@ operation* io_uring_service::io_queue::perform_io(int result)
   {
     io_uring_service* service = io_object_->service_;
     mutex::scoped_lock lock(service->mutex_);
-    if (::io_uring_sqe* sqe = service->get_sqe())
+    io_uring_operation* op = op_queue_.front();
+    if (::io_uring_sqe* sqe = service->get_sqe(op->link_timeout_ ? 2 : 1))
     {
-      op_queue_.front()->prepare(sqe);
+      service->prepare_op(io_object_, op, sqe);
       ::io_uring_sqe_set_data(sqe, this);
       service->post_submit_sqes_op(lock);
     }
@@ -877,6 +1520,8 @@ operation* io_uring_service::io_queue::perform_io(int result)
     for (int i = 0; i < max_ops; ++i)
       if (!io_object_->queues_[i].op_queue_.empty())
         io_cleanup.io_object_to_free_ = 0;
+    if (!io_object_->multishot_ops_.empty())
+      io_cleanup.io_object_to_free_ = 0;
   }
 
   // The first operation will be returned for completion now. The others will
@@ -585,6 +585,12 @@ void kqueue_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void kqueue_reactor::set_timer_slack(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.set_slack(usec);
+}
+
 timespec* kqueue_reactor::get_timeout(long usec, timespec& ts)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
@@ -66,12 +66,18 @@ struct scheduler::task_cleanup
     }
     this_thread_->private_outstanding_work = 0;
 
+    // Having run the task, the thread starts a fresh run budget.
+    this_thread_->budget_handlers = 0;
+
     // Enqueue the completed operations and reinsert the task at the end of
-    // the operation queue.
+    // the operation queue. A task that ran out of turn may still have its
+    // entry in the queue, in which case the entry keeps its place.
     lock_->lock();
     scheduler_->task_interrupted_ = true;
+    scheduler_->task_out_of_turn_ = false;
     scheduler_->op_queue_.push(this_thread_->private_op_queue);
-    scheduler_->op_queue_.push(&scheduler_->task_operation_);
+    if (!scheduler_->op_queue_.is_enqueued(&scheduler_->task_operation_))
+      scheduler_->op_queue_.push(&scheduler_->task_operation_);
   }
 
   scheduler* scheduler_;
@@ -120,12 +126,20 @@ scheduler::scheduler(boost::asio::execution_context& ctx,
     mutex_(BOOST_ASIO_CONCURRENCY_HINT_IS_LOCKING(
           SCHEDULER, concurrency_hint)),
     task_(0),
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+    published_task_(0),
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
     get_task_(get_task),
     task_interrupted_(true),
+    task_out_of_turn_(false),
     outstanding_work_(0),
     stopped_(false),
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
+    run_budget_handlers_(BOOST_ASIO_SCHEDULER_RUN_BUDGET_HANDLERS),
+    run_budget_usec_(BOOST_ASIO_SCHEDULER_RUN_BUDGET_USEC),
+    run_budget_handler_triggers_(0),
+    run_budget_time_triggers_(0),
     thread_(0)
 {
   BOOST_ASIO_HANDLER_TRACKING_INIT;
@@ -178,6 +192,9 @@ void scheduler::shutdown()
 
   // Reset to initial state.
   task_ = 0;
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  published_task_.store(0, std::memory_order_release);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
 }
 
 void scheduler::init_task()
@@ -186,6 +203,9 @@ void scheduler::init_task()
   if (!shutdown_ && !task_)
   {
     task_ = get_task_(this->context());
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+    published_task_.store(task_, std::memory_order_release);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
     op_queue_.push(&task_operation_);
     wake_one_thread_and_unlock(lock);
   }
@@ -202,6 +222,8 @@ std::size_t scheduler::run(boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.budget_handlers = 0;
+  this_thread.task = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -224,6 +246,8 @@ std::size_t scheduler::run_one(boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.budget_handlers = 0;
+  this_thread.task = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -242,6 +266,8 @@ std::size_t scheduler::wait_one(long usec, boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.budget_handlers = 0;
+  this_thread.task = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -260,6 +286,8 @@ std::size_t scheduler::poll(boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.budget_handlers = 0;
+  this_thread.task = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -291,6 +319,8 @@ std::size_t scheduler::poll_one(boost::system::error_code& ec)
 
   thread_info this_thread;
   this_thread.private_outstanding_work = 0;
+  this_thread.budget_handlers = 0;
+  this_thread.task = 0;
   thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
@@ -325,6 +355,13 @@ void scheduler::restart()
   stopped_ = false;
 }
 
+void scheduler::set_run_budget(std::size_t max_handlers, long max_usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  run_budget_handlers_ = max_handlers;
+  run_budget_usec_ = max_usec;
+}
+
 void scheduler::compensating_work_started()
 {
   thread_info_base* this_thread = thread_call_stack::contains(this);
@@ -361,6 +398,11 @@ void scheduler::post_immediate_completion(
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
   work_started();
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  if (post_to_task(op))
+    return;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -403,6 +445,11 @@ void scheduler::post_deferred_completion(scheduler::operation* op)
   }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  if (post_to_task(op))
+    return;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -434,6 +481,11 @@ void scheduler::do_dispatch(
     scheduler::operation* op)
 {
   work_started();
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  if (post_to_task(op))
+    return;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -452,11 +504,10 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
 {
   while (!stopped_)
   {
-    if (!op_queue_.empty())
+    if (operation* o = check_run_budget(this_thread))
     {
       // Prepare to execute first handler from queue.
-      operation* o = op_queue_.front();
-      op_queue_.pop();
+      pop_operation(o);
       bool more_handlers = (!op_queue_.empty());
 
       if (o == &task_operation_)
@@ -474,11 +525,13 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         // Run the task. May throw an exception. Only block if the operation
         // queue is empty and we're not polling, otherwise we want to return
         // as soon as possible.
+        this_thread.task = task_;
         task_->run(more_handlers ? 0 : -1, this_thread.private_op_queue);
       }
       else
       {
         std::size_t task_result = o->task_result_;
+        consume_run_budget(this_thread);
 
         if (more_handlers && !one_thread_)
           wake_one_thread_and_unlock(lock);
@@ -513,18 +566,18 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
-  operation* o = op_queue_.front();
+  operation* o = check_run_budget(this_thread);
   if (o == 0)
   {
     wakeup_event_.clear(lock);
     wakeup_event_.wait_for_usec(lock, usec);
     usec = 0; // Wait at most once.
-    o = op_queue_.front();
+    o = front_operation();
   }
 
   if (o == &task_operation_)
   {
-    op_queue_.pop();
+    pop_operation(o);
     bool more_handlers = (!op_queue_.empty());
 
     task_interrupted_ = more_handlers;
@@ -541,6 +594,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
+      this_thread.task = task_;
       task_->run(more_handlers ? 0 : usec, this_thread.private_op_queue);
     }
 
@@ -560,6 +614,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   bool more_handlers = (!op_queue_.empty());
 
   std::size_t task_result = o->task_result_;
+  consume_run_budget(this_thread);
 
   if (more_handlers && !one_thread_)
     wake_one_thread_and_unlock(lock);
@@ -584,10 +639,10 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
-  operation* o = op_queue_.front();
+  operation* o = check_run_budget(this_thread);
   if (o == &task_operation_)
   {
-    op_queue_.pop();
+    pop_operation(o);
     lock.unlock();
 
     {
@@ -597,6 +652,7 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
+      this_thread.task = task_;
       task_->run(0, this_thread.private_op_queue);
     }
 
@@ -615,6 +671,7 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   bool more_handlers = (!op_queue_.empty());
 
   std::size_t task_result = o->task_result_;
+  consume_run_budget(this_thread);
 
   if (more_handlers && !one_thread_)
     wake_one_thread_and_unlock(lock);
@@ -632,6 +689,65 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   return 1;
 }
 
+void scheduler::consume_run_budget(scheduler::thread_info& this_thread)
+{
+  if (run_budget_handlers_ != 0 || run_budget_usec_ > 0)
+    if (this_thread.budget_handlers++ == 0 && run_budget_usec_ > 0)
+      this_thread.budget_start = chrono::steady_clock::now();
+}
+
+scheduler::operation* scheduler::check_run_budget(
+    scheduler::thread_info& this_thread)
+{
+  operation* o = front_operation();
+  if (o == 0 || o == &task_operation_ || this_thread.budget_handlers == 0)
+    return o;
+
+  bool handler_limit = run_budget_handlers_ != 0
+    && this_thread.budget_handlers >= run_budget_handlers_;
+  bool time_limit = !handler_limit && run_budget_usec_ > 0
+    && chrono::steady_clock::now() - this_thread.budget_start
+      >= chrono::microseconds(run_budget_usec_);
+  if (!handler_limit && !time_limit)
+    return o;
+
+  // Start a new budget. If the task is not in the queue then it is already
+  // being run by another thread, and there is nothing to force.
+  this_thread.budget_handlers = 0;
+  if (task_out_of_turn_ || !op_queue_.is_enqueued(&task_operation_))
+    return o;
+
+  if (handler_limit)
+    ++run_budget_handler_triggers_;
+  else
+    ++run_budget_time_triggers_;
+
+  // Run the task ahead of the queued handlers. When it is run, the presence
+  // of those handlers means that it will not block. Its entry is left where
+  // it is, rather than searching the queue to remove it.
+  task_out_of_turn_ = true;
+  return &task_operation_;
+}
+
+scheduler::operation* scheduler::front_operation()
+{
+  operation* o = op_queue_.front();
+  if (o == &task_operation_ && task_out_of_turn_)
+  {
+    // The task is already running. Its entry is restored to the back of the
+    // queue when it finishes.
+    op_queue_.pop();
+    o = op_queue_.front();
+  }
+  return o;
+}
+
+void scheduler::pop_operation(scheduler::operation* o)
+{
+  if (o != &task_operation_ || !task_out_of_turn_)
+    op_queue_.pop();
+}
+
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
@@ -659,6 +775,31 @@ void scheduler::wake_one_thread_and_unlock(
   }
 }
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+bool scheduler::post_to_task(scheduler::operation* op)
+{
+  // An operation posted from a thread that is running another io_uring
+  // scheduler is sent from that scheduler's ring to this one's, and returned
+  // by this scheduler's task along with the task's own completions.
+  scheduler_task* source = current_task();
+  scheduler_task* target = published_task_.load(std::memory_order_acquire);
+  if (source == 0 || target == 0 || source == target)
+    return false;
+  return static_cast<io_uring_service*>(source)->send_operation(
+      static_cast<io_uring_service*>(target), op);
+}
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+scheduler_task* scheduler::current_task()
+{
+  // Every thread context is a scheduler when io_uring is the default backend.
+  thread_info* this_thread = static_cast<thread_info*>(
+      thread_call_stack::top());
+  return this_thread ? this_thread->task : 0;
+}
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
 scheduler_task* scheduler::get_default_task(boost::asio::execution_context& ctx)
 {
 #if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
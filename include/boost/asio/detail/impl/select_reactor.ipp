@@ -362,6 +362,12 @@ void select_reactor::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void select_reactor::set_timer_slack(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.set_slack(usec);
+}
+
 timeval* select_reactor::get_timeout(long usec, timeval& tv)
 {
   // By default we will wait no longer than 5 minutes. This will ensure that
@@ -29,6 +29,14 @@
 #include <boost/asio/detail/socket_ops.hpp>
 #include <boost/asio/error.hpp>
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+# include <linux/errqueue.h>
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+# include <sys/sendfile.h>
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
 #if defined(BOOST_ASIO_WINDOWS_RUNTIME)
 # include <codecvt>
 # include <locale>
@@ -1366,6 +1374,79 @@ bool non_blocking_recvmsg(socket_type s,
   }
 }
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+bool non_blocking_recvmmsg(socket_type s,
+    mmsghdr* msgs, size_t count, int flags,
+    boost::system::error_code& ec, size_t& datagrams)
+{
+  for (;;)
+  {
+    // Read some datagrams.
+    int result = ::recvmmsg(s, msgs, static_cast<unsigned int>(count),
+        flags, 0);
+    get_last_error(ec, result < 0);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+    {
+      datagrams = static_cast<size_t>(result);
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    datagrams = 0;
+    return true;
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+
+bool non_blocking_recvmsg(socket_type s,
+    msghdr* msg, int flags, boost::system::error_code& ec,
+    size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Read some data.
+    signed_size_type bytes = ::recvmsg(s, msg, flags);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 signed_size_type send(socket_type s, const buf* bufs, size_t count,
@@ -1592,6 +1673,98 @@ bool non_blocking_send1(socket_type s,
   }
 }
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+bool non_blocking_recv_zero_copy_notification(
+    socket_type s, boost::system::error_code& ec)
+{
+  for (;;)
+  {
+    union
+    {
+      cmsghdr align;
+      char data[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    } control;
+    msghdr msg = msghdr();
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+
+    // Read a message from the error queue.
+    signed_size_type result = ::recvmsg(s, &msg, MSG_ERRQUEUE);
+    get_last_error(ec, result < 0);
+
+    if (result < 0)
+    {
+      // Retry operation if interrupted by signal.
+      if (ec == boost::asio::error::interrupted)
+        continue;
+
+      // Check if we need to run the operation again.
+      if (ec == boost::asio::error::would_block
+          || ec == boost::asio::error::try_again)
+        return false;
+
+      // Operation failed.
+      return true;
+    }
+
+    // Other messages on the error queue are discarded.
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if ((cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVERR)
+          || (cmsg->cmsg_level == IPPROTO_IPV6
+            && cmsg->cmsg_type == IPV6_RECVERR))
+      {
+        const sock_extended_err* err =
+          reinterpret_cast<const sock_extended_err*>(CMSG_DATA(cmsg));
+        if (err->ee_errno == 0 && err->ee_origin == SO_EE_ORIGIN_ZEROCOPY)
+          return true;
+      }
+    }
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+bool non_blocking_sendfile(socket_type s,
+    int fd, uint64_t& offset, size_t size,
+    boost::system::error_code& ec, size_t& bytes_transferred)
+{
+  for (;;)
+  {
+    // Send some data from the file.
+    off_t file_offset = static_cast<off_t>(offset);
+    signed_size_type bytes = ::sendfile(s, fd, &file_offset, size);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      offset = static_cast<uint64_t>(file_offset);
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 signed_size_type sendto(socket_type s, const buf* bufs,
@@ -1806,6 +1979,86 @@ bool non_blocking_sendto1(socket_type s,
   }
 }
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+bool non_blocking_sendmmsg(socket_type s,
+    mmsghdr* msgs, size_t count, int flags,
+    boost::system::error_code& ec, size_t& datagrams)
+{
+#if defined(BOOST_ASIO_HAS_MSG_NOSIGNAL)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(BOOST_ASIO_HAS_MSG_NOSIGNAL)
+
+  for (;;)
+  {
+    // Write some datagrams.
+    int result = ::sendmmsg(s, msgs, static_cast<unsigned int>(count), flags);
+    get_last_error(ec, result < 0);
+
+    // Check if operation succeeded.
+    if (result >= 0)
+    {
+      datagrams = static_cast<size_t>(result);
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    datagrams = 0;
+    return true;
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+
+bool non_blocking_sendmsg(socket_type s,
+    const msghdr* msg, int flags, boost::system::error_code& ec,
+    size_t& bytes_transferred)
+{
+#if defined(BOOST_ASIO_HAS_MSG_NOSIGNAL)
+  flags |= MSG_NOSIGNAL;
+#endif // defined(BOOST_ASIO_HAS_MSG_NOSIGNAL)
+
+  for (;;)
+  {
+    // Write some data.
+    signed_size_type bytes = ::sendmsg(s, msg, flags);
+    get_last_error(ec, bytes < 0);
+
+    // Check if operation succeeded.
+    if (bytes >= 0)
+    {
+      bytes_transferred = bytes;
+      return true;
+    }
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation failed.
+    bytes_transferred = 0;
+    return true;
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
 socket_type socket(int af, int type, int protocol,
@@ -1920,6 +2173,18 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
   get_last_error(ec, result != 0);
   if (result == 0)
   {
+#if defined(SO_ZEROCOPY)
+    // Sends on the socket avoid copying large buffers while the option is set.
+    if (level == SOL_SOCKET && optname == SO_ZEROCOPY
+        && optlen == sizeof(int))
+    {
+      if (*static_cast<const int*>(optval))
+        state |= zero_copy;
+      else
+        state &= ~zero_copy;
+    }
+#endif // defined(SO_ZEROCOPY)
+
 #if defined(__MACH__) && defined(__APPLE__) \
   || defined(__NetBSD__) || defined(__FreeBSD__) \
   || defined(__OpenBSD__) || defined(__QNX__)
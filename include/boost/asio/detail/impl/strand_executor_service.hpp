@@ -98,7 +98,7 @@ public:
 
     ~on_invoker_exit()
     {
-      if (push_waiting_to_ready(this_->impl_))
+      if (release_ready_handlers(this_->impl_))
       {
         recycling_allocator<void> allocator;
         executor_type ex = this_->executor_;
@@ -166,7 +166,7 @@ public:
 
     ~on_invoker_exit()
     {
-      if (push_waiting_to_ready(this_->impl_))
+      if (release_ready_handlers(this_->impl_))
       {
         Executor ex(this_->work_.get_executor());
         recycling_allocator<void> allocator;
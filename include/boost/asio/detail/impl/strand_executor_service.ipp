@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/chrono.hpp>
 #include <boost/asio/detail/strand_executor_service.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -27,7 +28,6 @@ namespace detail {
 strand_executor_service::strand_executor_service(execution_context& ctx)
   : execution_context_service_base<strand_executor_service>(ctx),
     mutex_(),
-    salt_(0),
     impl_list_(0)
 {
 }
@@ -41,11 +41,9 @@ void strand_executor_service::shutdown()
   strand_impl* impl = impl_list_;
   while (impl)
   {
-    impl->mutex_->lock();
-    impl->shutdown_ = true;
-    ops.push(impl->waiting_queue_);
+    impl->shutdown_.store(true, std::memory_order_release);
+    take_waiting(*impl);
     ops.push(impl->ready_queue_);
-    impl->mutex_->unlock();
     impl = impl->next_;
   }
 }
@@ -54,21 +52,18 @@ strand_executor_service::implementation_type
 strand_executor_service::create_implementation()
 {
   implementation_type new_impl(new strand_impl);
-  new_impl->locked_ = false;
-  new_impl->shutdown_ = false;
+  new_impl->waiting_stack_.store(0, std::memory_order_relaxed);
+  new_impl->pending_.store(0, std::memory_order_relaxed);
+  new_impl->shutdown_.store(false, std::memory_order_relaxed);
+  new_impl->completed_ = 0;
+  new_impl->quantum_handlers_.store(
+      BOOST_ASIO_STRAND_QUANTUM_HANDLERS, std::memory_order_relaxed);
+  new_impl->quantum_usec_.store(
+      BOOST_ASIO_STRAND_QUANTUM_USEC, std::memory_order_relaxed);
+  new_impl->handoffs_.store(0, std::memory_order_relaxed);
 
   boost::asio::detail::mutex::scoped_lock lock(mutex_);
 
-  // Select a mutex from the pool of shared mutexes.
-  std::size_t salt = salt_++;
-  std::size_t mutex_index = reinterpret_cast<std::size_t>(new_impl.get());
-  mutex_index += (reinterpret_cast<std::size_t>(new_impl.get()) >> 3);
-  mutex_index ^= salt + 0x9e3779b9 + (mutex_index << 6) + (mutex_index >> 2);
-  mutex_index = mutex_index % num_mutexes;
-  if (!mutexes_[mutex_index].get())
-    mutexes_[mutex_index].reset(new mutex);
-  new_impl->mutex_ = mutexes_[mutex_index].get();
-
   // Insert implementation into linked list of all implementations.
   new_impl->next_ = impl_list_;
   new_impl->prev_ = 0;
@@ -82,6 +77,9 @@ strand_executor_service::create_implementation()
 
 strand_executor_service::strand_impl::~strand_impl()
 {
+  // Destroy any handlers that were added after the service was shut down.
+  take_waiting(*this);
+
   boost::asio::detail::mutex::scoped_lock lock(service_->mutex_);
 
   // Remove implementation from linked list of all implementations.
@@ -96,29 +94,27 @@ strand_executor_service::strand_impl::~strand_impl()
 bool strand_executor_service::enqueue(const implementation_type& impl,
     scheduler_operation* op)
 {
-  impl->mutex_->lock();
-  if (impl->shutdown_)
+  if (impl->shutdown_.load(std::memory_order_acquire))
   {
-    impl->mutex_->unlock();
     op->destroy();
     return false;
   }
-  else if (impl->locked_)
-  {
-    // Some other function already holds the strand lock. Enqueue for later.
-    impl->waiting_queue_.push(op);
-    impl->mutex_->unlock();
-    return false;
-  }
-  else
+
+  // Push the function on to the waiting stack. Only other submitters can
+  // cause the exchange to fail, as the strand itself takes the whole stack.
+  scheduler_operation* head = impl->waiting_stack_.load(
+      std::memory_order_relaxed);
+  do
   {
-    // The function is acquiring the strand lock and so is responsible for
-    // scheduling the strand.
-    impl->locked_ = true;
-    impl->mutex_->unlock();
-    impl->ready_queue_.push(op);
-    return true;
-  }
+    op_queue_access::next(op, head);
+  } while (!impl->waiting_stack_.compare_exchange_weak(head, op,
+        std::memory_order_release, std::memory_order_relaxed));
+
+  // The function that finds the strand idle acquires the strand lock and so
+  // is responsible for scheduling the strand. The function is counted only
+  // after it has been pushed, so that the strand finds every function that
+  // it is scheduled to run.
+  return impl->pending_.fetch_add(1, std::memory_order_acq_rel) == 0;
 }
 
 bool strand_executor_service::running_in_this_thread(
@@ -127,13 +123,62 @@ bool strand_executor_service::running_in_this_thread(
   return !!call_stack<strand_impl>::contains(impl.get());
 }
 
-bool strand_executor_service::push_waiting_to_ready(implementation_type& impl)
+void strand_executor_service::set_quantum(const implementation_type& impl,
+    std::size_t max_handlers, long max_usec)
+{
+  impl->quantum_handlers_.store(max_handlers, std::memory_order_relaxed);
+  impl->quantum_usec_.store(max_usec, std::memory_order_relaxed);
+}
+
+std::size_t strand_executor_service::queue_depth(
+    const implementation_type& impl)
+{
+  long pending = impl->pending_.load(std::memory_order_relaxed);
+  return pending > 0 ? static_cast<std::size_t>(pending) : 0;
+}
+
+std::size_t strand_executor_service::handoff_count(
+    const implementation_type& impl)
 {
-  impl->mutex_->lock();
-  impl->ready_queue_.push(impl->waiting_queue_);
-  bool more_handlers = impl->locked_ = !impl->ready_queue_.empty();
-  impl->mutex_->unlock();
-  return more_handlers;
+  return impl->handoffs_.load(std::memory_order_relaxed);
+}
+
+bool strand_executor_service::release_ready_handlers(
+    implementation_type& impl)
+{
+  long completed = impl->completed_;
+  impl->completed_ = 0;
+  if (impl->pending_.fetch_sub(completed,
+        std::memory_order_acq_rel) <= completed)
+    return false;
+
+  impl->handoffs_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void strand_executor_service::take_waiting(strand_impl& impl)
+{
+  scheduler_operation* op = impl.waiting_stack_.exchange(
+      0, std::memory_order_acquire);
+  if (op == 0)
+    return;
+
+  // The stack holds the most recently added function first, so reverse it
+  // before appending it to the ready queue.
+  scheduler_operation* reversed = 0;
+  while (op)
+  {
+    scheduler_operation* next = op_queue_access::next(op);
+    op_queue_access::next(op, reversed);
+    reversed = op;
+    op = next;
+  }
+  while (reversed)
+  {
+    scheduler_operation* next = op_queue_access::next(reversed);
+    impl.ready_queue_.push(reversed);
+    reversed = next;
+  }
 }
 
 void strand_executor_service::run_ready_handlers(implementation_type& impl)
@@ -141,13 +186,49 @@ void strand_executor_service::run_ready_handlers(implementation_type& impl)
   // Indicate that this strand is executing on the current thread.
   call_stack<strand_impl>::context ctx(impl.get());
 
-  // Run all ready handlers. No lock is required since the ready queue is
-  // accessed only within the strand.
+  // Collect the handlers that were added since the strand last ran.
+  take_waiting(*impl);
+
+  std::size_t max_handlers =
+    impl->quantum_handlers_.load(std::memory_order_relaxed);
+  long max_usec = impl->quantum_usec_.load(std::memory_order_relaxed);
+  bool has_quantum = max_handlers != 0 || max_usec > 0;
+  chrono::steady_clock::time_point start;
+  if (max_usec > 0)
+    start = chrono::steady_clock::now();
+
+  // Run the ready handlers. No synchronisation is required since the ready
+  // queue is accessed only within the strand.
   boost::system::error_code ec;
-  while (scheduler_operation* o = impl->ready_queue_.front())
+  for (;;)
   {
-    impl->ready_queue_.pop();
-    o->complete(impl.get(), ec, 0);
+    while (scheduler_operation* o = impl->ready_queue_.front())
+    {
+      // Once the quantum is used up, any remaining handlers are left for the
+      // next time the strand is scheduled.
+      if (has_quantum && impl->completed_ > 0)
+      {
+        if (max_handlers != 0
+            && static_cast<std::size_t>(impl->completed_) >= max_handlers)
+          return;
+        if (max_usec > 0 && chrono::steady_clock::now() - start
+            >= chrono::microseconds(max_usec))
+          return;
+      }
+
+      impl->ready_queue_.pop();
+      ++impl->completed_;
+      o->complete(impl.get(), ec, 0);
+    }
+
+    // Without a quantum, handlers added while the strand was running wait
+    // until it is next scheduled. With one, the strand keeps running them on
+    // this thread rather than handing off through the underlying executor.
+    if (!has_quantum)
+      return;
+    take_waiting(*impl);
+    if (impl->ready_queue_.empty())
+      return;
   }
 }
 
@@ -82,6 +82,12 @@ void timer_queue<time_traits<boost::posix_time::ptime>>::cancel_timer_by_key(
   impl_.cancel_timer_by_key(timer, ops, cancellation_key);
 }
 
+bool timer_queue<time_traits<boost::posix_time::ptime>>::reschedule_timer(
+    const time_type& time, per_timer_data& timer)
+{
+  return impl_.reschedule_timer(time, timer);
+}
+
 void timer_queue<time_traits<boost::posix_time::ptime>>::move_timer(
     per_timer_data& target, per_timer_data& source)
 {
@@ -16,6 +16,8 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/chrono.hpp>
+#include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/timer_queue_set.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -25,7 +27,9 @@ namespace asio {
 namespace detail {
 
 timer_queue_set::timer_queue_set()
-  : first_(0)
+  : first_(0),
+    slack_usec_(0),
+    wakeup_usec_(0)
 {
 }
 
@@ -71,7 +75,7 @@ long timer_queue_set::wait_duration_msec(long max_duration) const
   long min_duration = max_duration;
   for (timer_queue_base* p = first_; p; p = p->next_)
     min_duration = p->wait_duration_msec(min_duration);
-  return min_duration;
+  return add_slack(min_duration, slack_usec_ / 1000, max_duration);
 }
 
 long timer_queue_set::wait_duration_usec(long max_duration) const
@@ -79,7 +83,40 @@ long timer_queue_set::wait_duration_usec(long max_duration) const
   long min_duration = max_duration;
   for (timer_queue_base* p = first_; p; p = p->next_)
     min_duration = p->wait_duration_usec(min_duration);
-  return min_duration;
+  return add_slack(min_duration, slack_usec_, max_duration);
+}
+
+void timer_queue_set::set_slack(long usec)
+{
+  slack_usec_ = usec > 0 ? usec : 0;
+  wakeup_usec_ = 0;
+}
+
+long timer_queue_set::wakeup_duration_usec(long max_duration)
+{
+  long usec = wait_duration_usec(max_duration);
+  if (slack_usec_ > 0)
+    wakeup_usec_ = now_usec() + usec;
+  return usec;
+}
+
+bool timer_queue_set::wakeup_within_slack() const
+{
+  if (slack_usec_ == 0)
+    return false;
+
+  int64_t now = now_usec();
+  if (wakeup_usec_ <= now)
+    return false;
+
+  // The wakeup may occur at any time from the earliest expiry up to the end of
+  // its slack.
+  const long max_duration = (std::numeric_limits<long>::max)();
+  long usec = wait_duration_usec(max_duration);
+  if (usec == max_duration)
+    return false;
+  return wakeup_usec_ <= now + usec
+    && wakeup_usec_ >= now + usec - slack_usec_;
 }
 
 void timer_queue_set::get_ready_timers(op_queue<operation>& ops)
@@ -94,6 +131,22 @@ void timer_queue_set::get_all_timers(op_queue<operation>& ops)
     p->get_all_timers(ops);
 }
 
+long timer_queue_set::add_slack(long duration, long slack, long max_duration)
+{
+  // Timers that have already expired are not deferred.
+  if (slack == 0 || duration <= 0 || duration >= max_duration)
+    return duration;
+  if (duration < max_duration - slack)
+    return duration + slack;
+  return max_duration;
+}
+
+int64_t timer_queue_set::now_usec()
+{
+  return chrono::duration_cast<chrono::microseconds>(
+      chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
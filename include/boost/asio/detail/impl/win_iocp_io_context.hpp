@@ -97,6 +97,16 @@ void win_iocp_io_context::cancel_timer_by_key(timer_queue<Time_Traits>& queue,
   post_deferred_completions(ops);
 }
 
+template <typename Time_Traits>
+void win_iocp_io_context::reschedule_timer(timer_queue<Time_Traits>& queue,
+    const typename Time_Traits::time_type& time,
+    typename timer_queue<Time_Traits>::per_timer_data& timer)
+{
+  mutex::scoped_lock lock(dispatch_mutex_);
+  if (queue.reschedule_timer(time, timer))
+    update_timeout();
+}
+
 template <typename Time_Traits>
 void win_iocp_io_context::move_timer(timer_queue<Time_Traits>& queue,
     typename timer_queue<Time_Traits>::per_timer_data& to,
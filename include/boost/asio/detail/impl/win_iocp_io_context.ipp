@@ -586,6 +586,12 @@ void win_iocp_io_context::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void win_iocp_io_context::set_timer_slack(long usec)
+{
+  mutex::scoped_lock lock(dispatch_mutex_);
+  timer_queues_.set_slack(usec);
+}
+
 void win_iocp_io_context::update_timeout()
 {
   if (timer_thread_.get())
@@ -70,6 +70,16 @@ std::size_t winrt_timer_scheduler::cancel_timer(timer_queue<Time_Traits>& queue,
   return n;
 }
 
+template <typename Time_Traits>
+void winrt_timer_scheduler::reschedule_timer(timer_queue<Time_Traits>& queue,
+    const typename Time_Traits::time_type& time,
+    typename timer_queue<Time_Traits>::per_timer_data& timer)
+{
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+  if (queue.reschedule_timer(time, timer))
+    event_.signal(lock);
+}
+
 template <typename Time_Traits>
 void winrt_timer_scheduler::move_timer(timer_queue<Time_Traits>& queue,
     typename timer_queue<Time_Traits>::per_timer_data& to,
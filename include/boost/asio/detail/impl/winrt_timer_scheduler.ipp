@@ -112,6 +112,12 @@ void winrt_timer_scheduler::do_remove_timer_queue(timer_queue_base& queue)
   timer_queues_.erase(&queue);
 }
 
+void winrt_timer_scheduler::set_timer_slack(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  timer_queues_.set_slack(usec);
+}
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
@@ -42,6 +42,9 @@ public:
   // The operation key used for targeted cancellation.
   void* cancellation_key_;
 
+  // The absolute timeout linked to the operation's submission, if any.
+  __kernel_timespec* link_timeout_;
+
   // Prepare the operation.
   void prepare(::io_uring_sqe* sqe)
   {
@@ -65,6 +68,7 @@ protected:
       ec_(success_ec),
       bytes_transferred_(0),
       cancellation_key_(0),
+      link_timeout_(0),
       prepare_func_(prepare_func),
       perform_func_(perform_func)
   {
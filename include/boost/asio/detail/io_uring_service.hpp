@@ -19,7 +19,9 @@
 
 #if defined(BOOST_ASIO_HAS_IO_URING)
 
+#include <vector>
 #include <liburing.h>
+#include <boost/asio/buffer_lease.hpp>
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
 #include <boost/asio/detail/conditionally_enabled_mutex.hpp>
@@ -33,13 +35,29 @@
 #include <boost/asio/detail/timer_queue_set.hpp>
 #include <boost/asio/detail/wait_op.hpp>
 #include <boost/asio/execution_context.hpp>
+#include <boost/asio/io_uring_options.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
+// The number of buffers in the ring provided to the kernel for multishot
+// receive operations. Must be a power of two no greater than 32768.
+#if !defined(BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT)
+# define BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT 1024
+#endif // !defined(BOOST_ASIO_IO_URING_PROVIDED_BUFFER_COUNT)
+
+// The number of slots in the ring's registered file table, into which the
+// descriptors of I/O objects are placed so that the kernel need not look up
+// the descriptor for each operation. Zero disables the table.
+#if !defined(BOOST_ASIO_IO_URING_REGISTERED_FILES)
+# define BOOST_ASIO_IO_URING_REGISTERED_FILES 0
+#endif // !defined(BOOST_ASIO_IO_URING_REGISTERED_FILES)
+
 namespace boost {
 namespace asio {
 namespace detail {
 
+class io_uring_multishot_operation;
+
 class io_uring_service
   : public execution_context_service_base<io_uring_service>,
     public scheduler_task
@@ -81,7 +99,10 @@ public:
     mutex mutex_;
     io_uring_service* service_;
     io_queue queues_[max_ops];
+    op_queue<io_uring_operation> multishot_ops_;
     bool shutdown_;
+    int descriptor_;
+    int registered_file_;
 
     BOOST_ASIO_DECL io_object(bool locking);
   };
@@ -105,8 +126,10 @@ public:
   // Initialise the task.
   BOOST_ASIO_DECL void init_task();
 
-  // Register an I/O object with io_uring.
-  BOOST_ASIO_DECL void register_io_object(io_object*& io_obj);
+  // Register an I/O object with io_uring. If a descriptor is given, it is
+  // placed in the registered file table when a slot is available.
+  BOOST_ASIO_DECL void register_io_object(
+      io_object*& io_obj, int descriptor = -1);
 
   // Register an internal I/O object with io_uring.
   BOOST_ASIO_DECL void register_internal_io_object(
@@ -126,6 +149,26 @@ public:
   BOOST_ASIO_DECL void start_op(int op_type, per_io_object_data& io_obj,
       io_uring_operation* op, bool is_continuation);
 
+  // Start a multishot operation. The operation remains submitted, and produces
+  // a completion for each result, until it fails or is cancelled.
+  BOOST_ASIO_DECL void start_multishot_op(per_io_object_data& io_obj,
+      io_uring_multishot_operation* op, bool is_continuation);
+
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+  // Get the identifier of the group of buffers provided to the kernel for
+  // multishot receive operations, creating the buffer ring if required.
+  BOOST_ASIO_DECL int provided_buffer_group(boost::system::error_code& ec);
+
+  // Create a lease on a provided buffer that the kernel has filled.
+  buffer_lease lease_provided_buffer(unsigned short bid, std::size_t size)
+  {
+    return buffer_lease(&io_uring_service::release_provided_buffer, this,
+        (buffer_generation_ << 16) | bid,
+        buffer_memory_ + bid * std::size_t(BOOST_ASIO_PROVIDED_BUFFER_SIZE),
+        size);
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+
   // Cancel all operations associated with the given I/O object. The handlers
   // associated with the I/O object will be invoked with the operation_aborted
   // error.
@@ -146,6 +189,13 @@ public:
   // object.
   BOOST_ASIO_DECL void cleanup_io_object(per_io_object_data& io_obj);
 
+  // Get the slot in the registered file table that holds the I/O object's
+  // descriptor, or -1 if the descriptor is used directly.
+  static int registered_file(const per_io_object_data& io_obj)
+  {
+    return io_obj ? io_obj->registered_file_ : -1;
+  }
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
@@ -174,12 +224,23 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data* timer,
       void* cancellation_key);
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
       typename timer_queue<Time_Traits>::per_timer_data& target,
       typename timer_queue<Time_Traits>::per_timer_data& source);
 
+  // Set the slack, in microseconds, by which timer expiries may be deferred
+  // so that timers expiring close together complete in a single batch.
+  BOOST_ASIO_DECL void set_timer_slack(long usec);
+
   // Wait on io_uring once until interrupted or events are ready to be
   // dispatched.
   BOOST_ASIO_DECL void run(long usec, op_queue<operation>& ops);
@@ -187,19 +248,38 @@ public:
   // Interrupt the io_uring wait.
   BOOST_ASIO_DECL void interrupt();
 
-private:
-  // The hint to pass to io_uring_queue_init to size its data structures.
-  enum { ring_size = 16384 };
-
-  // The number of operations to submit in a batch.
-  enum { submit_batch_size = 128 };
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  // Send an operation from this service's ring to another service's ring, to
+  // be returned by the other service's run(). The message is submitted with
+  // this ring's next batch of submission queue entries. Must be called from a
+  // thread that is running this service's scheduler, and assumes that
+  // work_started() was called on the other service's scheduler. Returns false
+  // if the message could not be prepared.
+  BOOST_ASIO_DECL bool send_operation(io_uring_service* target, operation* op);
+
+  // Get the number of operations that this service has delivered to other
+  // services' rings using MSG_RING. Must not be called while the service is
+  // being run.
+  std::size_t msg_ring_operations() const
+  {
+    return msg_ring_operations_;
+  }
 
-  // The number of operations to complete in a batch.
-  enum { complete_batch_size = 128 };
+  // Get whether the kernel has accepted MSG_RING entries from this service.
+  // Must not be called while the service is being run.
+  bool msg_ring_supported() const
+  {
+    return msg_ring_supported_;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
 
+private:
   // The type used for processing eventfd readiness notifications.
   class event_fd_read_op;
 
+  // Set up the parameters with which the ring is created.
+  BOOST_ASIO_DECL void init_options(const io_uring_options& options);
+
   // Initialise the ring.
   BOOST_ASIO_DECL void init_ring();
 
@@ -212,12 +292,139 @@ private:
   // Free an existing I/O object.
   BOOST_ASIO_DECL void free_io_object(io_object* s);
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  // An operation sent to another service's ring.
+  class msg_ring_message
+  {
+    friend class io_uring_service;
+    friend class object_pool_access;
+
+    msg_ring_message* next_;
+    msg_ring_message* prev_;
+
+    io_uring_service* target_;
+    operation* op_;
+  };
+
+  // Handle the completion, in this ring, of a message sent to another
+  // service's ring. A failed message's operation is queued with the other
+  // service's scheduler instead.
+  BOOST_ASIO_DECL void complete_send_operation(
+      msg_ring_message* msg, int result);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
   // Helper function to cancel all operations associated with the given I/O
   // object. This function must be called while the I/O object's mutex is held.
   // Returns true if there are operations for which cancellation is pending.
   BOOST_ASIO_DECL bool do_cancel_ops(
       per_io_object_data& io_obj, op_queue<operation>& ops);
 
+  // Prepare an operation's submission queue entry, substituting the I/O
+  // object's registered file, if it has one, for its descriptor. An operation
+  // with a timeout is followed by a linked timeout entry, and so the entry
+  // must have been obtained by get_sqe(2).
+  void prepare_op(io_object* io_obj,
+      io_uring_operation* op, ::io_uring_sqe* sqe)
+  {
+    op->prepare(sqe);
+    if (io_obj->registered_file_ >= 0 && sqe->fd == io_obj->descriptor_)
+    {
+      sqe->fd = io_obj->registered_file_;
+      sqe->flags |= IOSQE_FIXED_FILE;
+    }
+    if (op->link_timeout_)
+      prepare_link_timeout(op, sqe);
+  }
+
+  // Link a timeout to the operation's submission queue entry.
+  BOOST_ASIO_DECL void prepare_link_timeout(
+      io_uring_operation* op, ::io_uring_sqe* sqe);
+
+  // Place a descriptor in the registered file table. Returns the slot, or -1
+  // if no slot is available.
+  BOOST_ASIO_DECL int allocate_registered_file(int descriptor);
+
+  // Remove a descriptor from the registered file table, once any submission
+  // queue entries that refer to its slot have been submitted.
+  BOOST_ASIO_DECL void free_registered_file(int registered_file);
+
+  // Get the user data used to identify a multishot operation's completions.
+  static void* multishot_data(io_uring_multishot_operation* op)
+  {
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(op) | 1);
+  }
+
+  // Get the multishot operation identified by the given user data, or 0 if
+  // the user data does not identify a multishot operation.
+  static io_uring_multishot_operation* multishot_op(void* ptr)
+  {
+    uintptr_t data = reinterpret_cast<uintptr_t>(ptr);
+    return (data & 3) == 1
+      ? reinterpret_cast<io_uring_multishot_operation*>(data & ~uintptr_t(3))
+      : 0;
+  }
+
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  // Get the user data used to identify the completion, in the sending ring,
+  // of a message sent to another service's ring.
+  static void* msg_ring_data(msg_ring_message* msg)
+  {
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(msg) | 2);
+  }
+
+  // Get the message identified by the given user data, or 0 if the user data
+  // does not identify a message sent to another service's ring.
+  static msg_ring_message* msg_ring_msg(void* ptr)
+  {
+    uintptr_t data = reinterpret_cast<uintptr_t>(ptr);
+    return (data & 3) == 2
+      ? reinterpret_cast<msg_ring_message*>(data & ~uintptr_t(3))
+      : 0;
+  }
+
+  // Get the user data with which an operation sent from another service's
+  // ring completes in the receiving ring.
+  static void* msg_ring_op_data(operation* op)
+  {
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(op) | 3);
+  }
+
+  // Get the operation identified by the given user data, or 0 if the user
+  // data does not identify an operation sent from another service's ring.
+  static operation* msg_ring_op(void* ptr)
+  {
+    uintptr_t data = reinterpret_cast<uintptr_t>(ptr);
+    return (data & 3) == 3
+      ? reinterpret_cast<operation*>(data & ~uintptr_t(3))
+      : 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
+  // Process a completion for a multishot operation. Intermediate results are
+  // delivered as new completions, while the final result completes the
+  // operation itself.
+  BOOST_ASIO_DECL void complete_multishot_op(io_uring_multishot_operation* op,
+      int result, unsigned flags, op_queue<operation>& ops);
+
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+  // The identifier of the provided buffer group.
+  enum { provided_buffer_group_id = 0 };
+
+  // Register the provided buffer ring and give it all of the buffers. This
+  // function must be called while the mutex is held.
+  BOOST_ASIO_DECL void init_buffer_ring(boost::system::error_code& ec);
+
+  // Place a buffer in the provided buffer ring at the given offset from the
+  // tail, without making it visible to the kernel. This function must be
+  // called while the mutex is held.
+  BOOST_ASIO_DECL void add_provided_buffer(
+      void* data, unsigned short bid, int offset);
+
+  // Return a leased buffer to the provided buffer ring.
+  BOOST_ASIO_DECL static void release_provided_buffer(
+      void* owner, unsigned int id, void* data);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+
   // Helper function to add a new timer queue.
   BOOST_ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
 
@@ -228,10 +435,11 @@ private:
   BOOST_ASIO_DECL void update_timeout();
 
   // Get the current timeout value.
-  BOOST_ASIO_DECL __kernel_timespec get_timeout() const;
+  BOOST_ASIO_DECL __kernel_timespec get_timeout();
 
-  // Get a new submission queue entry, flushing the queue if necessary.
-  BOOST_ASIO_DECL ::io_uring_sqe* get_sqe();
+  // Get a new submission queue entry, flushing the queue if necessary so that
+  // the given number of consecutive entries are available.
+  BOOST_ASIO_DECL ::io_uring_sqe* get_sqe(unsigned count = 1);
 
   // Submit pending submission queue entries.
   BOOST_ASIO_DECL void submit_sqes();
@@ -263,6 +471,23 @@ private:
   // The ring.
   ::io_uring ring_;
 
+  // The number of entries in the submission queue.
+  unsigned ring_size_;
+
+  // The parameters with which the ring is created.
+  ::io_uring_params ring_params_;
+
+  // Whether a kernel thread polls the submission queue, so that submission
+  // queue entries may be submitted as soon as they are prepared.
+  bool submission_queue_polling_;
+
+  // The number of pending submission queue entries at which they are
+  // submitted immediately.
+  int submit_batch_size_;
+
+  // The number of completion queue entries processed in each run.
+  int complete_batch_size_;
+
   // The count of unfinished work.
   atomic_count outstanding_work_;
 
@@ -275,6 +500,17 @@ private:
   // Whether there is a pending submission operation.
   bool pending_submit_sqes_op_;
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  // Whether the kernel supports posting completions to other rings.
+  bool msg_ring_supported_;
+
+  // The number of operations delivered to other rings.
+  std::size_t msg_ring_operations_;
+
+  // The messages for which a completion in this ring is outstanding.
+  object_pool<msg_ring_message> msg_ring_messages_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
   // Whether the service has been shut down.
   bool shutdown_;
 
@@ -303,6 +539,80 @@ private:
 
   // The eventfd descriptor used to wait for readiness.
   int event_fd_;
+
+  // The state of the registered file table.
+  enum
+  {
+    registered_files_none,
+    registered_files_active,
+    registered_files_unavailable
+  } registered_files_state_;
+
+  // The slots in the registered file table that are not in use.
+  std::vector<int> free_registered_files_;
+
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+  // The ring of buffers provided to the kernel, or 0 if not yet created.
+  ::io_uring_buf_ring* buffer_ring_;
+
+  // The memory backing the provided buffers.
+  unsigned char* buffer_memory_;
+
+  // Incremented each time the buffer ring is registered with a new ring, so
+  // that leases taken before a fork are not returned to the child's ring.
+  unsigned int buffer_generation_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+};
+
+// Base class for operations that remain submitted to the ring and produce a
+// completion queue entry for each result.
+class io_uring_multishot_operation
+  : public io_uring_operation
+{
+public:
+  // Create the completion for an intermediate result. Returns 0 if there is
+  // nothing to deliver. The operation may end itself, by calling end(), when
+  // given a result that the kernel reported as final.
+  operation* deliver(int result, unsigned flags)
+  {
+    return deliver_func_(this, result, flags);
+  }
+
+protected:
+  typedef operation* (*deliver_func_type)(
+      io_uring_multishot_operation*, int, unsigned);
+
+  io_uring_multishot_operation(const boost::system::error_code& success_ec,
+      prepare_func_type prepare_func, deliver_func_type deliver_func,
+      func_type complete_func)
+    : io_uring_operation(success_ec, prepare_func,
+        &io_uring_multishot_operation::do_perform, complete_func),
+      io_object_(0),
+      cancel_requested_(false),
+      ended_(false),
+      deliver_func_(deliver_func)
+  {
+  }
+
+  // Prevent the operation from being submitted again once the kernel has
+  // reported its final result.
+  void end()
+  {
+    ended_ = true;
+  }
+
+private:
+  friend class io_uring_service;
+
+  static bool do_perform(io_uring_operation*, bool)
+  {
+    return true;
+  }
+
+  io_uring_service::io_object* io_object_;
+  bool cancel_requested_;
+  bool ended_;
+  deliver_func_type deliver_func_;
 };
 
 } // namespace detail
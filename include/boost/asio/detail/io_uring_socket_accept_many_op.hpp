@@ -0,0 +1,251 @@
+//
+// detail/io_uring_socket_accept_many_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_MANY_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_MANY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/socket_holder.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The completion for a single connection accepted by a multishot accept.
+template <typename Protocol, typename PeerIoExecutor,
+    typename Handler, typename IoExecutor>
+class io_uring_socket_accept_many_result_op : public operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_accept_many_result_op);
+
+  io_uring_socket_accept_many_result_op(const PeerIoExecutor& peer_io_ex,
+      const Protocol& protocol, socket_type new_socket,
+      const Handler& handler, const IoExecutor& io_ex)
+    : operation(&io_uring_socket_accept_many_result_op::do_complete),
+      peer_io_ex_(peer_io_ex),
+      protocol_(protocol),
+      new_socket_(new_socket),
+      handler_(handler),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_accept_many_result_op* o(
+        static_cast<io_uring_socket_accept_many_result_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    if (owner)
+    {
+      // Assign the new connection to a peer socket object.
+      boost::system::error_code ec;
+      peer_socket_type peer(o->peer_io_ex_);
+      peer.assign(o->protocol_, o->new_socket_.get(), ec);
+      if (!ec)
+        o->new_socket_.release();
+
+      BOOST_ASIO_ERROR_LOCATION(ec);
+
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the upcall is made.
+      detail::move_binder2<Handler,
+        boost::system::error_code, peer_socket_type>
+          handler(0, static_cast<Handler&&>(o->handler_), ec,
+            static_cast<peer_socket_type&&>(peer));
+      p.h = boost::asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+    else
+    {
+      // A sub-object of the handler may be the true owner of the memory
+      // associated with the handler, so a local copy is required to ensure
+      // that it remains valid until after the memory is deallocated.
+      Handler handler(static_cast<Handler&&>(o->handler_));
+      p.h = boost::asio::detail::addressof(handler);
+      p.reset();
+    }
+  }
+
+private:
+  typedef typename Protocol::socket::template
+    rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+  PeerIoExecutor peer_io_ex_;
+  Protocol protocol_;
+  socket_holder new_socket_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+// A multishot accept, which remains submitted and delivers each accepted
+// connection to a copy of the handler.
+template <typename Protocol, typename PeerIoExecutor,
+    typename Handler, typename IoExecutor>
+class io_uring_socket_accept_many_op : public io_uring_multishot_operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_accept_many_op);
+
+  io_uring_socket_accept_many_op(const boost::system::error_code& success_ec,
+      const PeerIoExecutor& peer_io_ex, socket_type socket,
+      const Protocol& protocol, Handler& handler, const IoExecutor& io_ex)
+    : io_uring_multishot_operation(success_ec,
+        &io_uring_socket_accept_many_op::do_prepare,
+        &io_uring_socket_accept_many_op::do_deliver,
+        &io_uring_socket_accept_many_op::do_complete),
+      socket_(socket),
+      protocol_(protocol),
+      peer_io_ex_(peer_io_ex),
+      io_ex_(io_ex),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_accept_many_op* o(
+        static_cast<io_uring_socket_accept_many_op*>(base));
+
+    ::io_uring_prep_multishot_accept(sqe, o->socket_, 0, 0, 0);
+  }
+
+  static operation* do_deliver(io_uring_multishot_operation* base,
+      int result, unsigned /*flags*/)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_accept_many_op* o(
+        static_cast<io_uring_socket_accept_many_op*>(base));
+
+    // Errors are only reported when they end the operation.
+    if (result < 0)
+      return 0;
+
+    // Ensure that the new connection is closed if the completion cannot be
+    // allocated.
+    socket_holder new_socket(result);
+
+    typedef io_uring_socket_accept_many_result_op<Protocol,
+        PeerIoExecutor, Handler, IoExecutor> result_op;
+    typename result_op::ptr p = { boost::asio::detail::addressof(o->handler_),
+      result_op::ptr::allocate(o->handler_), 0 };
+    p.p = new (p.v) result_op(o->peer_io_ex_,
+        o->protocol_, new_socket.get(), o->handler_, o->io_ex_);
+    new_socket.release();
+
+    operation* op = p.p;
+    p.v = p.p = 0;
+    return op;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_accept_many_op* o(
+        static_cast<io_uring_socket_accept_many_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    if (owner)
+    {
+      // The operation has ended, so the final upcall receives the error and
+      // a socket that is not open.
+      detail::move_binder2<Handler,
+        boost::system::error_code, peer_socket_type>
+          handler(0, static_cast<Handler&&>(o->handler_), o->ec_,
+            peer_socket_type(o->peer_io_ex_));
+      p.h = boost::asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+    else
+    {
+      // A sub-object of the handler may be the true owner of the memory
+      // associated with the handler, so a local copy is required to ensure
+      // that it remains valid until after the memory is deallocated.
+      Handler handler(static_cast<Handler&&>(o->handler_));
+      p.h = boost::asio::detail::addressof(handler);
+      p.reset();
+    }
+  }
+
+private:
+  typedef typename Protocol::socket::template
+    rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+  socket_type socket_;
+  Protocol protocol_;
+  PeerIoExecutor peer_io_ex_;
+  IoExecutor io_ex_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_MANY_OP_HPP
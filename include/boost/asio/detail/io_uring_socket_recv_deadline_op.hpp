@@ -0,0 +1,120 @@
+//
+// detail/io_uring_socket_recv_deadline_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECV_DEADLINE_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECV_DEADLINE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/chrono.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/io_uring_socket_recv_op.hpp>
+#include <boost/asio/detail/memory.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A receive whose submission queue entry is linked to a timeout, so that the
+// kernel cancels the receive if no data arrives before the deadline.
+template <typename MutableBufferSequence, typename Handler, typename IoExecutor>
+class io_uring_socket_recv_deadline_op
+  : public io_uring_socket_recv_op_base<MutableBufferSequence>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_recv_deadline_op);
+
+  io_uring_socket_recv_deadline_op(const boost::system::error_code& success_ec,
+      int socket, socket_ops::state_type state,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      const chrono::steady_clock::time_point& deadline,
+      Handler& handler, const IoExecutor& io_ex)
+    : io_uring_socket_recv_op_base<MutableBufferSequence>(success_ec,
+        socket, state, buffers, flags,
+        &io_uring_socket_recv_deadline_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+    // The steady clock measures the monotonic clock used by io_uring's
+    // absolute timeouts.
+    chrono::nanoseconds ns = chrono::duration_cast<chrono::nanoseconds>(
+        deadline.time_since_epoch());
+    if (ns.count() < 0)
+      ns = chrono::nanoseconds(0);
+    timeout_.tv_sec = ns.count() / 1000000000;
+    timeout_.tv_nsec = ns.count() % 1000000000;
+    this->link_timeout_ = &timeout_;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_deadline_op* o
+      (static_cast<io_uring_socket_recv_deadline_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  __kernel_timespec timeout_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECV_DEADLINE_OP_HPP
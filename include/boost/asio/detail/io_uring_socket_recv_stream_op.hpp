@@ -0,0 +1,245 @@
+//
+// detail/io_uring_socket_recv_stream_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECV_STREAM_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECV_STREAM_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/buffer_lease.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The completion for a single buffer of data received by a multishot receive.
+template <typename Handler, typename IoExecutor>
+class io_uring_socket_recv_stream_result_op : public operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_recv_stream_result_op);
+
+  io_uring_socket_recv_stream_result_op(buffer_lease&& lease,
+      const Handler& handler, const IoExecutor& io_ex)
+    : operation(&io_uring_socket_recv_stream_result_op::do_complete),
+      lease_(static_cast<buffer_lease&&>(lease)),
+      handler_(handler),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_stream_result_op* o(
+        static_cast<io_uring_socket_recv_stream_result_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    if (owner)
+    {
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the upcall is made.
+      detail::move_binder2<Handler, boost::system::error_code, buffer_lease>
+        handler(0, static_cast<Handler&&>(o->handler_),
+          boost::system::error_code(),
+          static_cast<buffer_lease&&>(o->lease_));
+      p.h = boost::asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_,
+            handler.arg2_.size()));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+    else
+    {
+      // A sub-object of the handler may be the true owner of the memory
+      // associated with the handler, so a local copy is required to ensure
+      // that it remains valid until after the memory is deallocated.
+      Handler handler(static_cast<Handler&&>(o->handler_));
+      p.h = boost::asio::detail::addressof(handler);
+      p.reset();
+    }
+  }
+
+private:
+  buffer_lease lease_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+// A multishot receive, which remains submitted and delivers each buffer of
+// received data, chosen by the kernel from the provided buffer ring, to a copy
+// of the handler.
+template <typename Handler, typename IoExecutor>
+class io_uring_socket_recv_stream_op : public io_uring_multishot_operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_recv_stream_op);
+
+  io_uring_socket_recv_stream_op(const boost::system::error_code& success_ec,
+      io_uring_service* service, int buffer_group, socket_type socket,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : io_uring_multishot_operation(success_ec,
+        &io_uring_socket_recv_stream_op::do_prepare,
+        &io_uring_socket_recv_stream_op::do_deliver,
+        &io_uring_socket_recv_stream_op::do_complete),
+      service_(service),
+      buffer_group_(buffer_group),
+      socket_(socket),
+      flags_(flags),
+      io_ex_(io_ex),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_stream_op* o(
+        static_cast<io_uring_socket_recv_stream_op*>(base));
+
+    ::io_uring_prep_recv_multishot(sqe, o->socket_, 0, 0, o->flags_);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = static_cast<__u16>(o->buffer_group_);
+  }
+
+  static operation* do_deliver(io_uring_multishot_operation* base,
+      int result, unsigned flags)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_stream_op* o(
+        static_cast<io_uring_socket_recv_stream_op*>(base));
+
+    // A zero-length result means that the peer has closed the connection.
+    if (result == 0)
+    {
+      o->ec_ = boost::asio::error::eof;
+      o->end();
+      return 0;
+    }
+
+    // Errors are only reported when they end the operation.
+    if (result < 0 || (flags & IORING_CQE_F_BUFFER) == 0)
+      return 0;
+
+    // Ensure that the buffer is returned to the ring if the completion cannot
+    // be allocated.
+    buffer_lease lease(o->service_->lease_provided_buffer(
+          static_cast<unsigned short>(flags >> IORING_CQE_BUFFER_SHIFT),
+          static_cast<std::size_t>(result)));
+
+    typedef io_uring_socket_recv_stream_result_op<
+        Handler, IoExecutor> result_op;
+    typename result_op::ptr p = { boost::asio::detail::addressof(o->handler_),
+      result_op::ptr::allocate(o->handler_), 0 };
+    p.p = new (p.v) result_op(static_cast<buffer_lease&&>(lease),
+        o->handler_, o->io_ex_);
+
+    operation* op = p.p;
+    p.v = p.p = 0;
+    return op;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_stream_op* o(
+        static_cast<io_uring_socket_recv_stream_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    if (owner)
+    {
+      // The operation has ended, so the final upcall receives the error and
+      // an empty lease.
+      detail::move_binder2<Handler, boost::system::error_code, buffer_lease>
+        handler(0, static_cast<Handler&&>(o->handler_), o->ec_,
+          buffer_lease());
+      p.h = boost::asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, 0));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+    else
+    {
+      // A sub-object of the handler may be the true owner of the memory
+      // associated with the handler, so a local copy is required to ensure
+      // that it remains valid until after the memory is deallocated.
+      Handler handler(static_cast<Handler&&>(o->handler_));
+      p.h = boost::asio::detail::addressof(handler);
+      p.reset();
+    }
+  }
+
+private:
+  io_uring_service* service_;
+  int buffer_group_;
+  socket_type socket_;
+  socket_base::message_flags flags_;
+  IoExecutor io_ex_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECV_STREAM_OP_HPP
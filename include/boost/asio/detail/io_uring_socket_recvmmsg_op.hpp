@@ -0,0 +1,216 @@
+//
+// detail/io_uring_socket_recvmmsg_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECVMMSG_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECVMMSG_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING) \
+  && defined(BOOST_ASIO_HAS_MMSG)
+
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/datagram_batch.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/socket_base.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Receives a batch of datagrams. The submitted entry receives the first
+// datagram, and any others already queued on the socket are then collected
+// with recvmmsg. When the socket is non-blocking, the entry instead waits for
+// readiness and the whole batch is received with recvmmsg.
+template <typename Slot>
+class io_uring_socket_recvmmsg_op_base : public io_uring_operation
+{
+public:
+  io_uring_socket_recvmmsg_op_base(const boost::system::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state, Slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      func_type complete_func)
+    : io_uring_operation(success_ec,
+        &io_uring_socket_recvmmsg_op_base::do_prepare,
+        &io_uring_socket_recvmmsg_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      batch_(slots, count, true),
+      flags_(flags)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recvmmsg_op_base* o(
+        static_cast<io_uring_socket_recvmmsg_op_base*>(base));
+
+    if ((o->state_ & socket_ops::internal_non_blocking) != 0)
+    {
+      ::io_uring_prep_poll_add(sqe, o->socket_, POLLIN);
+    }
+    else
+    {
+      ::io_uring_prep_recvmsg(sqe, o->socket_,
+          &o->batch_.msgs()->msg_hdr, o->flags_);
+    }
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recvmmsg_op_base* o(
+        static_cast<io_uring_socket_recvmmsg_op_base*>(base));
+
+    if ((o->state_ & socket_ops::internal_non_blocking) != 0)
+    {
+      // The wait for readiness failed.
+      if (after_completion && o->ec_)
+      {
+        o->bytes_transferred_ = 0;
+        return true;
+      }
+
+      std::size_t datagrams = 0;
+      if (!socket_ops::non_blocking_recvmmsg(o->socket_, o->batch_.msgs(),
+            o->batch_.count(), o->flags_, o->ec_, datagrams))
+        return false;
+
+      if (!o->ec_)
+        o->batch_.complete(datagrams);
+      o->bytes_transferred_ = datagrams;
+      return true;
+    }
+
+    // The operation has not yet been submitted.
+    if (!after_completion)
+      return false;
+
+    if (o->ec_)
+    {
+      if (o->ec_ == boost::asio::error::would_block)
+      {
+        o->state_ |= socket_ops::internal_non_blocking;
+        return false;
+      }
+
+      o->bytes_transferred_ = 0;
+      return true;
+    }
+
+    // The submitted entry received the first datagram. Any others that are
+    // already queued are collected without waiting.
+    o->batch_.set_size(0, o->bytes_transferred_);
+    std::size_t datagrams = 0;
+    if (o->batch_.count() > 1)
+    {
+      boost::system::error_code ec;
+      if (!socket_ops::non_blocking_recvmmsg(o->socket_, o->batch_.msgs(1),
+            o->batch_.count() - 1, o->flags_ | MSG_DONTWAIT, ec, datagrams))
+        datagrams = 0;
+    }
+
+    o->batch_.complete(1 + datagrams);
+    o->bytes_transferred_ = 1 + datagrams;
+    return true;
+  }
+
+private:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  datagram_batch<Slot> batch_;
+  socket_base::message_flags flags_;
+};
+
+template <typename Slot, typename Handler, typename IoExecutor>
+class io_uring_socket_recvmmsg_op :
+  public io_uring_socket_recvmmsg_op_base<Slot>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_recvmmsg_op);
+
+  io_uring_socket_recvmmsg_op(const boost::system::error_code& success_ec,
+      socket_type socket, socket_ops::state_type state, Slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : io_uring_socket_recvmmsg_op_base<Slot>(success_ec, socket, state,
+        slots, count, flags, &io_uring_socket_recvmmsg_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recvmmsg_op* o
+      (static_cast<io_uring_socket_recvmmsg_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+       //   && defined(BOOST_ASIO_HAS_MMSG)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_RECVMMSG_OP_HPP
@@ -0,0 +1,165 @@
+//
+// detail/io_uring_socket_send_zc_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_SEND_ZC_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_SEND_ZC_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING_SEND_ZC)
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A zero-copy send. The kernel posts one completion with the result of the
+// send, followed by a notification once it has released the pages holding the
+// data, and so the send is treated as a multishot operation that ends with
+// the notification.
+template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+class io_uring_socket_send_zc_op : public io_uring_multishot_operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_send_zc_op);
+
+  io_uring_socket_send_zc_op(const boost::system::error_code& success_ec,
+      socket_type socket, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : io_uring_multishot_operation(success_ec,
+        &io_uring_socket_send_zc_op::do_prepare,
+        &io_uring_socket_send_zc_op::do_deliver,
+        &io_uring_socket_send_zc_op::do_complete),
+      socket_(socket),
+      buffers_(buffers),
+      flags_(flags),
+      bufs_(buffers),
+      msghdr_(),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+    msghdr_.msg_iov = bufs_.buffers();
+    msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_send_zc_op* o(
+        static_cast<io_uring_socket_send_zc_op*>(base));
+
+    ::io_uring_prep_sendmsg_zc(sqe, o->socket_, &o->msghdr_, o->flags_);
+  }
+
+  static operation* do_deliver(io_uring_multishot_operation* base,
+      int result, unsigned flags)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_send_zc_op* o(
+        static_cast<io_uring_socket_send_zc_op*>(base));
+
+    if ((flags & IORING_CQE_F_NOTIF) == 0)
+    {
+      // The result of the send itself. No notification follows unless the
+      // kernel says there are more completions to come.
+      if (result < 0)
+        o->ec_.assign(-result, boost::asio::error::get_system_category());
+      else
+        o->bytes_transferred_ = static_cast<std::size_t>(result);
+      if ((flags & IORING_CQE_F_MORE) == 0)
+        o->end();
+    }
+    else
+    {
+      // The kernel has released the pages.
+      o->end();
+    }
+
+    return 0;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_send_zc_op* o(
+        static_cast<io_uring_socket_send_zc_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  socket_type socket_;
+  ConstBufferSequence buffers_;
+  socket_base::message_flags flags_;
+  buffer_sequence_adapter<boost::asio::const_buffer, ConstBufferSequence> bufs_;
+  msghdr msghdr_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING_SEND_ZC)
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_SEND_ZC_OP_HPP
@@ -0,0 +1,190 @@
+//
+// detail/io_uring_socket_sendto_segments_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_SENDTO_SEGMENTS_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_SENDTO_SEGMENTS_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_HAS_UDP_GSO)
+
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/udp_segment_control.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Sends a buffer that the kernel splits into UDP segments of a given size.
+template <typename ConstBufferSequence, typename Endpoint>
+class io_uring_socket_sendto_segments_op_base : public io_uring_operation
+{
+public:
+  io_uring_socket_sendto_segments_op_base(
+      const boost::system::error_code& success_ec, socket_type socket,
+      socket_ops::state_type state, const ConstBufferSequence& buffers,
+      std::size_t segment_size, const Endpoint& endpoint,
+      socket_base::message_flags flags, func_type complete_func)
+    : io_uring_operation(success_ec,
+        &io_uring_socket_sendto_segments_op_base::do_prepare,
+        &io_uring_socket_sendto_segments_op_base::do_perform, complete_func),
+      socket_(socket),
+      state_(state),
+      buffers_(buffers),
+      destination_(endpoint),
+      flags_(flags),
+      bufs_(buffers),
+      msghdr_()
+  {
+    msghdr_.msg_iov = bufs_.buffers();
+    msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
+    msghdr_.msg_name = static_cast<sockaddr*>(
+        static_cast<void*>(destination_.data()));
+    msghdr_.msg_namelen = destination_.size();
+    control_.prepare_send(msghdr_, segment_size);
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_sendto_segments_op_base* o(
+        static_cast<io_uring_socket_sendto_segments_op_base*>(base));
+
+    if ((o->state_ & socket_ops::internal_non_blocking) != 0)
+    {
+      ::io_uring_prep_poll_add(sqe, o->socket_, POLLOUT);
+    }
+    else
+    {
+      ::io_uring_prep_sendmsg(sqe, o->socket_, &o->msghdr_, o->flags_);
+    }
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_sendto_segments_op_base* o(
+        static_cast<io_uring_socket_sendto_segments_op_base*>(base));
+
+    if ((o->state_ & socket_ops::internal_non_blocking) != 0)
+    {
+      return socket_ops::non_blocking_sendmsg(o->socket_,
+          &o->msghdr_, o->flags_, o->ec_, o->bytes_transferred_);
+    }
+
+    if (o->ec_ && o->ec_ == boost::asio::error::would_block)
+    {
+      o->state_ |= socket_ops::internal_non_blocking;
+      return false;
+    }
+
+    return after_completion;
+  }
+
+private:
+  socket_type socket_;
+  socket_ops::state_type state_;
+  ConstBufferSequence buffers_;
+  Endpoint destination_;
+  socket_base::message_flags flags_;
+  buffer_sequence_adapter<boost::asio::const_buffer, ConstBufferSequence> bufs_;
+  msghdr msghdr_;
+  udp_segment_control control_;
+};
+
+template <typename ConstBufferSequence, typename Endpoint,
+    typename Handler, typename IoExecutor>
+class io_uring_socket_sendto_segments_op
+  : public io_uring_socket_sendto_segments_op_base<
+      ConstBufferSequence, Endpoint>
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_sendto_segments_op);
+
+  io_uring_socket_sendto_segments_op(
+      const boost::system::error_code& success_ec, int socket,
+      socket_ops::state_type state, const ConstBufferSequence& buffers,
+      std::size_t segment_size, const Endpoint& endpoint,
+      socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+    : io_uring_socket_sendto_segments_op_base<ConstBufferSequence, Endpoint>(
+        success_ec, socket, state, buffers, segment_size, endpoint, flags,
+        &io_uring_socket_sendto_segments_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_sendto_segments_op* o
+      (static_cast<io_uring_socket_sendto_segments_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_HAS_UDP_GSO)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_SENDTO_SEGMENTS_OP_HPP
@@ -28,10 +28,15 @@
 #include <boost/asio/detail/noncopyable.hpp>
 #include <boost/asio/detail/io_uring_null_buffers_op.hpp>
 #include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/io_uring_socket_accept_many_op.hpp>
 #include <boost/asio/detail/io_uring_socket_accept_op.hpp>
 #include <boost/asio/detail/io_uring_socket_connect_op.hpp>
 #include <boost/asio/detail/io_uring_socket_recvfrom_op.hpp>
+#include <boost/asio/detail/io_uring_socket_recvfrom_segments_op.hpp>
+#include <boost/asio/detail/io_uring_socket_recvmmsg_op.hpp>
+#include <boost/asio/detail/io_uring_socket_sendmmsg_op.hpp>
 #include <boost/asio/detail/io_uring_socket_sendto_op.hpp>
+#include <boost/asio/detail/io_uring_socket_sendto_segments_op.hpp>
 #include <boost/asio/detail/io_uring_socket_service_base.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
@@ -302,6 +307,86 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+  // Start an asynchronous send of a batch of datagrams. The slots, and the
+  // data they refer to, must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Slot, typename Handler, typename IoExecutor>
+  void async_send_many_to(implementation_type& impl, Slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_sendmmsg_op<Slot, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
+        slots, count, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::write_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_send_many_to"));
+
+    start_op(impl, io_uring_service::write_op, p.p,
+        is_continuation, count == 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+  // Start an asynchronous send of a buffer that is split into segments of the
+  // given size. The data being sent must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename ConstBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_send_segments_to(implementation_type& impl,
+      const ConstBufferSequence& buffers, std::size_t segment_size,
+      const endpoint_type& destination, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_sendto_segments_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
+        buffers, segment_size, destination, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::write_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_send_segments_to"));
+
+    start_op(impl, io_uring_service::write_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler, typename IoExecutor>
   void async_send_to(implementation_type& impl, const null_buffers&,
@@ -425,6 +510,87 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+  // Start an asynchronous receive of a batch of datagrams. The slots, and the
+  // buffers they refer to, must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Slot, typename Handler, typename IoExecutor>
+  void async_receive_many_from(implementation_type& impl, Slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recvmmsg_op<Slot, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
+        slots, count, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_many_from"));
+
+    start_op(impl, io_uring_service::read_op, p.p,
+        is_continuation, count == 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+  // Start an asynchronous receive of a datagram that may have been coalesced
+  // from several segments. The buffer for the data being received and the
+  // sender_endpoint object must both be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_segments_from(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recvfrom_segments_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
+        buffers, sender_endpoint, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_segments_from"));
+
+    start_op(impl, io_uring_service::read_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
   // Wait until data can be received without blocking.
   template <typename Handler, typename IoExecutor>
   void async_receive_from(implementation_type& impl, const null_buffers&,
@@ -576,6 +742,46 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+  // Start an asynchronous accept that remains submitted, and delivers each
+  // new connection to a copy of the handler. The new sockets are produced
+  // directly.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_move_accept_many(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_accept_many_op<Protocol,
+        PeerIoExecutor, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, peer_io_ex,
+        impl.socket_, impl.protocol_, handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_accept_many"));
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    io_uring_service_.start_multishot_op(
+        impl.io_object_data_, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MULTISHOT)
+
   // Connect the socket to the specified endpoint.
   boost::system::error_code connect(implementation_type& impl,
       const endpoint_type& peer_endpoint, boost::system::error_code& ec)
@@ -29,9 +29,13 @@
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/io_uring_null_buffers_op.hpp>
 #include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/io_uring_socket_recv_deadline_op.hpp>
 #include <boost/asio/detail/io_uring_socket_recv_op.hpp>
+#include <boost/asio/detail/io_uring_socket_recv_stream_op.hpp>
 #include <boost/asio/detail/io_uring_socket_recvmsg_op.hpp>
 #include <boost/asio/detail/io_uring_socket_send_op.hpp>
+#include <boost/asio/detail/io_uring_socket_send_zc_op.hpp>
+#include <boost/asio/detail/io_uring_socket_splice_op.hpp>
 #include <boost/asio/detail/io_uring_wait_op.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
@@ -290,6 +294,29 @@ public:
     bool is_continuation =
       boost_asio_handler_cont_helpers::is_continuation(handler);
 
+#if defined(BOOST_ASIO_HAS_IO_URING_SEND_ZC)
+    if ((impl.state_ & socket_ops::zero_copy) != 0
+        && (impl.state_ & socket_ops::internal_non_blocking) == 0
+        && boost::asio::buffer_size(buffers) >= BOOST_ASIO_ZERO_COPY_THRESHOLD)
+    {
+      // Allocate and construct an operation to wrap the handler.
+      typedef io_uring_socket_send_zc_op<
+          ConstBufferSequence, Handler, IoExecutor> op;
+      typename op::ptr p = { boost::asio::detail::addressof(handler),
+        op::ptr::allocate(handler), 0 };
+      p.p = new (p.v) op(success_ec_, impl.socket_,
+          buffers, flags, handler, io_ex);
+
+      BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+            "socket", &impl, impl.socket_, "async_send(zero_copy)"));
+
+      io_uring_service_.start_multishot_op(
+          impl.io_object_data_, p.p, is_continuation);
+      p.v = p.p = 0;
+      return;
+    }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_SEND_ZC)
+
     associated_cancellation_slot_t<Handler> slot
       = boost::asio::get_associated_cancellation_slot(handler);
 
@@ -351,6 +378,43 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  // Start an asynchronous send of a range of a file. The file must remain
+  // open for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_send_file(base_implementation_type& impl, int file,
+      uint64_t offset, uint64_t length,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_splice_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        file, offset, length, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::write_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_send_file"));
+
+    start_op(impl, io_uring_service::write_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
   // Receive some data from the peer. Returns the number of bytes received.
   template <typename MutableBufferSequence>
   size_t receive(base_implementation_type& impl,
@@ -427,6 +491,51 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous receive that fails with the timed_out error if no
+  // data arrives before the deadline. The buffer for the data being received
+  // must be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive(base_implementation_type& impl,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      const chrono::steady_clock::time_point& deadline,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    int op_type = (flags & socket_base::message_out_of_band)
+      ? io_uring_service::except_op : io_uring_service::read_op;
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_deadline_op<
+        MutableBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        impl.state_, buffers, flags, deadline, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(
+            &io_uring_service_, &impl.io_object_data_, op_type);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive(deadline)"));
+
+    start_op(impl, op_type, p.p, is_continuation,
+        ((impl.state_ & socket_ops::stream_oriented)
+          && buffer_sequence_adapter<boost::asio::mutable_buffer,
+            MutableBufferSequence>::all_empty(buffers)));
+    p.v = p.p = 0;
+  }
+
   // Wait until data can be received without blocking.
   template <typename Handler, typename IoExecutor>
   void async_receive(base_implementation_type& impl,
@@ -473,6 +582,55 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+  // Start a multishot receive that delivers each buffer of received data,
+  // selected by the kernel from the provided buffer ring, to the handler.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_stream(base_implementation_type& impl,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    boost::system::error_code ec;
+    int buffer_group = io_uring_service_.provided_buffer_group(ec);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_stream_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, &io_uring_service_,
+        buffer_group, impl.socket_, flags, handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_stream"));
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    if (ec)
+    {
+      p.p->ec_ = ec;
+      io_uring_service_.post_immediate_completion(p.p, is_continuation);
+    }
+    else
+    {
+      io_uring_service_.start_multishot_op(
+          impl.io_object_data_, p.p, is_continuation);
+    }
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_PROVIDED_BUFFERS)
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
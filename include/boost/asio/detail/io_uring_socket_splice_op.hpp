@@ -0,0 +1,252 @@
+//
+// detail/io_uring_socket_splice_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_URING_SOCKET_SPLICE_OP_HPP
+#define BOOST_ASIO_DETAIL_IO_URING_SOCKET_SPLICE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+#include <fcntl.h>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Sends a range of a file by splicing it into a pipe and then from the pipe
+// to the socket, so that the data is not copied to user space. The operation
+// is resubmitted for each splice until the whole range has been sent.
+class io_uring_socket_splice_op_base : public io_uring_operation
+{
+public:
+  io_uring_socket_splice_op_base(const boost::system::error_code& success_ec,
+      socket_type socket, int file, uint64_t offset, uint64_t length,
+      func_type complete_func)
+    : io_uring_operation(success_ec,
+        &io_uring_socket_splice_op_base::do_prepare,
+        &io_uring_socket_splice_op_base::do_perform, complete_func),
+      socket_(socket),
+      file_(file),
+      offset_(offset),
+      remaining_(length),
+      in_pipe_(0),
+      total_(0),
+      stage_(fill_pipe)
+  {
+    pipe_[0] = pipe_[1] = -1;
+  }
+
+  ~io_uring_socket_splice_op_base()
+  {
+    if (pipe_[0] != -1)
+      ::close(pipe_[0]);
+    if (pipe_[1] != -1)
+      ::close(pipe_[1]);
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_splice_op_base* o(
+        static_cast<io_uring_socket_splice_op_base*>(base));
+
+    switch (o->stage_)
+    {
+    case fill_pipe:
+      ::io_uring_prep_splice(sqe, o->file_, static_cast<int64_t>(o->offset_),
+          o->pipe_[1], -1, o->remaining_ > max_chunk_size
+            ? static_cast<unsigned int>(max_chunk_size)
+            : static_cast<unsigned int>(o->remaining_), 0);
+      break;
+    case drain_pipe:
+      ::io_uring_prep_splice(sqe, o->pipe_[0], -1,
+          o->socket_, -1, o->in_pipe_, 0);
+      break;
+    default:
+      ::io_uring_prep_poll_add(sqe, o->socket_, POLLOUT);
+      break;
+    }
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_splice_op_base* o(
+        static_cast<io_uring_socket_splice_op_base*>(base));
+
+    // The operation has not yet been submitted.
+    if (!after_completion)
+    {
+      if (o->remaining_ == 0)
+        return true;
+      if (o->pipe_[0] == -1)
+      {
+        if (::pipe2(o->pipe_, O_CLOEXEC) != 0)
+        {
+          o->ec_ = boost::system::error_code(errno,
+              boost::asio::error::get_system_category());
+          return true;
+        }
+
+        // A larger pipe means fewer splices. Failure is harmless.
+        (void)::fcntl(o->pipe_[1], F_SETPIPE_SZ, static_cast<int>(pipe_size));
+      }
+      return false;
+    }
+
+    if (o->ec_)
+    {
+      // A non-blocking socket is waited on until it is writable.
+      if (o->stage_ == drain_pipe
+          && (o->ec_ == boost::asio::error::would_block
+            || o->ec_ == boost::asio::error::try_again))
+      {
+        o->stage_ = wait_writable;
+        o->bytes_transferred_ = o->total_;
+        return false;
+      }
+
+      o->bytes_transferred_ = o->total_;
+      return true;
+    }
+
+    std::size_t bytes = o->bytes_transferred_;
+    switch (o->stage_)
+    {
+    case fill_pipe:
+      // The file ended before the whole range was sent.
+      if (bytes == 0)
+      {
+        o->ec_ = boost::asio::error::eof;
+        o->bytes_transferred_ = o->total_;
+        return true;
+      }
+      o->offset_ += bytes;
+      o->remaining_ -= bytes;
+      o->in_pipe_ = static_cast<unsigned int>(bytes);
+      o->stage_ = drain_pipe;
+      break;
+    case drain_pipe:
+      o->in_pipe_ -= static_cast<unsigned int>(bytes);
+      o->total_ += bytes;
+      if (o->in_pipe_ == 0)
+        o->stage_ = fill_pipe;
+      break;
+    default:
+      o->stage_ = drain_pipe;
+      break;
+    }
+
+    o->bytes_transferred_ = o->total_;
+    return o->remaining_ == 0 && o->in_pipe_ == 0;
+  }
+
+private:
+  enum stage_type { fill_pipe, drain_pipe, wait_writable };
+
+  // The largest number of bytes passed to a single splice, and the requested
+  // size of the pipe.
+  enum { max_chunk_size = 0x7ffff000, pipe_size = 1024 * 1024 };
+
+  socket_type socket_;
+  int file_;
+  int pipe_[2];
+  uint64_t offset_;
+  uint64_t remaining_;
+  unsigned int in_pipe_;
+  std::size_t total_;
+  stage_type stage_;
+};
+
+template <typename Handler, typename IoExecutor>
+class io_uring_socket_splice_op : public io_uring_socket_splice_op_base
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_splice_op);
+
+  io_uring_socket_splice_op(const boost::system::error_code& success_ec,
+      socket_type socket, int file, uint64_t offset, uint64_t length,
+      Handler& handler, const IoExecutor& io_ex)
+    : io_uring_socket_splice_op_base(success_ec, socket, file, offset,
+        length, &io_uring_socket_splice_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_splice_op* o
+      (static_cast<io_uring_socket_splice_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+#endif // BOOST_ASIO_DETAIL_IO_URING_SOCKET_SPLICE_OP_HPP
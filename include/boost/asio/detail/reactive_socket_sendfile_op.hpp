@@ -0,0 +1,212 @@
+//
+// detail/reactive_socket_sendfile_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
+#define BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Sends a range of a file with sendfile, continuing each time the socket
+// becomes writable until the whole range has been sent.
+class reactive_socket_sendfile_op_base : public reactor_op
+{
+public:
+  reactive_socket_sendfile_op_base(const boost::system::error_code& success_ec,
+      socket_type socket, int file, uint64_t offset, uint64_t length,
+      func_type complete_func)
+    : reactor_op(success_ec,
+        &reactive_socket_sendfile_op_base::do_perform, complete_func),
+      socket_(socket),
+      file_(file),
+      offset_(offset),
+      remaining_(length),
+      total_(0)
+  {
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    reactive_socket_sendfile_op_base* o(
+        static_cast<reactive_socket_sendfile_op_base*>(base));
+
+    while (o->remaining_ > 0)
+    {
+      std::size_t size = o->remaining_ > max_chunk_size
+        ? static_cast<std::size_t>(max_chunk_size)
+        : static_cast<std::size_t>(o->remaining_);
+      std::size_t bytes_transferred = 0;
+      if (!socket_ops::non_blocking_sendfile(o->socket_, o->file_,
+            o->offset_, size, o->ec_, bytes_transferred))
+      {
+        o->bytes_transferred_ = o->total_;
+        return not_done;
+      }
+
+      if (o->ec_)
+        break;
+
+      // The file ended before the whole range was sent.
+      if (bytes_transferred == 0)
+      {
+        o->ec_ = boost::asio::error::eof;
+        break;
+      }
+
+      o->total_ += bytes_transferred;
+      o->remaining_ -= bytes_transferred;
+    }
+
+    o->bytes_transferred_ = o->total_;
+
+    BOOST_ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_sendfile",
+          o->ec_, o->bytes_transferred_));
+
+    return done;
+  }
+
+private:
+  // The largest number of bytes passed to a single sendfile call.
+  enum { max_chunk_size = 0x7ffff000 };
+
+  socket_type socket_;
+  int file_;
+  uint64_t offset_;
+  uint64_t remaining_;
+  std::size_t total_;
+};
+
+template <typename Handler, typename IoExecutor>
+class reactive_socket_sendfile_op : public reactive_socket_sendfile_op_base
+{
+public:
+  typedef Handler handler_type;
+  typedef IoExecutor io_executor_type;
+
+  BOOST_ASIO_DEFINE_HANDLER_PTR(reactive_socket_sendfile_op);
+
+  reactive_socket_sendfile_op(const boost::system::error_code& success_ec,
+      socket_type socket, int file, uint64_t offset, uint64_t length,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactive_socket_sendfile_op_base(success_ec, socket, file, offset,
+        length, &reactive_socket_sendfile_op::do_complete),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    reactive_socket_sendfile_op* o(
+        static_cast<reactive_socket_sendfile_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  static void do_immediate(operation* base, bool, const void* io_ex)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    reactive_socket_sendfile_op* o(
+        static_cast<reactive_socket_sendfile_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    immediate_handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+    w.complete(handler, handler.handler_, io_ex);
+    BOOST_ASIO_HANDLER_INVOCATION_END;
+  }
+
+private:
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_REACTIVE_SOCKET_SENDFILE_OP_HPP
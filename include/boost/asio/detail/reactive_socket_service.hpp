@@ -31,7 +31,11 @@
 #include <boost/asio/detail/reactive_socket_accept_op.hpp>
 #include <boost/asio/detail/reactive_socket_connect_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvfrom_op.hpp>
+#include <boost/asio/detail/reactive_socket_recvfrom_segments_op.hpp>
+#include <boost/asio/detail/reactive_socket_recvmmsg_op.hpp>
+#include <boost/asio/detail/reactive_socket_sendmmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_sendto_op.hpp>
+#include <boost/asio/detail/reactive_socket_sendto_segments_op.hpp>
 #include <boost/asio/detail/reactive_socket_service_base.hpp>
 #include <boost/asio/detail/reactive_socket_send_request_to_op.hpp>
 #include <boost/asio/detail/reactive_socket_recv_request_from_op.hpp>
@@ -387,6 +391,87 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+  // Start an asynchronous send of a batch of datagrams. The slots, and the
+  // data they refer to, must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Slot, typename Handler, typename IoExecutor>
+  void async_send_many_to(implementation_type& impl, Slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmmsg_op<Slot, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        slots, count, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_many_to"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, count == 0, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+  // Start an asynchronous send of a buffer that is split into segments of the
+  // given size. The data being sent must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename ConstBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_send_segments_to(implementation_type& impl,
+      const ConstBufferSequence& buffers, std::size_t segment_size,
+      const endpoint_type& destination, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendto_segments_op<ConstBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        buffers, segment_size, destination, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_segments_to"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, false, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
   // // Start an asynchronous wait until data can be sent without blocking.
   // template <typename Handler, typename IoExecutor>
   // void async_send_to(implementation_type& impl, const null_buffers&,
@@ -543,6 +628,88 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+  // Start an asynchronous receive of a batch of datagrams. The slots, and the
+  // buffers they refer to, must be valid for the lifetime of the asynchronous
+  // operation.
+  template <typename Slot, typename Handler, typename IoExecutor>
+  void async_receive_many_from(implementation_type& impl, Slot* slots,
+      std::size_t count, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmmsg_op<Slot, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        slots, count, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_many_from"));
+
+    start_op(impl, reactor::read_op, p.p,
+        is_continuation, true, count == 0, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+  // Start an asynchronous receive of a datagram that may have been coalesced
+  // from several segments. The buffer for the data being received and the
+  // sender_endpoint object must both be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_segments_from(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvfrom_segments_op<MutableBufferSequence,
+        endpoint_type, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        buffers, sender_endpoint, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_segments_from"));
+
+    start_op(impl, reactor::read_op, p.p,
+        is_continuation, true, false, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
   // // Wait until data can be received without blocking.
   // template <typename Handler, typename IoExecutor>
   // void async_receive_from(implementation_type& impl, const null_buffers&,
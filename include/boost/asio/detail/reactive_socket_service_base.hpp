@@ -33,6 +33,8 @@
 #include <boost/asio/detail/reactive_socket_recv_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_send_op.hpp>
+#include <boost/asio/detail/reactive_socket_send_zc_op.hpp>
+#include <boost/asio/detail/reactive_socket_sendfile_op.hpp>
 #include <boost/asio/detail/reactive_wait_op.hpp>
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
@@ -287,6 +289,15 @@ public:
       const ConstBufferSequence& buffers, socket_base::message_flags flags,
       Handler& handler, const IoExecutor& io_ex)
   {
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+    if ((impl.state_ & socket_ops::zero_copy) != 0
+        && boost::asio::buffer_size(buffers) >= BOOST_ASIO_ZERO_COPY_THRESHOLD)
+    {
+      async_send_zero_copy(impl, buffers, flags, handler, io_ex);
+      return;
+    }
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
     bool is_continuation =
       boost_asio_handler_cont_helpers::is_continuation(handler);
 
@@ -319,6 +330,44 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  // Start an asynchronous send of a range of a file. The file must remain
+  // open for the lifetime of the asynchronous operation.
+  template <typename Handler, typename IoExecutor>
+  void async_send_file(base_implementation_type& impl, int file,
+      uint64_t offset, uint64_t length,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendfile_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        file, offset, length, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send_file"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, false, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler, typename IoExecutor>
   void async_send(base_implementation_type& impl, const null_buffers&,
@@ -589,6 +638,45 @@ protected:
       base_implementation_type& impl, int type,
       const native_handle_type& native_socket, boost::system::error_code& ec);
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  // Start an asynchronous send that does not complete until the kernel has
+  // released the pages holding the data.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_zero_copy(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_send_zc_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        buffers, flags, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::write_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_send(zero_copy)"));
+
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, true, false, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
   // Start the asynchronous read or write operation.
   BOOST_ASIO_DECL void do_start_op(base_implementation_type& impl, int op_type,
       reactor_op* op, bool is_continuation, bool is_non_blocking, bool noop,
@@ -0,0 +1,371 @@
+//
+// detail/receive_deadline_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_RECEIVE_DEADLINE_OP_HPP
+#define BOOST_ASIO_DETAIL_RECEIVE_DEADLINE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/associator.hpp>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/wait_traits.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/chrono.hpp>
+#include <boost/asio/detail/chrono_time_traits.hpp>
+#include <boost/asio/detail/deadline_timer_service.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/recycling_allocator.hpp>
+#include <boost/asio/detail/thread_info_base.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The state shared by a receive with a deadline and the timer that enforces
+// the deadline. The state is reference counted, with one reference held by
+// the receive and one by the timer wait.
+class receive_deadline_state
+  : private noncopyable
+{
+public:
+  typedef deadline_timer_service<
+    chrono_time_traits<chrono::steady_clock,
+      wait_traits<chrono::steady_clock>>> timer_service_type;
+
+  // Allocate a new state.
+  static receive_deadline_state* create(execution_context& context)
+  {
+    typedef recycling_allocator<receive_deadline_state,
+      thread_info_base::default_tag> allocator_type;
+    allocator_type alloc;
+    receive_deadline_state* p = alloc.allocate(1);
+    try
+    {
+      return new (p) receive_deadline_state(context);
+    }
+    catch (...)
+    {
+      alloc.deallocate(p, 1);
+      throw;
+    }
+  }
+
+  // Add a reference to the state.
+  void add_ref()
+  {
+    ref_count_up(ref_count_);
+  }
+
+  // Remove a reference, destroying the state when none remain.
+  void release()
+  {
+    if (ref_count_down(ref_count_))
+    {
+      recycling_allocator<receive_deadline_state,
+        thread_info_base::default_tag> alloc;
+      this->~receive_deadline_state();
+      alloc.deallocate(this, 1);
+    }
+  }
+
+  // Emit a cancellation signal to the receive, unless it has completed.
+  void cancel(cancellation_type_t type)
+  {
+    if (!done_.load(std::memory_order_acquire))
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (!done_.load(std::memory_order_relaxed))
+        signal_.emit(type);
+    }
+  }
+
+  // Cancel the receive because the deadline has expired.
+  void expire()
+  {
+    if (!done_.load(std::memory_order_acquire))
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (!done_.load(std::memory_order_relaxed))
+      {
+        timed_out_.store(true, std::memory_order_relaxed);
+        signal_.emit(cancellation_type::total);
+      }
+    }
+  }
+
+  // Mark the receive as complete and stop the timer. Returns whether the
+  // receive was cancelled because the deadline expired.
+  bool complete()
+  {
+    mutex::scoped_lock lock(mutex_);
+    done_.store(true, std::memory_order_release);
+    boost::system::error_code ignored_ec;
+    timer_service_.cancel(timer_, ignored_ec);
+    return timed_out_.load(std::memory_order_relaxed);
+  }
+
+  // The mutex that serialises starting, cancelling and completing the
+  // receive.
+  mutex mutex_;
+
+  // The service and implementation of the timer.
+  timer_service_type& timer_service_;
+  timer_service_type::implementation_type timer_;
+
+  // The signal used to cancel the receive.
+  cancellation_signal signal_;
+
+private:
+  explicit receive_deadline_state(execution_context& context)
+    : timer_service_(boost::asio::use_service<timer_service_type>(context)),
+      timed_out_(false),
+      done_(false),
+      ref_count_(1)
+  {
+    timer_service_.construct(timer_);
+  }
+
+  ~receive_deadline_state()
+  {
+    timer_service_.destroy(timer_);
+  }
+
+  std::atomic<bool> timed_out_;
+  std::atomic<bool> done_;
+  atomic_count ref_count_;
+};
+
+// Holds a reference to a receive_deadline_state.
+class receive_deadline_state_ptr
+{
+public:
+  explicit receive_deadline_state_ptr(receive_deadline_state* state) noexcept
+    : state_(state)
+  {
+  }
+
+  receive_deadline_state_ptr(const receive_deadline_state_ptr& other) noexcept
+    : state_(other.state_)
+  {
+    if (state_)
+      state_->add_ref();
+  }
+
+  receive_deadline_state_ptr(receive_deadline_state_ptr&& other) noexcept
+    : state_(other.state_)
+  {
+    other.state_ = 0;
+  }
+
+  ~receive_deadline_state_ptr()
+  {
+    reset();
+  }
+
+  void reset() noexcept
+  {
+    if (state_)
+    {
+      state_->release();
+      state_ = 0;
+    }
+  }
+
+  receive_deadline_state* get() const noexcept
+  {
+    return state_;
+  }
+
+  receive_deadline_state* operator->() const noexcept
+  {
+    return state_;
+  }
+
+private:
+  receive_deadline_state_ptr& operator=(
+      const receive_deadline_state_ptr&) = delete;
+
+  receive_deadline_state* state_;
+};
+
+// Cancels the receive when the deadline expires.
+class receive_deadline_timeout_handler
+{
+public:
+  explicit receive_deadline_timeout_handler(
+      const receive_deadline_state_ptr& state)
+    : state_(state)
+  {
+  }
+
+  void operator()(const boost::system::error_code& ec)
+  {
+    if (!ec)
+      state_->expire();
+  }
+
+private:
+  receive_deadline_state_ptr state_;
+};
+
+// Forwards cancellation requested through the user's handler to the receive.
+// The slot is cleared before the receive releases its reference to the state.
+class receive_deadline_cancellation
+{
+public:
+  explicit receive_deadline_cancellation(receive_deadline_state* state)
+    : state_(state)
+  {
+  }
+
+  void operator()(cancellation_type_t type)
+  {
+    state_->cancel(type);
+  }
+
+private:
+  receive_deadline_state* state_;
+};
+
+// Runs a receive alongside a timer. If the timer expires first it cancels the
+// receive, and the resulting operation_aborted error is reported to the
+// handler as timed_out.
+template <typename Socket, typename Handler>
+class receive_deadline_op
+{
+public:
+  typedef receive_deadline_state::timer_service_type timer_service_type;
+
+  receive_deadline_op(Socket& socket,
+      execution_context& context, Handler& handler)
+    : socket_(socket),
+      state_(receive_deadline_state::create(context)),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  receive_deadline_op(const receive_deadline_op& other)
+    : socket_(other.socket_),
+      state_(other.state_),
+      handler_(other.handler_)
+  {
+  }
+
+  receive_deadline_op(receive_deadline_op&& other)
+    : socket_(other.socket_),
+      state_(static_cast<receive_deadline_state_ptr&&>(other.state_)),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  template <typename MutableBufferSequence>
+  void start(const MutableBufferSequence& buffers,
+      socket_base::message_flags flags,
+      const chrono::steady_clock::time_point& deadline)
+  {
+    receive_deadline_state_ptr state(state_);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler_);
+    if (slot.is_connected())
+      slot.template emplace<receive_deadline_cancellation>(state.get());
+
+    // Hold the lock until the timer has been started, so that neither the
+    // timer nor the completion of the receive can run before both operations
+    // are in place.
+    mutex::scoped_lock lock(state->mutex_);
+
+    socket_.async_receive(buffers, flags,
+        boost::asio::bind_cancellation_slot(state->signal_.slot(),
+          static_cast<receive_deadline_op&&>(*this)));
+
+    boost::system::error_code ignored_ec;
+    state->timer_service_.expires_at(state->timer_, deadline, ignored_ec);
+    receive_deadline_timeout_handler timeout_handler(state);
+    state->timer_service_.async_wait(state->timer_,
+        timeout_handler, socket_.get_executor());
+  }
+
+  void operator()(boost::system::error_code ec, std::size_t bytes_transferred)
+  {
+    if (state_->complete() && ec == boost::asio::error::operation_aborted)
+      ec = boost::asio::error::timed_out;
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler_);
+    if (slot.is_connected())
+      slot.clear();
+
+    state_.reset();
+    static_cast<Handler&&>(handler_)(ec, bytes_transferred);
+  }
+
+//private:
+  Socket& socket_;
+  receive_deadline_state_ptr state_;
+  Handler handler_;
+};
+
+template <typename Socket, typename Handler>
+inline bool asio_handler_is_continuation(
+    receive_deadline_op<Socket, Handler>* this_handler)
+{
+  return boost_asio_handler_cont_helpers::is_continuation(
+      this_handler->handler_);
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Socket, typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::receive_deadline_op<Socket, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::receive_deadline_op<Socket, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::receive_deadline_op<Socket, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_RECEIVE_DEADLINE_OP_HPP
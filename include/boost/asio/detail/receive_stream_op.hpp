@@ -0,0 +1,168 @@
+//
+// detail/receive_stream_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_RECEIVE_STREAM_OP_HPP
+#define BOOST_ASIO_DETAIL_RECEIVE_STREAM_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <new>
+#include <boost/asio/associator.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/buffer_lease.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Waits for a socket to become readable and only then allocates a buffer and
+// receives into it, so that buffer memory is held only by connections that
+// have data. Each buffer is delivered as a lease to a copy of the handler,
+// after the next wait has been started.
+template <typename Socket, typename Handler>
+class receive_stream_op
+{
+public:
+  receive_stream_op(Socket& socket,
+      socket_base::message_flags flags, Handler& handler)
+    : socket_(socket),
+      flags_(flags),
+      start_(0),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  receive_stream_op(const receive_stream_op& other)
+    : socket_(other.socket_),
+      flags_(other.flags_),
+      start_(other.start_),
+      handler_(other.handler_)
+  {
+  }
+
+  receive_stream_op(receive_stream_op&& other)
+    : socket_(other.socket_),
+      flags_(other.flags_),
+      start_(other.start_),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  void start()
+  {
+    socket_.async_wait(socket_base::wait_read,
+        static_cast<receive_stream_op&&>(*this));
+  }
+
+  void operator()(boost::system::error_code ec)
+  {
+    start_ = 1;
+    if (!ec)
+    {
+      unsigned char* data =
+        new (std::nothrow) unsigned char[BOOST_ASIO_PROVIDED_BUFFER_SIZE];
+      if (!data)
+      {
+        ec = boost::asio::error::no_memory;
+      }
+      else
+      {
+        std::size_t bytes_transferred = socket_.receive(
+            boost::asio::buffer(data, BOOST_ASIO_PROVIDED_BUFFER_SIZE),
+            flags_, ec);
+        if (!ec)
+        {
+          buffer_lease lease(&receive_stream_op::release_buffer,
+              0, 0, data, bytes_transferred);
+          Handler handler(handler_);
+          start();
+          static_cast<Handler&&>(handler)(ec,
+              static_cast<buffer_lease&&>(lease));
+          return;
+        }
+
+        delete[] data;
+        if (ec == boost::asio::error::would_block
+            || ec == boost::asio::error::try_again)
+        {
+          start();
+          return;
+        }
+      }
+    }
+
+    static_cast<Handler&&>(handler_)(ec, buffer_lease());
+  }
+
+  static void release_buffer(void*, unsigned int, void* data)
+  {
+    delete[] static_cast<unsigned char*>(data);
+  }
+
+//private:
+  Socket& socket_;
+  socket_base::message_flags flags_;
+  int start_;
+  Handler handler_;
+};
+
+template <typename Socket, typename Handler>
+inline bool asio_handler_is_continuation(
+    receive_stream_op<Socket, Handler>* this_handler)
+{
+  return this_handler->start_ == 0
+    ? boost_asio_handler_cont_helpers::is_continuation(
+        this_handler->handler_)
+    : true;
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Socket, typename Handler, typename DefaultCandidate>
+struct associator<Associator,
+    detail::receive_stream_op<Socket, Handler>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::receive_stream_op<Socket, Handler>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(const detail::receive_stream_op<Socket, Handler>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_RECEIVE_STREAM_OP_HPP
@@ -28,8 +28,20 @@
 #include <boost/asio/detail/thread.hpp>
 #include <boost/asio/detail/thread_context.hpp>
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+# include <atomic>
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
 #include <boost/asio/detail/push_options.hpp>
 
+#if !defined(BOOST_ASIO_SCHEDULER_RUN_BUDGET_HANDLERS)
+# define BOOST_ASIO_SCHEDULER_RUN_BUDGET_HANDLERS 0
+#endif // !defined(BOOST_ASIO_SCHEDULER_RUN_BUDGET_HANDLERS)
+
+#if !defined(BOOST_ASIO_SCHEDULER_RUN_BUDGET_USEC)
+# define BOOST_ASIO_SCHEDULER_RUN_BUDGET_USEC 0
+#endif // !defined(BOOST_ASIO_SCHEDULER_RUN_BUDGET_USEC)
+
 namespace boost {
 namespace asio {
 namespace detail {
@@ -136,12 +148,40 @@ public:
   // work_started() was previously called for the operations.
   BOOST_ASIO_DECL void abandon_operations(op_queue<operation>& ops);
 
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Get the task most recently run by the current thread within the innermost
+  // scheduler that the thread is running. Returns null if the thread is not
+  // running a scheduler, or has not yet run that scheduler's task.
+  BOOST_ASIO_DECL static scheduler_task* current_task();
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
   // Get the concurrency hint that was used to initialise the scheduler.
   int concurrency_hint() const
   {
     return concurrency_hint_;
   }
 
+  // Set the maximum number of handlers, and the maximum time in microseconds,
+  // that a thread may spend running handlers before the task is forced to run
+  // with a zero timeout. A value of 0 disables the corresponding limit.
+  BOOST_ASIO_DECL void set_run_budget(std::size_t max_handlers, long max_usec);
+
+  // Get the number of times the task was forced to run because a thread
+  // reached the handler limit of its run budget.
+  std::size_t run_budget_handler_triggers() const
+  {
+    return static_cast<std::size_t>(
+        static_cast<long>(run_budget_handler_triggers_));
+  }
+
+  // Get the number of times the task was forced to run because a thread
+  // reached the time limit of its run budget.
+  std::size_t run_budget_time_triggers() const
+  {
+    return static_cast<std::size_t>(
+        static_cast<long>(run_budget_time_triggers_));
+  }
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -164,6 +204,30 @@ private:
   BOOST_ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const boost::system::error_code& ec);
 
+  // Account for a handler about to be run by the current thread.
+  BOOST_ASIO_DECL void consume_run_budget(thread_info& this_thread);
+
+  // Determine whether the current thread has exhausted its run budget while
+  // the task is waiting in the queue. If so, return the task so that it runs
+  // out of turn. Otherwise, return the operation at the front of the queue.
+  BOOST_ASIO_DECL operation* check_run_budget(thread_info& this_thread);
+
+  // Get the operation at the front of the queue, first discarding the entry
+  // of a task that is running out of turn.
+  BOOST_ASIO_DECL operation* front_operation();
+
+  // Remove an operation returned by check_run_budget from the queue. A task
+  // that runs out of turn keeps its entry in the queue.
+  BOOST_ASIO_DECL void pop_operation(operation* o);
+
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  // Hand an operation directly to the task from the task of the scheduler that
+  // the current thread is running, without locking this scheduler. Assumes
+  // that work_started() was previously called for the operation. Returns false
+  // if the operation must be queued instead.
+  BOOST_ASIO_DECL bool post_to_task(operation* op);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
   // Stop the task and all idle threads.
   BOOST_ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -199,6 +263,11 @@ private:
   // The task to be run by this service.
   scheduler_task* task_;
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  // The task, for use by threads that do not hold the mutex.
+  std::atomic<scheduler_task*> published_task_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
   // The function used to get the task.
   get_task_func_type get_task_;
 
@@ -211,6 +280,10 @@ private:
   // Whether the task has been interrupted.
   bool task_interrupted_;
 
+  // Whether the task is running out of turn because a thread exhausted its
+  // run budget. The task's entry is left in place in the queue while it runs.
+  bool task_out_of_turn_;
+
   // The count of unfinished work.
   atomic_count outstanding_work_;
 
@@ -226,6 +299,17 @@ private:
   // The concurrency hint used to initialise the scheduler.
   const int concurrency_hint_;
 
+  // The maximum number of handlers a thread may run before running the task.
+  std::size_t run_budget_handlers_;
+
+  // The maximum time a thread may spend running handlers before running the
+  // task.
+  long run_budget_usec_;
+
+  // The number of times each limit of the run budget has forced the task.
+  atomic_count run_budget_handler_triggers_;
+  atomic_count run_budget_time_triggers_;
+
   // The thread that is running the scheduler.
   boost::asio::detail::thread* thread_;
 };
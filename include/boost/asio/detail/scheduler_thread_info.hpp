@@ -15,6 +15,8 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstddef>
+#include <boost/asio/detail/chrono.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/thread_info_base.hpp>
 
@@ -26,11 +28,22 @@ namespace detail {
 
 class scheduler;
 class scheduler_operation;
+class scheduler_task;
 
 struct scheduler_thread_info : public thread_info_base
 {
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+
+  // The number of handlers run by this thread since it last ran the task.
+  std::size_t budget_handlers;
+
+  // When the thread started consuming its current run budget.
+  chrono::steady_clock::time_point budget_start;
+
+  // The task most recently run by this thread, or null if it has not run the
+  // task.
+  scheduler_task* task;
 };
 
 } // namespace detail
@@ -0,0 +1,341 @@
+//
+// detail/slab_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_SLAB_CACHE_HPP
+#define BOOST_ASIO_DETAIL_SLAB_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+#ifndef BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
+# define BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 16
+#endif // BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
+
+#ifndef BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE
+# define BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE 16384
+#endif // BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Count the size classes that double from the given minimum to the maximum.
+constexpr std::size_t slab_class_count(std::size_t min_size,
+    std::size_t max_size)
+{
+  return min_size >= max_size
+    ? 1 : 1 + slab_class_count(min_size * 2, max_size);
+}
+
+// The size classes used to recycle the memory of asynchronous operations.
+// Each class is twice the size of the one before, so that no more than half
+// of a block is wasted. Larger classes are cached less deeply, to bound the
+// memory that each thread can hold on to.
+struct recycling_size_classes
+{
+  enum
+  {
+    min_size = 64,
+    max_size = BOOST_ASIO_RECYCLING_ALLOCATOR_MAX_SIZE,
+    num_classes = slab_class_count(min_size, max_size),
+    cache_size = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
+    cache_bytes_per_class = 65536
+  };
+
+  static std::size_t class_of(std::size_t size)
+  {
+    std::size_t index = 0;
+    for (std::size_t s = min_size; s < size; s <<= 1)
+      ++index;
+    return index;
+  }
+
+  static std::size_t class_size(std::size_t index)
+  {
+    return static_cast<std::size_t>(min_size) << index;
+  }
+
+  static std::size_t cache_depth(std::size_t index)
+  {
+    std::size_t limit = cache_bytes_per_class / class_size(index);
+    limit = limit < 2 ? 2 : limit;
+    std::size_t depth = cache_size;
+    return depth < limit ? depth : limit;
+  }
+
+  static std::size_t depot_depth(std::size_t index)
+  {
+    return 4 * cache_depth(index);
+  }
+};
+
+// A singly linked list of free blocks, threaded through the blocks.
+struct slab_free_list
+{
+  void* head_;
+  std::size_t count_;
+
+  void push(void* p)
+  {
+    *static_cast<void**>(p) = head_;
+    head_ = p;
+    ++count_;
+  }
+
+  void* pop()
+  {
+    void* p = head_;
+    head_ = *static_cast<void**>(p);
+    --count_;
+    return p;
+  }
+};
+
+// The free blocks shared by all threads. Threads move blocks here in batches
+// when their own caches overflow, and take batches from here before falling
+// back to the heap, so that memory freed on one thread can be reused by
+// another.
+template <typename Classes>
+class slab_depot
+  : private noncopyable
+{
+public:
+  // The depot is never destroyed, so that memory can still be freed into it
+  // by objects that are themselves destroyed during static destruction.
+  static slab_depot& instance()
+  {
+    static slab_depot* depot = new slab_depot;
+    return *depot;
+  }
+
+  // Move up to n blocks of the given class into a thread's list.
+  void take(std::size_t index, slab_free_list& list, std::size_t n)
+  {
+    class_list& c = classes_[index];
+    mutex::scoped_lock lock(c.mutex_);
+    while (n-- > 0 && c.list_.count_ > 0)
+      list.push(c.list_.pop());
+  }
+
+  // Move n blocks of the given class out of a thread's list. Blocks that do
+  // not fit in the depot are returned to the heap.
+  void give(std::size_t index, slab_free_list& list, std::size_t n)
+  {
+    class_list& c = classes_[index];
+    {
+      mutex::scoped_lock lock(c.mutex_);
+      std::size_t depth = Classes::depot_depth(index);
+      while (n > 0 && list.count_ > 0 && c.list_.count_ < depth)
+      {
+        c.list_.push(list.pop());
+        --n;
+      }
+    }
+    while (n-- > 0 && list.count_ > 0)
+      aligned_delete(list.pop());
+  }
+
+  // Take a single block of the given class, if one is available.
+  void* pop(std::size_t index)
+  {
+    slab_free_list list = { 0, 0 };
+    take(index, list, 1);
+    return list.head_;
+  }
+
+  // Add a single block of the given class.
+  void push(std::size_t index, void* p)
+  {
+    slab_free_list list = { 0, 0 };
+    list.push(p);
+    give(index, list, 1);
+  }
+
+private:
+  slab_depot()
+  {
+    for (std::size_t i = 0; i < Classes::num_classes; ++i)
+    {
+      classes_[i].list_.head_ = 0;
+      classes_[i].list_.count_ = 0;
+    }
+  }
+
+  struct class_list
+  {
+    mutex mutex_;
+    slab_free_list list_;
+  };
+
+  class_list classes_[Classes::num_classes];
+};
+
+// A snapshot of the counters for the allocations made through slab caches.
+struct slab_cache_statistics
+{
+  // The number of allocations satisfied from a cache or the depot.
+  std::size_t hits;
+
+  // The number of allocations that went to the heap.
+  std::size_t misses;
+
+  // The total number of bytes requested.
+  std::size_t bytes;
+};
+
+// Counters for the allocations made through slab caches. The counters may be
+// updated by several threads at once, and read while they are being updated.
+struct slab_cache_counters
+{
+  std::atomic<std::size_t> hits;
+  std::atomic<std::size_t> misses;
+  std::atomic<std::size_t> bytes;
+
+  void count(bool hit, std::size_t size)
+  {
+    (hit ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+};
+
+// A per-thread cache of free blocks, segregated by size class. Blocks are
+// taken from and returned to the cache without synchronisation, and the
+// cache exchanges batches of blocks with the shared depot when a class runs
+// empty or overflows.
+template <typename Classes>
+class slab_cache
+  : private noncopyable
+{
+public:
+  slab_cache()
+  {
+    for (std::size_t i = 0; i < Classes::num_classes; ++i)
+    {
+      lists_[i].head_ = 0;
+      lists_[i].count_ = 0;
+    }
+  }
+
+  ~slab_cache()
+  {
+    for (std::size_t i = 0; i < Classes::num_classes; ++i)
+    {
+      // The following test is technically redundant, but it avoids locking
+      // the depot for classes that were never used by this thread.
+      if (lists_[i].count_ > 0)
+        depot().give(i, lists_[i], lists_[i].count_);
+    }
+  }
+
+  // Allocate a block of memory. The cache may be null if the calling thread
+  // has none, in which case the block comes from the depot or the heap. If
+  // counters are given, the allocation is counted as a hit when the block
+  // comes from the cache or the depot, and as a miss otherwise.
+  static void* allocate(slab_cache* cache, std::size_t size,
+      std::size_t align, slab_cache_counters* counters = 0)
+  {
+    if (size > Classes::max_size)
+    {
+      if (counters)
+        counters->count(false, size);
+      return aligned_new(align, size);
+    }
+
+    std::size_t index = Classes::class_of(size);
+    if (align <= BOOST_ASIO_DEFAULT_ALIGN)
+    {
+      if (cache)
+      {
+        slab_free_list& list = cache->lists_[index];
+        if (list.count_ == 0)
+          depot().take(index, list, refill_count(index));
+        if (list.count_ > 0)
+        {
+          if (counters)
+            counters->count(true, size);
+          return list.pop();
+        }
+      }
+      else if (void* p = depot().pop(index))
+      {
+        if (counters)
+          counters->count(true, size);
+        return p;
+      }
+    }
+
+    if (counters)
+      counters->count(false, size);
+    return aligned_new(align, Classes::class_size(index));
+  }
+
+  // Deallocate a block of memory that was allocated with the same size.
+  static void deallocate(slab_cache* cache, void* p, std::size_t size)
+  {
+    if (size > Classes::max_size)
+    {
+      aligned_delete(p);
+      return;
+    }
+
+    std::size_t index = Classes::class_of(size);
+    if (cache)
+    {
+      std::size_t depth = Classes::cache_depth(index);
+      slab_free_list& list = cache->lists_[index];
+      if (list.count_ < depth)
+      {
+        list.push(p);
+        return;
+      }
+      if (depth > 0)
+      {
+        depot().give(index, list, refill_count(index));
+        list.push(p);
+        return;
+      }
+    }
+
+    depot().push(index, p);
+  }
+
+private:
+  static slab_depot<Classes>& depot()
+  {
+    return slab_depot<Classes>::instance();
+  }
+
+  // The number of blocks exchanged with the depot at a time.
+  static std::size_t refill_count(std::size_t index)
+  {
+    std::size_t n = Classes::cache_depth(index) / 2;
+    return n > 0 ? n : 1;
+  }
+
+  slab_free_list lists_[Classes::num_classes];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_SLAB_CACHE_HPP
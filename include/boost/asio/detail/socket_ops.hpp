@@ -18,11 +18,20 @@
 #include <boost/asio/detail/config.hpp>
 
 #include <boost/system/error_code.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY) \
+  && defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_DISABLE_MSG_ZEROCOPY)
+# define BOOST_ASIO_HAS_MSG_ZEROCOPY 1
+#endif // defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+       //   && defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_DISABLE_MSG_ZEROCOPY)
+
 namespace boost {
 namespace asio {
 namespace detail {
@@ -53,11 +62,22 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // The user enabled zero-copy sends.
+  zero_copy = 128
 };
 
 typedef unsigned char state_type;
 
+// The minimum number of bytes for which a send on a socket with zero-copy
+// sends enabled avoids copying the data. Smaller sends are copied as usual,
+// since pinning the pages and waiting for the completion notification then
+// costs more than the copy.
+#if !defined(BOOST_ASIO_ZERO_COPY_THRESHOLD)
+# define BOOST_ASIO_ZERO_COPY_THRESHOLD 16384
+#endif // !defined(BOOST_ASIO_ZERO_COPY_THRESHOLD)
+
 struct noop_deleter { void operator()(void*) {} };
 typedef shared_ptr<void> shared_cancel_token_type;
 typedef weak_ptr<void> weak_cancel_token_type;
@@ -219,8 +239,29 @@ BOOST_ASIO_DECL bool non_blocking_recvmsg(socket_type s,
     buf* bufs, size_t count, int in_flags, int& out_flags,
     boost::system::error_code& ec, size_t& bytes_transferred);
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+// Receives up to the specified number of datagrams, each into the message
+// header at the corresponding position. Returns false if the operation would
+// block.
+BOOST_ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    mmsghdr* msgs, size_t count, int flags,
+    boost::system::error_code& ec, size_t& datagrams);
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+
+// Receives a datagram into a caller-prepared message header, including any
+// ancillary data. Returns false if the operation would block.
+BOOST_ASIO_DECL bool non_blocking_recvmsg(socket_type s,
+    msghdr* msg, int flags, boost::system::error_code& ec,
+    size_t& bytes_transferred);
+
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
 BOOST_ASIO_DECL signed_size_type send(socket_type s, const buf* bufs,
     size_t count, int flags, boost::system::error_code& ec);
 
@@ -250,6 +291,25 @@ BOOST_ASIO_DECL bool non_blocking_send1(socket_type s,
     const void* data, size_t size, int flags,
     boost::system::error_code& ec, size_t& bytes_transferred);
 
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+// Reads the socket's error queue until a zero-copy completion notification is
+// found. Returns false if the operation would block.
+BOOST_ASIO_DECL bool non_blocking_recv_zero_copy_notification(
+    socket_type s, boost::system::error_code& ec);
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+// Sends data read from a file, starting at the specified offset, which is
+// advanced past the data sent. Returns false if the operation would block.
+BOOST_ASIO_DECL bool non_blocking_sendfile(socket_type s,
+    int fd, uint64_t& offset, size_t size,
+    boost::system::error_code& ec, size_t& bytes_transferred);
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
 #endif // defined(BOOST_ASIO_HAS_IOCP)
 
 BOOST_ASIO_DECL signed_size_type sendto(socket_type s,
@@ -278,6 +338,27 @@ BOOST_ASIO_DECL bool non_blocking_sendto1(socket_type s, const void* data,
     size_t size, int flags, const void* addr, std::size_t addrlen,
     boost::system::error_code& ec, size_t& bytes_transferred);
 
+#if defined(BOOST_ASIO_HAS_MMSG)
+
+// Sends up to the specified number of datagrams, each described by the message
+// header at the corresponding position. Returns false if the operation would
+// block.
+BOOST_ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    mmsghdr* msgs, size_t count, int flags,
+    boost::system::error_code& ec, size_t& datagrams);
+
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+
+// Sends the data described by a caller-prepared message header, including any
+// ancillary data. Returns false if the operation would block.
+BOOST_ASIO_DECL bool non_blocking_sendmsg(socket_type s,
+    const msghdr* msg, int flags, boost::system::error_code& ec,
+    size_t& bytes_transferred);
+
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
 BOOST_ASIO_DECL socket_type socket(int af, int type, int protocol,
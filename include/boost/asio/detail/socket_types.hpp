@@ -81,6 +81,9 @@
 # if !defined(__SYMBIAN32__)
 #  include <netinet/tcp.h>
 # endif
+# if defined(BOOST_ASIO_HAS_UDP_GSO)
+#  include <netinet/udp.h>
+# endif
 # include <arpa/inet.h>
 # include <netdb.h>
 # include <net/if.h>
@@ -0,0 +1,241 @@
+//
+// detail/stack_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_STACK_POOL_HPP
+#define BOOST_ASIO_DETAIL_STACK_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/throw_exception.hpp>
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <sys/mman.h>
+# include <unistd.h>
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A pool of fixed size stacks for stackful coroutines. Stacks that are
+// returned to the pool are kept for reuse, up to a limit, so that starting a
+// coroutine does not need to map and unmap memory. A stack's memory is first
+// touched by the thread that runs the coroutine, so a pool that is used by a
+// single thread keeps its stacks local to that thread's NUMA node.
+class stack_pool
+  : private noncopyable
+{
+public:
+  // The byte value used to fill unused stack memory when tracking usage.
+  enum { fill_byte = 0xA5 };
+
+  stack_pool(std::size_t stack_size, std::size_t max_pooled,
+      bool guard_page, bool track_usage)
+    : page_size_(page_size()),
+      guard_size_(guard_page && can_protect() ? page_size_ : 0),
+      mapped_size_(round_up(stack_size, page_size_) + guard_size_),
+      max_pooled_(max_pooled),
+      track_usage_(track_usage),
+      free_(0),
+      pooled_(0),
+      high_watermark_(0)
+  {
+  }
+
+  ~stack_pool()
+  {
+    while (free_)
+    {
+      void* top = free_;
+      free_ = next(top);
+      unmap(static_cast<unsigned char*>(top) - mapped_size_);
+    }
+  }
+
+  // Get the size of each stack, including any guard page.
+  std::size_t mapped_size() const
+  {
+    return mapped_size_;
+  }
+
+  // Get the number of stacks held for reuse.
+  std::size_t pooled() const
+  {
+    mutex::scoped_lock lock(mutex_);
+    return pooled_;
+  }
+
+  // Get the greatest number of bytes used by any stack that has been
+  // returned to the pool.
+  std::size_t high_watermark() const
+  {
+    return high_watermark_.load(std::memory_order_relaxed);
+  }
+
+  // Take a stack from the pool, or map a new one. Returns the top of the
+  // stack.
+  void* allocate()
+  {
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (free_)
+      {
+        void* top = free_;
+        free_ = next(top);
+        --pooled_;
+        return top;
+      }
+    }
+
+    unsigned char* base = static_cast<unsigned char*>(map());
+    if (track_usage_)
+      std::memset(base + guard_size_, fill_byte, mapped_size_ - guard_size_);
+    return base + mapped_size_;
+  }
+
+  // Return a stack to the pool, given its top.
+  void deallocate(void* top)
+  {
+    if (track_usage_)
+      record_usage(static_cast<unsigned char*>(top));
+
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (pooled_ < max_pooled_)
+      {
+        next(top) = free_;
+        free_ = top;
+        ++pooled_;
+        return;
+      }
+    }
+
+    unmap(static_cast<unsigned char*>(top) - mapped_size_);
+  }
+
+private:
+  // Stacks in the pool are linked through the last word below their top.
+  static void*& next(void* top)
+  {
+    return static_cast<void**>(top)[-1];
+  }
+
+  static std::size_t round_up(std::size_t n, std::size_t page)
+  {
+    return (n + page - 1) / page * page;
+  }
+
+  static std::size_t page_size()
+  {
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    long result = ::sysconf(_SC_PAGESIZE);
+    return result > 0 ? static_cast<std::size_t>(result) : 4096;
+#else // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    return 4096;
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  }
+
+  static bool can_protect()
+  {
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    return true;
+#else // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    return false;
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  }
+
+  void* map()
+  {
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+# if defined(MAP_ANONYMOUS)
+    void* base = ::mmap(0, mapped_size_, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+# else // defined(MAP_ANONYMOUS)
+    void* base = ::mmap(0, mapped_size_, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANON, -1, 0);
+# endif // defined(MAP_ANONYMOUS)
+    if (base == MAP_FAILED)
+    {
+      std::bad_alloc ex;
+      boost::asio::detail::throw_exception(ex);
+    }
+    if (guard_size_ > 0 && ::mprotect(base, guard_size_, PROT_NONE) != 0)
+    {
+      ::munmap(base, mapped_size_);
+      std::bad_alloc ex;
+      boost::asio::detail::throw_exception(ex);
+    }
+    return base;
+#else // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    return aligned_new(page_size_, mapped_size_);
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  }
+
+  void unmap(void* base)
+  {
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    ::munmap(base, mapped_size_);
+#else // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    aligned_delete(base);
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  }
+
+  // Find the deepest point that the stack has ever reached, by looking for
+  // the lowest byte that no longer holds the fill value.
+  void record_usage(unsigned char* top)
+  {
+    unsigned char* p = top - mapped_size_ + guard_size_;
+    while (p < top && *p == fill_byte)
+      ++p;
+
+    std::size_t used = static_cast<std::size_t>(top - p);
+    std::size_t current = high_watermark_.load(std::memory_order_relaxed);
+    while (used > current && !high_watermark_.compare_exchange_weak(
+          current, used, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  const std::size_t page_size_;
+  const std::size_t guard_size_;
+  const std::size_t mapped_size_;
+  const std::size_t max_pooled_;
+  const bool track_usage_;
+
+  // Protects the list of pooled stacks.
+  mutable mutex mutex_;
+
+  // The tops of the pooled stacks.
+  void* free_;
+  std::size_t pooled_;
+
+  // The greatest stack usage seen, in bytes.
+  std::atomic<std::size_t> high_watermark_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_STACK_POOL_HPP
@@ -16,19 +16,26 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
-#include <boost/asio/detail/atomic_count.hpp>
+#include <atomic>
 #include <boost/asio/detail/executor_op.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/scheduler_operation.hpp>
-#include <boost/asio/detail/scoped_ptr.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 #include <boost/asio/execution.hpp>
 #include <boost/asio/execution_context.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
+#if !defined(BOOST_ASIO_STRAND_QUANTUM_HANDLERS)
+# define BOOST_ASIO_STRAND_QUANTUM_HANDLERS 0
+#endif // !defined(BOOST_ASIO_STRAND_QUANTUM_HANDLERS)
+
+#if !defined(BOOST_ASIO_STRAND_QUANTUM_USEC)
+# define BOOST_ASIO_STRAND_QUANTUM_USEC 0
+#endif // !defined(BOOST_ASIO_STRAND_QUANTUM_USEC)
+
 namespace boost {
 namespace asio {
 namespace detail {
@@ -47,28 +54,42 @@ public:
   private:
     friend class strand_executor_service;
 
-    // Mutex to protect access to internal data.
-    mutex* mutex_;
+    // The handlers that are waiting on the strand but should not be run until
+    // after the next time the strand is scheduled. This is a lock-free stack,
+    // in reverse order of submission, to which any thread may push.
+    std::atomic<scheduler_operation*> waiting_stack_;
 
-    // Indicates whether the strand is currently "locked" by a handler. This
-    // means that there is a handler upcall in progress, or that the strand
-    // itself has been scheduled in order to invoke some pending handlers.
-    bool locked_;
+    // The number of handlers that have been added to the strand but have not
+    // yet been run. The handler that raises this count from zero acquires the
+    // strand's "lock", and is responsible for scheduling the strand. The
+    // count may briefly fall below zero, when the strand runs a handler whose
+    // submitter has yet to count it.
+    std::atomic<long> pending_;
 
     // Indicates that the strand has been shut down and will accept no further
     // handlers.
-    bool shutdown_;
-
-    // The handlers that are waiting on the strand but should not be run until
-    // after the next time the strand is scheduled. This queue must only be
-    // modified while the mutex is locked.
-    op_queue<scheduler_operation> waiting_queue_;
+    std::atomic<bool> shutdown_;
 
     // The handlers that are ready to be run. Logically speaking, these are the
     // handlers that hold the strand's lock. The ready queue is only modified
-    // from within the strand and so may be accessed without locking the mutex.
+    // from within the strand and so may be accessed without synchronisation.
     op_queue<scheduler_operation> ready_queue_;
 
+    // The number of handlers run since the strand was last scheduled. This is
+    // only modified from within the strand.
+    long completed_;
+
+    // The maximum number of handlers, and the maximum time, for which the
+    // strand may keep running handlers each time it is scheduled. When both
+    // are zero, the strand runs only the handlers that were waiting when it
+    // was scheduled.
+    std::atomic<std::size_t> quantum_handlers_;
+    std::atomic<long> quantum_usec_;
+
+    // The number of times the strand has had to schedule itself again through
+    // the underlying executor to run more handlers.
+    std::atomic<std::size_t> handoffs_;
+
     // Pointers to adjacent handle implementations in linked list.
     strand_impl* next_;
     strand_impl* prev_;
@@ -123,6 +144,19 @@ public:
   BOOST_ASIO_DECL static bool running_in_this_thread(
       const implementation_type& impl);
 
+  // Set the limits on the handlers run each time the strand is scheduled.
+  BOOST_ASIO_DECL static void set_quantum(const implementation_type& impl,
+      std::size_t max_handlers, long max_usec);
+
+  // Get the number of handlers that have been added to the strand and have
+  // not yet been accounted for as run.
+  BOOST_ASIO_DECL static std::size_t queue_depth(
+      const implementation_type& impl);
+
+  // Get the number of times the strand has scheduled itself again.
+  BOOST_ASIO_DECL static std::size_t handoff_count(
+      const implementation_type& impl);
+
 private:
   friend class strand_impl;
   template <typename F, typename Allocator> class allocator_binder;
@@ -132,9 +166,15 @@ private:
   BOOST_ASIO_DECL static bool enqueue(const implementation_type& impl,
       scheduler_operation* op);
 
-  // Transfers waiting handlers to the ready queue. Returns true if one or more
-  // handlers were transferred.
-  BOOST_ASIO_DECL static bool push_waiting_to_ready(implementation_type& impl);
+  // Accounts for the handlers that have been run. Returns true if more
+  // handlers are waiting, in which case the strand keeps the lock and must be
+  // scheduled again.
+  BOOST_ASIO_DECL static bool release_ready_handlers(
+      implementation_type& impl);
+
+  // Transfers waiting handlers, in order of submission, to the back of the
+  // ready queue.
+  BOOST_ASIO_DECL static void take_waiting(strand_impl& impl);
 
   // Invokes all ready-to-run handlers.
   BOOST_ASIO_DECL static void run_ready_handlers(implementation_type& impl);
@@ -147,16 +187,6 @@ private:
   // Mutex to protect access to the service-wide state.
   mutex mutex_;
 
-  // Number of mutexes shared between all strand objects.
-  enum { num_mutexes = 193 };
-
-  // Pool of mutexes.
-  scoped_ptr<mutex> mutexes_[num_mutexes];
-
-  // Extra value used when hashing to prevent recycled memory locations from
-  // getting the same mutex.
-  std::size_t salt_;
-
   // The head of a linked list of all implementations.
   strand_impl* impl_list_;
 };
@@ -16,10 +16,11 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
-#include <climits>
 #include <cstddef>
+#include <boost/asio/detail/awaitable_frame_pool.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/slab_cache.hpp>
 
 #if !defined(BOOST_ASIO_NO_EXCEPTIONS)
 # include <exception>
@@ -32,85 +33,24 @@ namespace boost {
 namespace asio {
 namespace detail {
 
-#ifndef BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
-# define BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE 2
-#endif // BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE
-
 class thread_info_base
   : private noncopyable
 {
 public:
-  struct default_tag
-  {
-    enum
-    {
-      cache_size = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = 0,
-      end_mem_index = cache_size
-    };
-  };
-
-  struct awaitable_frame_tag
-  {
-    enum
-    {
-      cache_size = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = default_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
-
-  struct executor_function_tag
-  {
-    enum
-    {
-      cache_size = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = awaitable_frame_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
-
-  struct cancellation_signal_tag
-  {
-    enum
-    {
-      cache_size = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = executor_function_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
-
-  struct parallel_group_tag
-  {
-    enum
-    {
-      cache_size = BOOST_ASIO_RECYCLING_ALLOCATOR_CACHE_SIZE,
-      begin_mem_index = cancellation_signal_tag::end_mem_index,
-      end_mem_index = begin_mem_index + cache_size
-    };
-  };
-
-  enum { max_mem_index = parallel_group_tag::end_mem_index };
+  // The purposes for which memory is recycled. Coroutine frames are pooled
+  // separately, and all other purposes share the same size classes.
+  struct default_tag {};
+  struct awaitable_frame_tag {};
+  struct executor_function_tag {};
+  struct cancellation_signal_tag {};
+  struct parallel_group_tag {};
 
   thread_info_base()
+    : frame_counters_(0)
 #if !defined(BOOST_ASIO_NO_EXCEPTIONS)
-    : has_pending_exception_(0)
+    , has_pending_exception_(0)
 #endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
   {
-    for (int i = 0; i < max_mem_index; ++i)
-      reusable_memory_[i] = 0;
-  }
-
-  ~thread_info_base()
-  {
-    for (int i = 0; i < max_mem_index; ++i)
-    {
-      // The following test for non-null pointers is technically redundant, but
-      // it is significantly faster when using a tight io_context::poll() loop
-      // in latency sensitive applications.
-      if (reusable_memory_[i])
-        aligned_delete(reusable_memory_[i]);
-    }
   }
 
   static void* allocate(thread_info_base* this_thread,
@@ -129,69 +69,38 @@ public:
   static void* allocate(Purpose, thread_info_base* this_thread,
       std::size_t size, std::size_t align = BOOST_ASIO_DEFAULT_ALIGN)
   {
-    std::size_t chunks = (size + chunk_size - 1) / chunk_size;
-
-    if (this_thread)
-    {
-      for (int mem_index = Purpose::begin_mem_index;
-          mem_index < Purpose::end_mem_index; ++mem_index)
-      {
-        if (this_thread->reusable_memory_[mem_index])
-        {
-          void* const pointer = this_thread->reusable_memory_[mem_index];
-          unsigned char* const mem = static_cast<unsigned char*>(pointer);
-          if (static_cast<std::size_t>(mem[0]) >= chunks
-              && reinterpret_cast<std::size_t>(pointer) % align == 0)
-          {
-            this_thread->reusable_memory_[mem_index] = 0;
-            mem[size] = mem[0];
-            return pointer;
-          }
-        }
-      }
-
-      for (int mem_index = Purpose::begin_mem_index;
-          mem_index < Purpose::end_mem_index; ++mem_index)
-      {
-        if (this_thread->reusable_memory_[mem_index])
-        {
-          void* const pointer = this_thread->reusable_memory_[mem_index];
-          this_thread->reusable_memory_[mem_index] = 0;
-          aligned_delete(pointer);
-          break;
-        }
-      }
-    }
-
-    void* const pointer = aligned_new(align, chunks * chunk_size + 1);
-    unsigned char* const mem = static_cast<unsigned char*>(pointer);
-    mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
-    return pointer;
+    return memory_cache::allocate(
+        this_thread ? &this_thread->memory_cache_ : 0, size, align);
   }
 
   template <typename Purpose>
   static void deallocate(Purpose, thread_info_base* this_thread,
       void* pointer, std::size_t size)
   {
-    if (size <= chunk_size * UCHAR_MAX)
+    memory_cache::deallocate(
+        this_thread ? &this_thread->memory_cache_ : 0, pointer, size);
+  }
+
+  static void* allocate(awaitable_frame_tag, thread_info_base* this_thread,
+      std::size_t size, std::size_t align = BOOST_ASIO_DEFAULT_ALIGN)
+  {
+    if (!this_thread)
     {
-      if (this_thread)
-      {
-        for (int mem_index = Purpose::begin_mem_index;
-            mem_index < Purpose::end_mem_index; ++mem_index)
-        {
-          if (this_thread->reusable_memory_[mem_index] == 0)
-          {
-            unsigned char* const mem = static_cast<unsigned char*>(pointer);
-            mem[0] = mem[size];
-            this_thread->reusable_memory_[mem_index] = pointer;
-            return;
-          }
-        }
-      }
+      return awaitable_frame_pool::allocate(0, size, align,
+          &awaitable_frame_counters::shared_shard());
     }
 
-    aligned_delete(pointer);
+    if (!this_thread->frame_counters_)
+      this_thread->frame_counters_ = &awaitable_frame_counters::next_shard();
+    return awaitable_frame_pool::allocate(&this_thread->frame_pool_,
+        size, align, this_thread->frame_counters_);
+  }
+
+  static void deallocate(awaitable_frame_tag, thread_info_base* this_thread,
+      void* pointer, std::size_t size)
+  {
+    awaitable_frame_pool::deallocate(
+        this_thread ? &this_thread->frame_pool_ : 0, pointer, size);
   }
 
   void capture_current_exception()
@@ -230,12 +139,10 @@ public:
   }
 
 private:
-#if defined(BOOST_ASIO_HAS_IO_URING)
-  enum { chunk_size = 8 };
-#else // defined(BOOST_ASIO_HAS_IO_URING)
-  enum { chunk_size = 4 };
-#endif // defined(BOOST_ASIO_HAS_IO_URING)
-  void* reusable_memory_[max_mem_index];
+  typedef slab_cache<recycling_size_classes> memory_cache;
+  memory_cache memory_cache_;
+  awaitable_frame_pool frame_pool_;
+  slab_cache_counters* frame_counters_;
 
 #if !defined(BOOST_ASIO_NO_EXCEPTIONS)
   int has_pending_exception_;
@@ -23,6 +23,7 @@
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/timer_wheel_queue.hpp>
 #include <boost/asio/detail/wait_op.hpp>
 #include <boost/asio/error.hpp>
 
@@ -32,7 +33,7 @@ namespace boost {
 namespace asio {
 namespace detail {
 
-template <typename Time_Traits>
+template <typename Time_Traits, bool>
 class timer_queue
   : public timer_queue_base
 {
@@ -49,7 +50,7 @@ public:
   public:
     per_timer_data() :
       heap_index_((std::numeric_limits<std::size_t>::max)()),
-      next_(0), prev_(0)
+      deferred_(false), next_(0), prev_(0)
     {
     }
 
@@ -62,6 +63,11 @@ public:
     // The index of the timer in the heap.
     std::size_t heap_index_;
 
+    // Whether the timer's expiry has been moved later than the time held in
+    // its heap entry, and the time it has been moved to.
+    bool deferred_;
+    time_type deferred_time_;
+
     // Pointers to adjacent timers in a linked list.
     per_timer_data* next_;
     per_timer_data* prev_;
@@ -82,6 +88,7 @@ public:
     // Enqueue the timer object.
     if (timer.prev_ == 0 && &timer != timers_)
     {
+      timer.deferred_ = false;
       if (this->is_positive_infinity(time))
       {
         // No heap entry is required for timers that never expire.
@@ -151,6 +158,19 @@ public:
       while (!heap_.empty() && !Time_Traits::less_than(now, heap_[0].time_))
       {
         per_timer_data* timer = heap_[0].timer_;
+        if (timer->deferred_)
+        {
+          // The expiry was moved later while the timer was queued. Now that
+          // the old expiry has been reached, put the timer back into the heap
+          // at its new position rather than completing its operations.
+          timer->deferred_ = false;
+          if (Time_Traits::less_than(now, timer->deferred_time_))
+          {
+            heap_[0].time_ = timer->deferred_time_;
+            down_heap(0);
+            continue;
+          }
+        }
         while (wait_op* op = timer->op_queue_.front())
         {
           timer->op_queue_.pop();
@@ -170,6 +190,7 @@ public:
       per_timer_data* timer = timers_;
       timers_ = timers_->next_;
       ops.push(timer->op_queue_);
+      timer->deferred_ = false;
       timer->next_ = 0;
       timer->prev_ = 0;
     }
@@ -222,6 +243,45 @@ public:
     }
   }
 
+  // Change the expiry time of a timer without cancelling its operations.
+  // Returns true if the timer has become the earliest in the queue, in which
+  // case the reactor's event demultiplexing function call may need to be
+  // interrupted and restarted.
+  bool reschedule_timer(const time_type& time, per_timer_data& timer)
+  {
+    if (timer.prev_ == 0 && &timer != timers_)
+      return false;
+
+    std::size_t index = timer.heap_index_;
+    if (index >= heap_.size())
+    {
+      // A timer that was never going to expire has no heap entry yet.
+      if (this->is_positive_infinity(time))
+        return false;
+      timer.heap_index_ = heap_.size();
+      heap_entry entry = { time, &timer };
+      heap_.push_back(entry);
+      up_heap(heap_.size() - 1);
+      return timer.heap_index_ == 0;
+    }
+
+    if (Time_Traits::less_than(time, heap_[index].time_))
+    {
+      // An earlier expiry must take effect in the heap straight away.
+      timer.deferred_ = false;
+      heap_[index].time_ = time;
+      up_heap(index);
+      return timer.heap_index_ == 0;
+    }
+
+    // A later expiry is only recorded, leaving the heap untouched. The timer
+    // is moved when its old expiry is reached, so that a timer pushed back
+    // repeatedly costs one heap update per expiry rather than one per change.
+    timer.deferred_ = Time_Traits::less_than(heap_[index].time_, time);
+    timer.deferred_time_ = time;
+    return false;
+  }
+
   // Move operations from one timer to another, empty timer.
   void move_timer(per_timer_data& target, per_timer_data& source)
   {
@@ -230,6 +290,10 @@ public:
     target.heap_index_ = source.heap_index_;
     source.heap_index_ = (std::numeric_limits<std::size_t>::max)();
 
+    target.deferred_ = source.deferred_;
+    target.deferred_time_ = source.deferred_time_;
+    source.deferred_ = false;
+
     if (target.heap_index_ < heap_.size())
       heap_[target.heap_index_].timer_ = &target;
 
@@ -291,6 +355,7 @@ private:
   void remove_timer(per_timer_data& timer)
   {
     // Remove the timer from the heap.
+    timer.deferred_ = false;
     std::size_t index = timer.heap_index_;
     if (!heap_.empty() && index < heap_.size())
     {
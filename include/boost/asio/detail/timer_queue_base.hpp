@@ -19,6 +19,7 @@
 #include <boost/asio/detail/noncopyable.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/operation.hpp>
+#include <boost/asio/detail/type_traits.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -58,7 +59,24 @@ private:
   timer_queue_base* next_;
 };
 
+// The tick, in microseconds, of the timing wheel that holds timers with the
+// given traits, or zero if those timers are kept in a heap.
+template <typename Time_Traits, typename = void>
+struct timer_wheel_tick
+  : integral_constant<long, 0>
+{
+};
+
 template <typename Time_Traits>
+struct timer_wheel_tick<Time_Traits,
+    void_t<decltype(Time_Traits::wait_traits_type::timer_wheel_tick_usec)>>
+  : integral_constant<long,
+      Time_Traits::wait_traits_type::timer_wheel_tick_usec>
+{
+};
+
+template <typename Time_Traits,
+    bool = (timer_wheel_tick<Time_Traits>::value > 0)>
 class timer_queue;
 
 } // namespace detail
@@ -82,6 +82,10 @@ public:
   BOOST_ASIO_DECL void cancel_timer_by_key(per_timer_data* timer,
       op_queue<operation>& ops, void* cancellation_key);
 
+  // Change the expiry time of a timer without cancelling its operations.
+  BOOST_ASIO_DECL bool reschedule_timer(const time_type& time,
+      per_timer_data& timer);
+
   // Move operations from one timer to another, empty timer.
   BOOST_ASIO_DECL void move_timer(per_timer_data& target,
       per_timer_data& source);
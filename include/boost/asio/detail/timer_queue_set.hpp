@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/timer_queue_base.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -45,6 +46,19 @@ public:
   // Get the wait duration in microseconds.
   BOOST_ASIO_DECL long wait_duration_usec(long max_duration) const;
 
+  // Set the slack, in microseconds, by which the wakeup for the earliest timer
+  // may be deferred so that timers expiring close together are handled in a
+  // single batch. The wait durations include the slack.
+  BOOST_ASIO_DECL void set_slack(long usec);
+
+  // Get the wait duration in microseconds for a wakeup that is to be scheduled
+  // with the kernel, and remember when that wakeup will occur.
+  BOOST_ASIO_DECL long wakeup_duration_usec(long max_duration);
+
+  // Determine whether the last scheduled wakeup is still pending and lies
+  // within the slack of the earliest timer, so that it need not be moved.
+  BOOST_ASIO_DECL bool wakeup_within_slack() const;
+
   // Dequeue all ready timers.
   BOOST_ASIO_DECL void get_ready_timers(op_queue<operation>& ops);
 
@@ -52,7 +66,20 @@ public:
   BOOST_ASIO_DECL void get_all_timers(op_queue<operation>& ops);
 
 private:
+  // Add the slack to a wait duration, without exceeding the maximum.
+  BOOST_ASIO_DECL static long add_slack(
+      long duration, long slack, long max_duration);
+
+  // Get the current time, in microseconds of the steady clock.
+  BOOST_ASIO_DECL static int64_t now_usec();
+
   timer_queue_base* first_;
+
+  // The slack by which timer wakeups may be deferred.
+  long slack_usec_;
+
+  // The time of the last scheduled wakeup, if slack is in use.
+  int64_t wakeup_usec_;
 };
 
 } // namespace detail
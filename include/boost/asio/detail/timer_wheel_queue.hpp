@@ -0,0 +1,543 @@
+//
+// detail/timer_wheel_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TIMER_WHEEL_QUEUE_HPP
+#define BOOST_ASIO_DETAIL_TIMER_WHEEL_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/detail/chrono.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/limits.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/wait_op.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A timer queue that hashes timers into a hierarchical timing wheel. Each
+// level of the wheel has 64 slots, and each slot of a level spans all 64 slots
+// of the level below. Timers are placed at the lowest level whose span reaches
+// their expiry tick and are moved down a level when the wheel turns to their
+// slot, so adding, removing and re-arming a timer take constant time.
+template <typename Time_Traits>
+class timer_queue<Time_Traits, true>
+  : public timer_queue_base
+{
+public:
+  // The time type.
+  typedef typename Time_Traits::time_type time_type;
+
+  // The duration type.
+  typedef typename Time_Traits::duration_type duration_type;
+
+  // Per-timer data.
+  class per_timer_data
+  {
+  public:
+    per_timer_data() :
+      slot_index_((std::numeric_limits<std::size_t>::max)()),
+      tick_(0), next_(0), prev_(0), slot_next_(0), slot_prev_(0)
+    {
+    }
+
+  private:
+    friend class timer_queue;
+
+    // The operations waiting on the timer.
+    op_queue<wait_op> op_queue_;
+
+    // The index of the wheel slot that holds the timer.
+    std::size_t slot_index_;
+
+    // The tick at which the timer expires.
+    uint64_t tick_;
+
+    // Pointers to adjacent timers in a linked list.
+    per_timer_data* next_;
+    per_timer_data* prev_;
+
+    // Pointers to adjacent timers in the same wheel slot.
+    per_timer_data* slot_next_;
+    per_timer_data* slot_prev_;
+  };
+
+  // Constructor.
+  timer_queue()
+    : origin_(Time_Traits::now()),
+      tick_(chrono::duration_cast<duration_type>(
+            chrono::microseconds(timer_wheel_tick<Time_Traits>::value))),
+      current_tick_(0),
+      timers_(0)
+  {
+    if (tick_ <= duration_type::zero())
+      tick_ = duration_type(1);
+    for (std::size_t i = 0; i < num_levels; ++i)
+      occupied_[i] = 0;
+    for (std::size_t i = 0; i < num_levels * num_slots; ++i)
+      slots_[i] = 0;
+  }
+
+  // Add a new timer to the queue. Returns true if this is the timer that is
+  // earliest in the queue, in which case the reactor's event demultiplexing
+  // function call may need to be interrupted and restarted.
+  bool enqueue_timer(const time_type& time, per_timer_data& timer, wait_op* op)
+  {
+    // Enqueue the timer object.
+    bool earliest = false;
+    if (timer.prev_ == 0 && &timer != timers_)
+    {
+      // Put the new timer into the slot for its expiry tick.
+      timer.tick_ = expiry_tick(time);
+      earliest = timer.tick_ < next_tick();
+      link_slot(timer);
+
+      // Insert the new timer into the linked list of active timers.
+      timer.next_ = timers_;
+      timer.prev_ = 0;
+      if (timers_)
+        timers_->prev_ = &timer;
+      timers_ = &timer;
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if newly added timer is first to expire.
+    return earliest;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    return timers_ == 0;
+  }
+
+  // Get the time until the wheel reaches the earliest occupied slot.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    uint64_t tick = next_tick();
+    if (tick == no_tick)
+      return max_duration;
+
+    return this->to_msec(
+        Time_Traits::to_posix_duration(
+          Time_Traits::subtract(tick_time(tick), Time_Traits::now())),
+        max_duration);
+  }
+
+  // Get the time until the wheel reaches the earliest occupied slot.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    uint64_t tick = next_tick();
+    if (tick == no_tick)
+      return max_duration;
+
+    return this->to_usec(
+        Time_Traits::to_posix_duration(
+          Time_Traits::subtract(tick_time(tick), Time_Traits::now())),
+        max_duration);
+  }
+
+  // Dequeue all timers whose expiry tick has been reached.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    if (timers_)
+      advance(elapsed_tick(Time_Traits::now()), ops);
+  }
+
+  // Dequeue all timers.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    while (timers_)
+    {
+      per_timer_data* timer = timers_;
+      timers_ = timers_->next_;
+      ops.push(timer->op_queue_);
+      timer->slot_index_ = (std::numeric_limits<std::size_t>::max)();
+      timer->next_ = 0;
+      timer->prev_ = 0;
+      timer->slot_next_ = 0;
+      timer->slot_prev_ = 0;
+    }
+
+    for (std::size_t i = 0; i < num_levels; ++i)
+      occupied_[i] = 0;
+    for (std::size_t i = 0; i < num_levels * num_slots; ++i)
+      slots_[i] = 0;
+  }
+
+  // Cancel and dequeue operations for the given timer.
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.prev_ != 0 || &timer == timers_)
+    {
+      while (wait_op* op = (num_cancelled != max_cancelled)
+          ? timer.op_queue_.front() : 0)
+      {
+        op->ec_ = boost::asio::error::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty())
+        remove_timer(timer);
+    }
+    return num_cancelled;
+  }
+
+  // Cancel and dequeue a specific operation for the given timer.
+  void cancel_timer_by_key(per_timer_data* timer,
+      op_queue<operation>& ops, void* cancellation_key)
+  {
+    if (timer->prev_ != 0 || timer == timers_)
+    {
+      op_queue<wait_op> other_ops;
+      while (wait_op* op = timer->op_queue_.front())
+      {
+        timer->op_queue_.pop();
+        if (op->cancellation_key_ == cancellation_key)
+        {
+          op->ec_ = boost::asio::error::operation_aborted;
+          ops.push(op);
+        }
+        else
+          other_ops.push(op);
+      }
+      timer->op_queue_.push(other_ops);
+      if (timer->op_queue_.empty())
+        remove_timer(*timer);
+    }
+  }
+
+  // Change the expiry time of a timer without cancelling its operations.
+  // Returns true if the timer has become the earliest in the queue, in which
+  // case the reactor's event demultiplexing function call may need to be
+  // interrupted and restarted.
+  bool reschedule_timer(const time_type& time, per_timer_data& timer)
+  {
+    if (timer.prev_ == 0 && &timer != timers_)
+      return false;
+
+    uint64_t tick = expiry_tick(time);
+    if (tick == timer.tick_)
+      return false;
+
+    unlink_slot(timer);
+    timer.tick_ = tick;
+    bool earliest = tick < next_tick();
+    link_slot(timer);
+    return earliest;
+  }
+
+  // Move operations from one timer to another, empty timer.
+  void move_timer(per_timer_data& target, per_timer_data& source)
+  {
+    target.op_queue_.push(source.op_queue_);
+
+    target.tick_ = source.tick_;
+    target.slot_index_ = source.slot_index_;
+    source.slot_index_ = (std::numeric_limits<std::size_t>::max)();
+
+    if (target.slot_index_ < num_levels * num_slots)
+    {
+      if (slots_[target.slot_index_] == &source)
+        slots_[target.slot_index_] = &target;
+      if (source.slot_prev_)
+        source.slot_prev_->slot_next_ = &target;
+      if (source.slot_next_)
+        source.slot_next_->slot_prev_ = &target;
+    }
+    target.slot_next_ = source.slot_next_;
+    target.slot_prev_ = source.slot_prev_;
+    source.slot_next_ = 0;
+    source.slot_prev_ = 0;
+
+    if (timers_ == &source)
+      timers_ = &target;
+    if (source.prev_)
+      source.prev_->next_ = &target;
+    if (source.next_)
+      source.next_->prev_= &target;
+    target.next_ = source.next_;
+    target.prev_ = source.prev_;
+    source.next_ = 0;
+    source.prev_ = 0;
+  }
+
+private:
+  // The shape of the wheel. With 64-bit ticks, eleven levels of 64 slots are
+  // enough to hold any expiry time.
+  enum
+  {
+    slot_bits = 6,
+    num_slots = 1 << slot_bits,
+    num_levels = 11
+  };
+
+  // The tick value used to indicate that the wheel is empty.
+  static const uint64_t no_tick = ~static_cast<uint64_t>(0);
+
+  // Get the first tick at or after the given time.
+  uint64_t expiry_tick(const time_type& time) const
+  {
+    int64_t d = Time_Traits::subtract(time, origin_).count();
+    if (d <= 0)
+      return 0;
+    int64_t n = tick_.count();
+    return static_cast<uint64_t>(d / n) + (d % n != 0 ? 1 : 0);
+  }
+
+  // Get the last tick at or before the given time.
+  uint64_t elapsed_tick(const time_type& time) const
+  {
+    int64_t d = Time_Traits::subtract(time, origin_).count();
+    if (d <= 0)
+      return 0;
+    return static_cast<uint64_t>(d / tick_.count());
+  }
+
+  // Get the time at which the given tick begins.
+  time_type tick_time(uint64_t tick) const
+  {
+    uint64_t limit = static_cast<uint64_t>(
+        (duration_type::max)().count() / tick_.count());
+    if (tick > limit)
+      return Time_Traits::add(origin_, (duration_type::max)());
+    return Time_Traits::add(origin_,
+        tick_ * static_cast<typename duration_type::rep>(tick));
+  }
+
+  // Get the index of the lowest set bit in a non-zero slot mask.
+  static std::size_t lowest_slot(uint64_t mask)
+  {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(mask));
+#else // defined(__GNUC__)
+    std::size_t slot = 0;
+    while ((mask & 1) == 0)
+    {
+      mask >>= 1;
+      ++slot;
+    }
+    return slot;
+#endif // defined(__GNUC__)
+  }
+
+  // Get the slot of the given level that the given tick falls into.
+  static std::size_t slot_of(uint64_t tick, std::size_t level)
+  {
+    return static_cast<std::size_t>(
+        (tick >> (slot_bits * level)) & (num_slots - 1));
+  }
+
+  // Get the first tick of the earliest occupied slot, or no_tick if the wheel
+  // is empty. The timers in that slot may expire later than this tick if the
+  // slot is not on the lowest level.
+  uint64_t next_tick() const
+  {
+    for (std::size_t level = 0; level < num_levels; ++level)
+    {
+      uint64_t mask = occupied_[level]
+        & (~static_cast<uint64_t>(0) << slot_of(current_tick_, level));
+      if (mask)
+      {
+        std::size_t shift = slot_bits * level;
+        uint64_t tick = static_cast<uint64_t>(lowest_slot(mask)) << shift;
+        if (level + 1 < num_levels)
+          tick |= (current_tick_ >> (shift + slot_bits)) << (shift + slot_bits);
+        return tick < current_tick_ ? current_tick_ : tick;
+      }
+    }
+    return no_tick;
+  }
+
+  // Turn the wheel to the given tick, dequeuing the timers that expire on the
+  // way. Empty stretches of the wheel are skipped without visiting each tick.
+  void advance(uint64_t tick, op_queue<operation>& ops)
+  {
+    if (tick < current_tick_)
+      return;
+
+    for (;;)
+    {
+      // Dequeue the timers that expire at the current tick.
+      std::size_t index = slot_of(current_tick_, 0);
+      while (per_timer_data* timer = slots_[index])
+      {
+        while (wait_op* op = timer->op_queue_.front())
+        {
+          timer->op_queue_.pop();
+          op->ec_ = boost::system::error_code();
+          ops.push(op);
+        }
+        remove_timer(*timer);
+      }
+
+      // Move to the next occupied slot, if it is not beyond the target.
+      uint64_t next = next_tick();
+      if (next > tick)
+      {
+        current_tick_ = tick;
+        return;
+      }
+      current_tick_ = next;
+
+      // Move the timers in any higher level slots that begin at the new tick
+      // down to the levels below.
+      for (std::size_t level = num_levels - 1; level > 0; --level)
+      {
+        uint64_t low_bits = current_tick_
+          & ((static_cast<uint64_t>(1) << (slot_bits * level)) - 1);
+        if (low_bits == 0)
+        {
+          index = level * num_slots + slot_of(current_tick_, level);
+          per_timer_data* timer = slots_[index];
+          slots_[index] = 0;
+          occupied_[level] &= ~(static_cast<uint64_t>(1)
+              << slot_of(current_tick_, level));
+          while (timer)
+          {
+            per_timer_data* next_timer = timer->slot_next_;
+            link_slot(*timer);
+            timer = next_timer;
+          }
+        }
+      }
+    }
+  }
+
+  // Put a timer into the slot for its expiry tick, relative to the current
+  // position of the wheel. Timers that are already due go into the current
+  // slot of the lowest level.
+  void link_slot(per_timer_data& timer)
+  {
+    std::size_t level = 0;
+    std::size_t slot = slot_of(current_tick_, 0);
+    if (timer.tick_ > current_tick_)
+    {
+      uint64_t diff = timer.tick_ ^ current_tick_;
+      while (level + 1 < num_levels
+          && (diff >> (slot_bits * (level + 1))) != 0)
+        ++level;
+      slot = slot_of(timer.tick_, level);
+    }
+
+    std::size_t index = level * num_slots + slot;
+    timer.slot_index_ = index;
+    timer.slot_prev_ = 0;
+    timer.slot_next_ = slots_[index];
+    if (slots_[index])
+      slots_[index]->slot_prev_ = &timer;
+    slots_[index] = &timer;
+    occupied_[level] |= static_cast<uint64_t>(1) << slot;
+  }
+
+  // Remove a timer from its wheel slot.
+  void unlink_slot(per_timer_data& timer)
+  {
+    std::size_t index = timer.slot_index_;
+    if (slots_[index] == &timer)
+      slots_[index] = timer.slot_next_;
+    if (timer.slot_prev_)
+      timer.slot_prev_->slot_next_ = timer.slot_next_;
+    if (timer.slot_next_)
+      timer.slot_next_->slot_prev_ = timer.slot_prev_;
+    if (slots_[index] == 0)
+      occupied_[index / num_slots] &= ~(static_cast<uint64_t>(1)
+          << (index % num_slots));
+    timer.slot_index_ = (std::numeric_limits<std::size_t>::max)();
+    timer.slot_next_ = 0;
+    timer.slot_prev_ = 0;
+  }
+
+  // Remove a timer from the wheel and list of timers.
+  void remove_timer(per_timer_data& timer)
+  {
+    // Remove the timer from the wheel.
+    if (timer.slot_index_ < num_levels * num_slots)
+      unlink_slot(timer);
+
+    // Remove the timer from the linked list of active timers.
+    if (timers_ == &timer)
+      timers_ = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_= timer.prev_;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+  }
+
+  // Helper function to convert a duration into milliseconds.
+  template <typename Duration>
+  long to_msec(const Duration& d, long max_duration) const
+  {
+    if (d.ticks() <= 0)
+      return 0;
+    int64_t msec = d.total_milliseconds();
+    if (msec == 0)
+      return 1;
+    if (msec > max_duration)
+      return max_duration;
+    return static_cast<long>(msec);
+  }
+
+  // Helper function to convert a duration into microseconds.
+  template <typename Duration>
+  long to_usec(const Duration& d, long max_duration) const
+  {
+    if (d.ticks() <= 0)
+      return 0;
+    int64_t usec = d.total_microseconds();
+    if (usec == 0)
+      return 1;
+    if (usec > max_duration)
+      return max_duration;
+    return static_cast<long>(usec);
+  }
+
+  // The time that corresponds to tick zero.
+  time_type origin_;
+
+  // The length of a tick.
+  duration_type tick_;
+
+  // The tick that the wheel has most recently turned to.
+  uint64_t current_tick_;
+
+  // The head of a linked list of all active timers.
+  per_timer_data* timers_;
+
+  // For each level, a mask of the slots that hold at least one timer.
+  uint64_t occupied_[num_levels];
+
+  // The heads of the linked lists of timers in each slot, level by level.
+  per_timer_data* slots_[num_levels * num_slots];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TIMER_WHEEL_QUEUE_HPP
@@ -0,0 +1,101 @@
+//
+// detail/udp_segment_control.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_UDP_SEGMENT_CONTROL_HPP
+#define BOOST_ASIO_DETAIL_UDP_SEGMENT_CONTROL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+
+#include <cstddef>
+#include <cstring>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// The ancillary data used to send a buffer as a train of UDP segments, and to
+// find the segment size of a datagram coalesced by the kernel on receive.
+class udp_segment_control
+{
+public:
+  // Attach a request that the payload be split into segments of the given
+  // size. A zero size leaves the socket's own setting in effect.
+  void prepare_send(msghdr& msg, std::size_t segment_size)
+  {
+    if (segment_size == 0)
+    {
+      msg.msg_control = 0;
+      msg.msg_controllen = 0;
+      return;
+    }
+
+    std::memset(&storage_, 0, sizeof(storage_));
+    msg.msg_control = storage_.buf;
+    msg.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    uint16_t size = static_cast<uint16_t>(segment_size);
+    std::memcpy(CMSG_DATA(cmsg), &size, sizeof(size));
+  }
+
+  // Provide space for the segment size delivered with a coalesced datagram.
+  void prepare_receive(msghdr& msg)
+  {
+    msg.msg_control = storage_.buf;
+    msg.msg_controllen = sizeof(storage_.buf);
+  }
+
+  // Obtain the segment size from a received message, or the given default if
+  // the datagram was not coalesced.
+  static std::size_t segment_size(msghdr& msg, std::size_t default_size)
+  {
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+      {
+        int size = 0;
+        std::memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+        if (size > 0)
+          return static_cast<std::size_t>(size);
+      }
+    }
+    return default_size;
+  }
+
+private:
+  union
+  {
+    std::size_t align;
+    char buf[CMSG_SPACE(sizeof(int))];
+  } storage_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
+#endif // BOOST_ASIO_DETAIL_UDP_SEGMENT_CONTROL_HPP
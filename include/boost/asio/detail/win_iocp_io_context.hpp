@@ -204,18 +204,47 @@ public:
       typename timer_queue<Time_Traits>::per_timer_data* timer,
       void* cancellation_key);
 
+  // Change the expiry time of the given timer without cancelling its
+  // operations.
+  template <typename Time_Traits>
+  void reschedule_timer(timer_queue<Time_Traits>& queue,
+      const typename Time_Traits::time_type& time,
+      typename timer_queue<Time_Traits>::per_timer_data& timer);
+
   // Move the timer operations associated with the given timer.
   template <typename Time_Traits>
   void move_timer(timer_queue<Time_Traits>& queue,
       typename timer_queue<Time_Traits>::per_timer_data& to,
       typename timer_queue<Time_Traits>::per_timer_data& from);
 
+  // Set the slack, in microseconds, by which timer expiries may be deferred
+  // so that timers expiring close together complete in a single batch.
+  BOOST_ASIO_DECL void set_timer_slack(long usec);
+
   // Get the concurrency hint that was used to initialise the io_context.
   int concurrency_hint() const
   {
     return concurrency_hint_;
   }
 
+  // Completions are dequeued directly from the port, so there is no task
+  // that can be starved and the run budget is ignored.
+  void set_run_budget(std::size_t, long)
+  {
+  }
+
+  // Get the number of times the run budget has forced the task to run.
+  std::size_t run_budget_handler_triggers() const
+  {
+    return 0;
+  }
+
+  // Get the number of times the run budget has forced the task to run.
+  std::size_t run_budget_time_triggers() const
+  {
+    return 0;
+  }
+
 private:
 #if defined(WINVER) && (WINVER < 0x0500)
   typedef DWORD dword_ptr_t;
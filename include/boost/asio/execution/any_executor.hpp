@@ -22,6 +22,7 @@
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/cstddef.hpp>
 #include <boost/asio/detail/executor_function.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/non_const_lvalue.hpp>
 #include <boost/asio/detail/scoped_ptr.hpp>
@@ -411,14 +412,16 @@ struct is_valid_target_executor<int, Props> : false_type
 {
 };
 
+class any_executor_base;
+
 class shared_target_executor
 {
 public:
   template <typename E>
   shared_target_executor(E&& e, decay_t<E>*& target)
   {
-    impl<decay_t<E>>* i =
-      new impl<decay_t<E>>(static_cast<E&&>(e));
+    typedef typename impl_type<decay_t<E>>::type impl_t;
+    impl_t* i = new impl_t(static_cast<E&&>(e));
     target = &i->ex_;
     impl_ = i;
   }
@@ -426,8 +429,8 @@ public:
   template <typename E>
   shared_target_executor(std::nothrow_t, E&& e, decay_t<E>*& target) noexcept
   {
-    impl<decay_t<E>>* i =
-      new (std::nothrow) impl<decay_t<E>>(static_cast<E&&>(e));
+    typedef typename impl_type<decay_t<E>>::type impl_t;
+    impl_t* i = new (std::nothrow) impl_t(static_cast<E&&>(e));
     target = i ? &i->ex_ : 0;
     impl_ = i;
   }
@@ -490,6 +493,61 @@ private:
     Executor ex_;
   };
 
+  // Converting one polymorphic executor to another wraps the source in a
+  // shared target. This happens on every operation that obtains the
+  // associated executor of an any_completion_handler, as the I/O object's
+  // any_io_executor is converted to an any_completion_executor. These targets
+  // are small and short-lived, so their memory is taken from the thread's
+  // recycling cache. Targets for other executors are created less often and
+  // may be large, so they still use the global operator new.
+  template <typename Executor>
+  struct recycled_impl : impl<Executor>
+  {
+    recycled_impl(Executor ex) : impl<Executor>(static_cast<Executor&&>(ex)) {}
+
+    static void* operator new(std::size_t size)
+    {
+      return boost::asio::detail::default_allocate(size);
+    }
+
+    static void* operator new(std::size_t size,
+        const std::nothrow_t&) noexcept
+    {
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      try
+      {
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+        return boost::asio::detail::default_allocate(size);
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      }
+      catch (...)
+      {
+        return 0;
+      }
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    }
+
+    static void operator delete(void* p, std::size_t size) noexcept
+    {
+      boost::asio::detail::default_deallocate(p, size);
+    }
+
+    static void operator delete(void* p, const std::nothrow_t&) noexcept
+    {
+      boost::asio::detail::default_deallocate(p, sizeof(recycled_impl));
+    }
+  };
+
+  template <typename Executor>
+  struct impl_type :
+    conditional<
+      is_base_of<any_executor_base, Executor>::value,
+      recycled_impl<Executor>,
+      impl<Executor>
+    >
+  {
+  };
+
   impl_base* impl_;
 };
 
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <cstring>
 #include <exception>
 #include <new>
 #include <tuple>
@@ -597,11 +598,34 @@ public:
 
 struct awaitable_thread_entry_point {};
 
+// The function that frees the memory of an entry point frame is stored
+// immediately before the frame.
+typedef void (*awaitable_thread_entry_point_deallocate)(void*, std::size_t);
+
 template <typename Executor>
 class awaitable_frame<awaitable_thread_entry_point, Executor>
   : public awaitable_frame_base<Executor>
 {
 public:
+#if !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  // The entry point frame is allocated by the state that is passed to the
+  // entry point coroutine, so that it can use the allocator associated with
+  // the thread's completion handler.
+  template <typename T, typename State>
+  void* operator new(std::size_t size, T*, State& state)
+  {
+    return state.allocate_frame(size);
+  }
+
+  void operator delete(void* pointer, std::size_t size)
+  {
+    awaitable_thread_entry_point_deallocate deallocate;
+    std::memcpy(&deallocate, static_cast<unsigned char*>(pointer)
+        - sizeof(deallocate), sizeof(deallocate));
+    deallocate(pointer, size);
+  }
+#endif // !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
   awaitable_frame()
     : top_of_stack_(0),
       has_executor_(false),
@@ -1161,6 +1185,18 @@ private:
 };
 
 } // namespace detail
+
+inline awaitable_frame_statistics get_awaitable_frame_statistics()
+{
+  detail::slab_cache_statistics s = detail::awaitable_frame_counters::get();
+
+  awaitable_frame_statistics result;
+  result.hits = s.hits;
+  result.misses = s.misses;
+  result.bytes = s.bytes;
+  return result;
+}
+
 } // namespace asio
 } // namespace boost
 
@@ -16,6 +16,9 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <cstring>
+#include <new>
+#include <boost/asio/associated_allocator.hpp>
 #include <boost/asio/associated_cancellation_slot.hpp>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/detail/memory.hpp>
@@ -72,6 +75,80 @@ struct co_spawn_work_guard<Executor,
 
 #endif // !defined(BOOST_ASIO_NO_TS_EXECUTORS)
 
+#if !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
+// Allocates the entry point frame of a thread using the allocator associated
+// with the thread's completion handler. A copy of the allocator is stored at
+// the start of the memory, as the handler has been moved away by the time the
+// frame is freed.
+template <typename Handler>
+class co_spawn_frame_memory
+{
+public:
+  static void* allocate(const Handler& handler, std::size_t size)
+  {
+    block_allocator_type allocator(
+        (get_associated_allocator)(handler,
+          recycling_allocator<void,
+            thread_info_base::awaitable_frame_tag>()));
+
+    block* base_ptr = std::allocator_traits<block_allocator_type>::allocate(
+        allocator, header_blocks() + blocks(size));
+
+    new (static_cast<void*>(base_ptr)) allocator_type(std::move(allocator));
+
+    awaitable_thread_entry_point_deallocate deallocate =
+      &co_spawn_frame_memory::deallocate;
+    unsigned char* frame_ptr = static_cast<unsigned char*>(
+        static_cast<void*>(base_ptr + header_blocks()));
+    std::memcpy(frame_ptr - sizeof(deallocate),
+        &deallocate, sizeof(deallocate));
+
+    return frame_ptr;
+  }
+
+  static void deallocate(void* ptr, std::size_t size)
+  {
+    block* base_ptr = static_cast<block*>(ptr) - header_blocks();
+
+    allocator_type* allocator_ptr = std::launder(
+        static_cast<allocator_type*>(static_cast<void*>(base_ptr)));
+
+    block_allocator_type block_allocator(std::move(*allocator_ptr));
+    allocator_ptr->~allocator_type();
+
+    std::allocator_traits<block_allocator_type>::deallocate(block_allocator,
+        base_ptr, header_blocks() + blocks(size));
+  }
+
+private:
+  typedef associated_allocator_t<Handler,
+    recycling_allocator<void, thread_info_base::awaitable_frame_tag>>
+      allocator_type;
+
+  union block
+  {
+    std::max_align_t max_align;
+    alignas(allocator_type) char pad[alignof(allocator_type)];
+  };
+
+  typedef typename std::allocator_traits<allocator_type>
+    ::template rebind_alloc<block> block_allocator_type;
+
+  static constexpr std::size_t blocks(std::size_t size)
+  {
+    return (size + sizeof(block) - 1) / sizeof(block);
+  }
+
+  static constexpr std::size_t header_blocks()
+  {
+    return blocks(sizeof(allocator_type)
+        + sizeof(awaitable_thread_entry_point_deallocate));
+  }
+};
+
+#endif // !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
 template <typename Handler, typename Executor,
     typename Function, typename = void>
 struct co_spawn_state
@@ -85,6 +162,13 @@ struct co_spawn_state
   {
   }
 
+#if !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  void* allocate_frame(std::size_t size)
+  {
+    return co_spawn_frame_memory<Handler>::allocate(handler, size);
+  }
+#endif // !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
   Handler handler;
   co_spawn_work_guard<Executor> spawn_work;
   co_spawn_work_guard<associated_executor_t<Handler, Executor>> handler_work;
@@ -109,6 +193,13 @@ struct co_spawn_state<Handler, Executor, Function,
   {
   }
 
+#if !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  void* allocate_frame(std::size_t size)
+  {
+    return co_spawn_frame_memory<Handler>::allocate(handler, size);
+  }
+#endif // !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+
   Handler handler;
   co_spawn_work_guard<Executor> handler_work;
   Function function;
@@ -134,6 +225,13 @@ struct co_spawn_post
   }
 };
 
+// The entry point frame is allocated by a placement form of operator new and
+// freed by the usual operator delete, as required for coroutines.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif // defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+
 template <typename T, typename Handler, typename Executor, typename Function>
 awaitable<awaitable_thread_entry_point, Executor> co_spawn_entry_point(
     awaitable<T, Executor>*, co_spawn_state<Handler, Executor, Function> s)
@@ -208,6 +306,10 @@ awaitable<awaitable_thread_entry_point, Executor> co_spawn_entry_point(
       });
 }
 
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+# pragma GCC diagnostic pop
+#endif // defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+
 template <typename T, typename Executor>
 class awaitable_as_function
 {
@@ -230,10 +332,11 @@ template <typename Handler, typename Executor, typename = void>
 class co_spawn_cancellation_handler
 {
 public:
-  co_spawn_cancellation_handler(const Handler&, const Executor& ex)
+  co_spawn_cancellation_handler(const Handler& handler, const Executor& ex)
     : signal_(detail::allocate_shared<cancellation_signal>(
-          detail::recycling_allocator<cancellation_signal,
-            detail::thread_info_base::cancellation_signal_tag>())),
+          (get_associated_allocator)(handler,
+            detail::recycling_allocator<void,
+              detail::thread_info_base::cancellation_signal_tag>()))),
       ex_(ex)
   {
   }
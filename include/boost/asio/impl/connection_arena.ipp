@@ -0,0 +1,110 @@
+//
+// impl/connection_arena.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_CONNECTION_ARENA_IPP
+#define BOOST_ASIO_IMPL_CONNECTION_ARENA_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/connection_arena.hpp>
+#include <boost/asio/detail/memory.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+connection_arena::connection_arena(std::size_t block_size)
+  : blocks_(0),
+    next_(0),
+    end_(0),
+    block_size_(block_size),
+    bytes_reserved_(0)
+{
+  for (std::size_t i = 0; i < size_classes::num_classes; ++i)
+  {
+    free_lists_[i].head_ = 0;
+    free_lists_[i].count_ = 0;
+  }
+}
+
+connection_arena::~connection_arena()
+{
+  while (blocks_)
+  {
+    void* block = blocks_;
+    blocks_ = *static_cast<void**>(block);
+    aligned_delete(block);
+  }
+}
+
+void* connection_arena::allocate(std::size_t size, std::size_t align)
+{
+  if (size > size_classes::max_size || align > BOOST_ASIO_DEFAULT_ALIGN)
+    return aligned_new(align, size);
+
+  std::size_t index = size_classes::class_of(size);
+  if (free_lists_[index].count_ > 0)
+    return free_lists_[index].pop();
+
+  std::size_t n = size_classes::class_size(index);
+  if (static_cast<std::size_t>(end_ - next_) < n)
+    add_block(n);
+
+  void* p = next_;
+  next_ += n;
+  return p;
+}
+
+void connection_arena::deallocate(void* p,
+    std::size_t size, std::size_t align) noexcept
+{
+  if (size > size_classes::max_size || align > BOOST_ASIO_DEFAULT_ALIGN)
+    aligned_delete(p);
+  else
+    free_lists_[size_classes::class_of(size)].push(p);
+}
+
+void connection_arena::add_block(std::size_t size)
+{
+  // The block starts with a link to the previous block, padded so that the
+  // memory that follows it is suitably aligned.
+  std::size_t header = BOOST_ASIO_DEFAULT_ALIGN;
+  std::size_t n = size + header > block_size_ ? size + header : block_size_;
+  void* block = aligned_new(BOOST_ASIO_DEFAULT_ALIGN, n);
+
+  // Give what is left of the current block to the free lists, rather than
+  // discarding it.
+  for (std::size_t i = size_classes::num_classes; i > 0; --i)
+  {
+    std::size_t class_size = size_classes::class_size(i - 1);
+    while (static_cast<std::size_t>(end_ - next_) >= class_size)
+    {
+      free_lists_[i - 1].push(next_);
+      next_ += class_size;
+    }
+  }
+
+  *static_cast<void**>(block) = blocks_;
+  blocks_ = block;
+  next_ = static_cast<unsigned char*>(block) + header;
+  end_ = static_cast<unsigned char*>(block) + n;
+  bytes_reserved_ += n;
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_CONNECTION_ARENA_IPP
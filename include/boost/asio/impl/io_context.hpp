@@ -56,6 +56,21 @@ io_context::get_executor() noexcept
   return executor_type(*this);
 }
 
+template <typename Rep, typename Period>
+void io_context::set_run_budget(count_type max_handlers,
+    const chrono::duration<Rep, Period>& max_time)
+{
+  impl_.set_run_budget(max_handlers, static_cast<long>(
+        chrono::duration_cast<chrono::microseconds>(max_time).count()));
+}
+
+template <typename Rep, typename Period>
+void io_context::set_timer_slack(const chrono::duration<Rep, Period>& slack)
+{
+  set_timer_slack_usec(static_cast<long>(
+        chrono::duration_cast<chrono::microseconds>(slack).count()));
+}
+
 template <typename Rep, typename Period>
 std::size_t io_context::run_for(
     const chrono::duration<Rep, Period>& rel_time)
@@ -22,6 +22,13 @@
 #include <boost/asio/detail/scoped_ptr.hpp>
 #include <boost/asio/detail/service_registry.hpp>
 #include <boost/asio/detail/throw_error.hpp>
+#include <boost/asio/detail/timer_scheduler.hpp>
+
+#if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+# include <boost/asio/detail/epoll_reactor.hpp>
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
 
 #if defined(BOOST_ASIO_HAS_IOCP)
 # include <boost/asio/detail/win_iocp_io_context.hpp>
@@ -133,6 +140,63 @@ void io_context::restart()
   impl_.restart();
 }
 
+void io_context::set_run_budget(count_type max_handlers)
+{
+  impl_.set_run_budget(max_handlers, 0);
+}
+
+io_context::count_type io_context::run_budget_handler_triggers() const
+{
+  return impl_.run_budget_handler_triggers();
+}
+
+io_context::count_type io_context::run_budget_time_triggers() const
+{
+  return impl_.run_budget_time_triggers();
+}
+
+void io_context::set_timer_slack_usec(long usec)
+{
+  detail::timer_scheduler& timers =
+    boost::asio::use_service<detail::timer_scheduler>(*this);
+  timers.set_timer_slack(usec);
+}
+
+void io_context::set_event_batch_size(
+    count_type initial_events, count_type max_events)
+{
+#if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  detail::epoll_reactor& reactor =
+    boost::asio::use_service<detail::epoll_reactor>(*this);
+  reactor.set_event_batch_size(initial_events, max_events);
+#else // defined(BOOST_ASIO_HAS_EPOLL)
+      //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  (void)initial_events;
+  (void)max_events;
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+io_context::wait_statistics io_context::get_wait_statistics() const
+{
+  wait_statistics stats = { 0, 0, 0, 0 };
+#if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  detail::epoll_reactor& reactor =
+    boost::asio::use_service<detail::epoll_reactor>(
+        const_cast<io_context&>(*this));
+  detail::epoll_reactor::wait_statistics reactor_stats =
+    reactor.get_wait_statistics();
+  stats.waits = reactor_stats.waits;
+  stats.events = reactor_stats.events;
+  stats.full_batches = reactor_stats.full_batches;
+  stats.batch_size = reactor_stats.batch_size;
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  return stats;
+}
+
 io_context::service::service(boost::asio::io_context& owner)
   : execution_context::service(owner)
 {
@@ -0,0 +1,247 @@
+//
+// impl/io_context_group.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_IO_CONTEXT_GROUP_IPP
+#define BOOST_ASIO_IMPL_IO_CONTEXT_GROUP_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <exception>
+#include <boost/asio/io_context_group.hpp>
+#include <boost/asio/detail/thread.hpp>
+
+#if defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+# include <pthread.h>
+# include <sched.h>
+#endif // defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Get the CPUs on which the calling thread is permitted to run.
+inline std::vector<int> available_cpus()
+{
+  std::vector<int> cpus;
+#if defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (::pthread_getaffinity_np(::pthread_self(), sizeof(set), &set) == 0)
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if (CPU_ISSET(cpu, &set))
+        cpus.push_back(cpu);
+#endif // defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+  return cpus;
+}
+
+// Bind the calling thread to the specified CPU.
+inline void bind_current_thread(int cpu)
+{
+#if defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+  if (cpu >= 0)
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  }
+#else // defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+  (void)cpu;
+#endif // defined(BOOST_ASIO_HAS_THREAD_AFFINITY)
+}
+
+} // namespace detail
+
+struct io_context_group::thread_function
+{
+  io_context_group* group_;
+  std::size_t index_;
+
+  void operator()()
+  {
+    // Bind before constructing the io_context so that its memory is first
+    // touched from the CPU that will use it.
+    detail::bind_current_thread(group_->cpus_[index_]);
+
+    // A failure to construct the io_context, such as when the reactor's
+    // descriptors cannot be created, is reported to the group's constructor.
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    context_impl* impl = 0;
+    try
+    {
+      impl = new context_impl;
+    }
+    catch (...)
+    {
+      group_->context_failed(std::current_exception());
+      return;
+    }
+#else // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    context_impl* impl = new context_impl;
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+
+    io_context& ctx = impl->context_;
+    group_->context_ready(index_, impl);
+
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif// !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      ctx.run();
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      std::terminate();
+    }
+#endif// !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  }
+};
+
+io_context_group::io_context_group()
+  : next_(0),
+    num_ready_(0)
+{
+  std::size_t num_contexts = detail::available_cpus().size();
+  if (num_contexts == 0)
+    num_contexts = detail::thread::hardware_concurrency();
+  start(num_contexts == 0 ? 1 : num_contexts, true);
+}
+
+io_context_group::io_context_group(
+    std::size_t num_contexts, bool bind_threads)
+  : next_(0),
+    num_ready_(0)
+{
+  start(num_contexts == 0 ? 1 : num_contexts, bind_threads);
+}
+
+io_context_group::~io_context_group()
+{
+  stop();
+  join();
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    delete contexts_[i];
+}
+
+void io_context_group::stop()
+{
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    contexts_[i]->context_.stop();
+}
+
+void io_context_group::join()
+{
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    contexts_[i]->work_.reset();
+
+  if (!threads_.empty())
+    threads_.join();
+}
+
+void io_context_group::start(std::size_t num_contexts, bool bind_threads)
+{
+  contexts_.resize(num_contexts, 0);
+  cpus_.resize(num_contexts, -1);
+
+  if (bind_threads)
+  {
+    std::vector<int> cpus = detail::available_cpus();
+    if (!cpus.empty())
+      for (std::size_t i = 0; i < num_contexts; ++i)
+        cpus_[i] = cpus[i % cpus.size()];
+  }
+
+  std::size_t num_threads = 0;
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  try
+  {
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    for (; num_threads < num_contexts; ++num_threads)
+    {
+      thread_function f = { this, num_threads };
+      threads_.create_thread(f);
+    }
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  }
+  catch (...)
+  {
+    wait_until_ready(num_threads);
+    abandon();
+    throw;
+  }
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+
+  wait_until_ready(num_contexts);
+
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  if (exception_)
+  {
+    std::exception_ptr e = exception_;
+    abandon();
+    std::rethrow_exception(e);
+  }
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+}
+
+void io_context_group::context_ready(std::size_t index, context_impl* impl)
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  contexts_[index] = impl;
+  ++num_ready_;
+  ready_event_.signal_all(lock);
+}
+
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+void io_context_group::context_failed(std::exception_ptr e)
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  if (!exception_)
+    exception_ = e;
+  ++num_ready_;
+  ready_event_.signal_all(lock);
+}
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+
+void io_context_group::wait_until_ready(std::size_t num_threads)
+{
+  detail::mutex::scoped_lock lock(mutex_);
+  while (num_ready_ < num_threads)
+  {
+    ready_event_.clear(lock);
+    ready_event_.wait(lock);
+  }
+}
+
+void io_context_group::abandon()
+{
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    if (contexts_[i])
+      contexts_[i]->context_.stop();
+
+  threads_.join();
+
+  for (std::size_t i = 0; i < contexts_.size(); ++i)
+    delete contexts_[i];
+  contexts_.clear();
+  cpus_.clear();
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_IO_CONTEXT_GROUP_IPP
@@ -23,10 +23,12 @@
 #include <boost/asio/impl/any_io_executor.ipp>
 #include <boost/asio/impl/cancellation_signal.ipp>
 #include <boost/asio/impl/connect_pipe.ipp>
+#include <boost/asio/impl/connection_arena.ipp>
 #include <boost/asio/impl/error.ipp>
 #include <boost/asio/impl/execution_context.ipp>
 #include <boost/asio/impl/executor.ipp>
 #include <boost/asio/impl/io_context.ipp>
+#include <boost/asio/impl/io_context_group.ipp>
 #include <boost/asio/impl/multiple_exceptions.ipp>
 #include <boost/asio/impl/serial_port_base.ipp>
 #include <boost/asio/impl/system_context.ipp>
@@ -517,6 +517,115 @@ public:
    */
   BOOST_ASIO_DECL void restart();
 
+  /// Limit the number of handlers a thread may run before polling for I/O.
+  /**
+   * When handlers keep posting continuations, a thread running the io_context
+   * may execute a large number of them before the reactor is next given the
+   * opportunity to check for new I/O readiness and timer expiry. The run
+   * budget bounds this latency: once a thread has executed @c max_handlers
+   * handlers without running the reactor, the reactor is run with a zero
+   * timeout ahead of any other queued handlers.
+   *
+   * @param max_handlers The maximum number of handlers to execute between
+   * reactor invocations. A value of 0 disables the handler limit.
+   *
+   * @note On platforms where the io_context does not use a reactor, this
+   * function has no effect.
+   */
+  BOOST_ASIO_DECL void set_run_budget(count_type max_handlers);
+
+  /// Limit the number of handlers, and the time, a thread may spend running
+  /// handlers before polling for I/O.
+  /**
+   * Once a thread has executed @c max_handlers handlers, or has spent at least
+   * @c max_time executing handlers, without running the reactor, the reactor
+   * is run with a zero timeout ahead of any other queued handlers.
+   *
+   * @param max_handlers The maximum number of handlers to execute between
+   * reactor invocations. A value of 0 disables the handler limit.
+   *
+   * @param max_time The maximum time to spend executing handlers between
+   * reactor invocations. A zero duration disables the time limit.
+   *
+   * @note On platforms where the io_context does not use a reactor, this
+   * function has no effect.
+   */
+  template <typename Rep, typename Period>
+  void set_run_budget(count_type max_handlers,
+      const chrono::duration<Rep, Period>& max_time);
+
+  /// Get the number of times the handler limit of the run budget has caused
+  /// the reactor to be run early.
+  BOOST_ASIO_DECL count_type run_budget_handler_triggers() const;
+
+  /// Get the number of times the time limit of the run budget has caused the
+  /// reactor to be run early.
+  BOOST_ASIO_DECL count_type run_budget_time_triggers() const;
+
+  /// Allow timer completions to be deferred so that they occur in batches.
+  /**
+   * By default, the io_context wakes up for each timer as soon as it expires.
+   * With a non-zero slack, the wakeup for the earliest timer may be deferred
+   * by up to @c slack, and all timers that have expired by then complete
+   * together. When many timers expire close together, this reduces the number
+   * of wakeups and of system calls made to reschedule them. Timers never
+   * complete before their expiry time.
+   *
+   * @param slack The maximum time by which the completion of a timer's wait
+   * may be deferred. A zero duration, the default, disables the slack.
+   *
+   * @note The slack applies to all timers associated with the io_context.
+   */
+  template <typename Rep, typename Period>
+  void set_timer_slack(const chrono::duration<Rep, Period>& slack);
+
+  /// Statistics describing how the io_context has waited for I/O readiness.
+  struct wait_statistics
+  {
+    /// The number of calls made to wait for readiness events.
+    count_type waits;
+
+    /// The total number of readiness events returned by those calls.
+    count_type events;
+
+    /// The number of calls that returned as many events as could be retrieved
+    /// in one call.
+    count_type full_batches;
+
+    /// The current number of events that may be retrieved in one call.
+    count_type batch_size;
+  };
+
+  /// Set the number of readiness events retrieved by each wait for I/O.
+  /**
+   * Each time the reactor waits for I/O readiness it retrieves up to
+   * @c initial_events events. Whenever a wait returns a full batch, the limit
+   * is doubled, up to @c max_events, so that subsequent waits are more likely
+   * to collect all ready descriptors in one call.
+   *
+   * @param initial_events The number of events retrieved by a wait. A value of
+   * 0 is treated as 1.
+   *
+   * @param max_events The number of events to which the batch may grow. If
+   * less than @c initial_events, the batch size is fixed at
+   * @c initial_events.
+   *
+   * @note This function may be called while the io_context is running, in
+   * which case the change takes effect on the reactor's next wait. On
+   * platforms where the io_context does not use an epoll-based reactor, this
+   * function has no effect.
+   */
+  BOOST_ASIO_DECL void set_event_batch_size(
+      count_type initial_events, count_type max_events);
+
+  /// Get statistics describing how the io_context has waited for I/O
+  /// readiness.
+  /**
+   * @note On platforms where the io_context does not use an epoll-based
+   * reactor, all statistics are zero.
+   */
+  BOOST_ASIO_DECL wait_statistics get_wait_statistics() const;
+
 #if !defined(BOOST_ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
@@ -627,6 +736,9 @@ private:
   // Helper function to add the implementation.
   BOOST_ASIO_DECL impl_type& add_impl(impl_type* impl);
 
+  // Helper function to set the timer slack in microseconds.
+  BOOST_ASIO_DECL void set_timer_slack_usec(long usec);
+
   // Backwards compatible overload for use with services derived from
   // io_context::service.
   template <typename Service>
@@ -0,0 +1,225 @@
+//
+// io_context_group.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IO_CONTEXT_GROUP_HPP
+#define BOOST_ASIO_IO_CONTEXT_GROUP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <exception>
+#include <vector>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/event.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/thread_group.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// A fixed-size group of single-threaded io_context objects.
+/**
+ * The io_context_group class provides a thread-per-core arrangement of
+ * execution contexts. Each io_context in the group is run by exactly one
+ * thread, and is constructed with a concurrency hint of 1 so that the
+ * single-threaded optimisations of the scheduler apply. Cross-thread posting
+ * into any of the contexts remains safe.
+ *
+ * Where the platform supports it, each thread is bound to its own CPU, chosen
+ * in order from the CPUs on which the constructing thread is permitted to run.
+ * The io_context is constructed on its bound thread, so that its scheduler and
+ * reactor state, as well as the memory recycled by handlers running on that
+ * thread, are first touched by, and therefore allocated on the NUMA node of,
+ * the CPU that uses them.
+ *
+ * @par Selecting an io_context
+ *
+ * Work may be distributed across the group using get_executor(), which
+ * selects the contexts in round-robin order, or get_executor_for(), which
+ * consistently maps a key (such as a hash of a connection identifier) to the
+ * same context.
+ *
+ * For example:
+ *
+ * @code boost::asio::io_context_group group(4);
+ *
+ * // Submit a function to the next context in round-robin order.
+ * boost::asio::post(group.get_executor(), my_task);
+ *
+ * // Submit a function to the context that owns a given shard.
+ * boost::asio::post(group.get_executor_for(shard_id), my_task);
+ *
+ * // Wait for all contexts in the group to run out of work.
+ * group.join(); @endcode
+ */
+class io_context_group
+{
+public:
+  /// The type of the executors used to submit work to the group.
+  typedef io_context::executor_type executor_type;
+
+  /// Constructs a group with one io_context per available CPU.
+  BOOST_ASIO_DECL io_context_group();
+
+  /// Constructs a group with a specified number of io_context objects.
+  /**
+   * If a thread cannot be started, or an io_context cannot be constructed,
+   * the threads that did start are stopped and joined, and the exception is
+   * rethrown.
+   *
+   * @param num_contexts The number of io_context objects, and threads, in the
+   * group.
+   *
+   * @param bind_threads Whether each thread should be bound to its own CPU.
+   * This has no effect on platforms that do not support thread affinity.
+   */
+  BOOST_ASIO_DECL explicit io_context_group(
+      std::size_t num_contexts, bool bind_threads = true);
+
+  /// Destructor.
+  /**
+   * Automatically stops and joins the group, if not explicitly done
+   * beforehand, and then destroys the io_context objects.
+   */
+  BOOST_ASIO_DECL ~io_context_group();
+
+  /// Get the number of io_context objects in the group.
+  std::size_t size() const noexcept
+  {
+    return contexts_.size();
+  }
+
+  /// Get the io_context object at the specified index.
+  io_context& get_context(std::size_t index)
+  {
+    return contexts_[index]->context_;
+  }
+
+  /// Get the CPU to which the thread running the specified io_context is
+  /// bound, or -1 if the thread is not bound.
+  int get_cpu(std::size_t index) const
+  {
+    return cpus_[index];
+  }
+
+  /// Obtains an executor for the next io_context in round-robin order.
+  executor_type get_executor() noexcept
+  {
+    std::size_t index = static_cast<std::size_t>(next_++);
+    return contexts_[index % contexts_.size()]->context_.get_executor();
+  }
+
+  /// Obtains an executor for the io_context selected by the specified key.
+  /**
+   * The same key always selects the same io_context.
+   */
+  executor_type get_executor_for(std::size_t key) noexcept
+  {
+    return contexts_[key % contexts_.size()]->context_.get_executor();
+  }
+
+  /// Stops all io_context objects in the group.
+  /**
+   * This function stops the threads as soon as possible. As a result of calling
+   * @c stop(), pending function objects may be never be invoked.
+   */
+  BOOST_ASIO_DECL void stop();
+
+  /// Joins the threads.
+  /**
+   * This function blocks until the threads in the group have completed. If @c
+   * stop() is not called prior to @c join(), the @c join() call will wait
+   * until every io_context in the group has no more outstanding work.
+   */
+  BOOST_ASIO_DECL void join();
+
+private:
+  io_context_group(const io_context_group&) = delete;
+  io_context_group& operator=(const io_context_group&) = delete;
+
+  struct thread_function;
+
+  // An io_context together with the work that keeps its thread running.
+  struct context_impl
+  {
+    context_impl()
+      : context_(BOOST_ASIO_CONCURRENCY_HINT_1),
+        work_(context_.get_executor())
+    {
+#if !defined(BOOST_ASIO_HAS_IOCP)
+      // Create the reactor now, on the thread that runs the io_context, so
+      // that its memory is local to that thread and a failure to create it
+      // is reported by the group's constructor.
+      boost::asio::use_service<detail::scheduler>(context_).init_task();
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+    }
+
+    io_context context_;
+    executor_work_guard<executor_type> work_;
+  };
+
+  // Start the threads and wait for each to construct its io_context.
+  BOOST_ASIO_DECL void start(std::size_t num_contexts, bool bind_threads);
+
+  // Called by each thread once its io_context has been constructed.
+  BOOST_ASIO_DECL void context_ready(std::size_t index, context_impl* impl);
+
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  // Called by a thread that failed to construct its io_context.
+  BOOST_ASIO_DECL void context_failed(std::exception_ptr e);
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+
+  // Wait until the specified number of threads have reported their state.
+  BOOST_ASIO_DECL void wait_until_ready(std::size_t num_threads);
+
+  // Stop and join the threads that were started, and destroy their io_context
+  // objects, when the group cannot be constructed.
+  BOOST_ASIO_DECL void abandon();
+
+  // The io_context objects, each owned by the group and run by one thread.
+  std::vector<context_impl*> contexts_;
+
+  // The CPU to which each thread is bound, or -1.
+  std::vector<int> cpus_;
+
+  // The index of the next context to be selected in round-robin order.
+  detail::atomic_count next_;
+
+  // Mutex and event used to wait for the threads to start.
+  detail::mutex mutex_;
+  detail::event ready_event_;
+  std::size_t num_ready_;
+
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  // The first exception thrown while constructing an io_context.
+  std::exception_ptr exception_;
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+
+  // The threads in the group.
+  detail::thread_group threads_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/io_context_group.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_IO_CONTEXT_GROUP_HPP
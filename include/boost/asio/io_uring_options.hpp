@@ -0,0 +1,297 @@
+//
+// io_uring_options.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IO_URING_OPTIONS_HPP
+#define BOOST_ASIO_IO_URING_OPTIONS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/execution_context.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+// The default number of entries in the submission queue.
+#if !defined(BOOST_ASIO_IO_URING_RING_SIZE)
+# define BOOST_ASIO_IO_URING_RING_SIZE 16384
+#endif // !defined(BOOST_ASIO_IO_URING_RING_SIZE)
+
+// The default number of pending submission queue entries at which they are
+// submitted immediately, rather than by a posted operation.
+#if !defined(BOOST_ASIO_IO_URING_SUBMIT_BATCH_SIZE)
+# define BOOST_ASIO_IO_URING_SUBMIT_BATCH_SIZE 128
+#endif // !defined(BOOST_ASIO_IO_URING_SUBMIT_BATCH_SIZE)
+
+// The default number of completion queue entries processed in each run of the
+// io_uring backend.
+#if !defined(BOOST_ASIO_IO_URING_COMPLETE_BATCH_SIZE)
+# define BOOST_ASIO_IO_URING_COMPLETE_BATCH_SIZE 128
+#endif // !defined(BOOST_ASIO_IO_URING_COMPLETE_BATCH_SIZE)
+
+namespace boost {
+namespace asio {
+
+/// Options used to create the io_uring instance of an execution context.
+/**
+ * The io_uring_options service holds the parameters with which an execution
+ * context creates its io_uring instance. The ring is created when the io_uring
+ * backend is first used, which is usually when the first I/O object is
+ * constructed, and so the options must be set before then:
+ *
+ * @code
+ * boost::asio::io_context ctx(1);
+ * boost::asio::io_uring_options& options =
+ *   boost::asio::use_service<boost::asio::io_uring_options>(ctx);
+ * options.submission_queue_polling(true);
+ * options.submission_queue_polling_idle(2000);
+ * boost::asio::ip::tcp::socket socket(ctx);
+ * @endcode
+ *
+ * Changes made after the ring has been created have no effect.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class io_uring_options
+#if !defined(GENERATING_DOCUMENTATION)
+  : public detail::execution_context_service_base<io_uring_options>
+#endif // !defined(GENERATING_DOCUMENTATION)
+{
+public:
+  /// Construct with the default options.
+  explicit io_uring_options(execution_context& context)
+    : detail::execution_context_service_base<io_uring_options>(context),
+      ring_size_(BOOST_ASIO_IO_URING_RING_SIZE),
+      completion_queue_size_(0),
+      submission_queue_polling_(false),
+      submission_queue_polling_idle_(0),
+      submission_queue_polling_cpu_(-1),
+      cooperative_task_run_(false),
+      single_issuer_(false),
+      defer_task_run_(false),
+      submit_batch_size_(BOOST_ASIO_IO_URING_SUBMIT_BATCH_SIZE),
+      complete_batch_size_(BOOST_ASIO_IO_URING_COMPLETE_BATCH_SIZE)
+  {
+  }
+
+  /// Get the number of entries in the submission queue.
+  std::size_t ring_size() const noexcept
+  {
+    return ring_size_;
+  }
+
+  /// Set the number of entries in the submission queue.
+  /**
+   * Defaults to @c BOOST_ASIO_IO_URING_RING_SIZE. The kernel rounds the size
+   * up to a power of two.
+   */
+  void ring_size(std::size_t n) noexcept
+  {
+    ring_size_ = n;
+  }
+
+  /// Get the number of entries in the completion queue.
+  std::size_t completion_queue_size() const noexcept
+  {
+    return completion_queue_size_;
+  }
+
+  /// Set the number of entries in the completion queue.
+  /**
+   * Zero, the default, lets the kernel choose a completion queue twice the
+   * size of the submission queue.
+   */
+  void completion_queue_size(std::size_t n) noexcept
+  {
+    completion_queue_size_ = n;
+  }
+
+  /// Determine whether a kernel thread polls the submission queue.
+  bool submission_queue_polling() const noexcept
+  {
+    return submission_queue_polling_;
+  }
+
+  /// Set whether a kernel thread polls the submission queue.
+  /**
+   * Implements the @c IORING_SETUP_SQPOLL flag. While the kernel thread is
+   * awake, operations are submitted without a system call, and so they are
+   * submitted as soon as they are started rather than in batches.
+   */
+  void submission_queue_polling(bool enabled) noexcept
+  {
+    submission_queue_polling_ = enabled;
+  }
+
+  /// Get the number of milliseconds for which the polling thread stays awake
+  /// without work.
+  unsigned int submission_queue_polling_idle() const noexcept
+  {
+    return submission_queue_polling_idle_;
+  }
+
+  /// Set the number of milliseconds for which the polling thread stays awake
+  /// without work.
+  /**
+   * Zero, the default, uses the kernel's default.
+   */
+  void submission_queue_polling_idle(unsigned int milliseconds) noexcept
+  {
+    submission_queue_polling_idle_ = milliseconds;
+  }
+
+  /// Get the CPU to which the polling thread is bound.
+  int submission_queue_polling_cpu() const noexcept
+  {
+    return submission_queue_polling_cpu_;
+  }
+
+  /// Set the CPU to which the polling thread is bound.
+  /**
+   * Implements the @c IORING_SETUP_SQ_AFF flag. A negative value, the
+   * default, leaves the thread unbound.
+   */
+  void submission_queue_polling_cpu(int cpu) noexcept
+  {
+    submission_queue_polling_cpu_ = cpu;
+  }
+
+  /// Determine whether the kernel runs completion work cooperatively.
+  bool cooperative_task_run() const noexcept
+  {
+    return cooperative_task_run_;
+  }
+
+  /// Set whether the kernel runs completion work cooperatively.
+  /**
+   * Implements the @c IORING_SETUP_COOP_TASKRUN flag, which avoids
+   * interrupting a thread to run completion work. Ignored by kernels that do
+   * not support it.
+   */
+  void cooperative_task_run(bool enabled) noexcept
+  {
+    cooperative_task_run_ = enabled;
+  }
+
+  /// Determine whether only one thread submits operations.
+  bool single_issuer() const noexcept
+  {
+    return single_issuer_;
+  }
+
+  /// Set whether only one thread submits operations.
+  /**
+   * Implements the @c IORING_SETUP_SINGLE_ISSUER flag. Ignored by kernels that
+   * do not support it.
+   *
+   * @note Operations are submitted by the thread that starts them or runs the
+   * execution context. The flag may only be used when all of these are the
+   * thread that first submits to the ring, such as when a single thread both
+   * starts all operations and runs an io_context created with a concurrency
+   * hint of 1.
+   */
+  void single_issuer(bool enabled) noexcept
+  {
+    single_issuer_ = enabled;
+  }
+
+  /// Determine whether completion work is deferred until the execution
+  /// context waits for completions.
+  bool defer_task_run() const noexcept
+  {
+    return defer_task_run_;
+  }
+
+  /// Set whether completion work is deferred until the execution context
+  /// waits for completions.
+  /**
+   * Implements the @c IORING_SETUP_DEFER_TASKRUN flag, which requires, and
+   * implies, single_issuer(). Ignored by kernels that do not support it.
+   *
+   * @note The flag is only honoured when io_uring is the default backend, as
+   * otherwise completions are detected through an eventfd that is not
+   * signalled until the deferred work has run.
+   */
+  void defer_task_run(bool enabled) noexcept
+  {
+    defer_task_run_ = enabled;
+  }
+
+  /// Get the number of pending operations at which they are submitted
+  /// immediately.
+  std::size_t submit_batch_size() const noexcept
+  {
+    return submit_batch_size_;
+  }
+
+  /// Set the number of pending operations at which they are submitted
+  /// immediately.
+  /**
+   * Below this number, operations are submitted together by an operation
+   * posted to the execution context. Defaults to
+   * @c BOOST_ASIO_IO_URING_SUBMIT_BATCH_SIZE.
+   */
+  void submit_batch_size(std::size_t n) noexcept
+  {
+    submit_batch_size_ = n;
+  }
+
+  /// Get the number of completions processed each time the execution context
+  /// runs the io_uring backend.
+  std::size_t complete_batch_size() const noexcept
+  {
+    return complete_batch_size_;
+  }
+
+  /// Set the number of completions processed each time the execution context
+  /// runs the io_uring backend.
+  /**
+   * Defaults to @c BOOST_ASIO_IO_URING_COMPLETE_BATCH_SIZE.
+   */
+  void complete_batch_size(std::size_t n) noexcept
+  {
+    complete_batch_size_ = n;
+  }
+
+private:
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+  }
+
+  std::size_t ring_size_;
+  std::size_t completion_queue_size_;
+  bool submission_queue_polling_;
+  unsigned int submission_queue_polling_idle_;
+  int submission_queue_polling_cpu_;
+  bool cooperative_task_run_;
+  bool single_issuer_;
+  bool defer_task_run_;
+  std::size_t submit_batch_size_;
+  std::size_t complete_batch_size_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_IO_URING_OPTIONS_HPP
@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/basic_datagram_socket.hpp>
+#include <boost/asio/detail/socket_option.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 #include <boost/asio/ip/basic_endpoint.hpp>
 #include <boost/asio/ip/basic_resolver.hpp>
@@ -82,6 +83,80 @@ public:
   /// The UDP resolver type.
   typedef basic_resolver<udp> resolver;
 
+#if defined(BOOST_ASIO_HAS_UDP_GSO) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for the size of datagrams produced by segmentation offload.
+  /**
+   * Implements the SOL_UDP/UDP_SEGMENT socket option. When set to a non-zero
+   * value, each send on the socket is split into datagrams of the given size.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::udp::socket socket(my_context);
+   * ...
+   * boost::asio::ip::udp::segment_size option(1200);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::udp::socket socket(my_context);
+   * ...
+   * boost::asio::ip::udp::segment_size option;
+   * socket.get_option(option);
+   * int size = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined segment_size;
+#else
+  typedef boost::asio::detail::socket_option::integer<
+    BOOST_ASIO_OS_DEF(IPPROTO_UDP), UDP_SEGMENT> segment_size;
+#endif
+
+  /// Socket option to allow the kernel to coalesce received datagrams.
+  /**
+   * Implements the SOL_UDP/UDP_GRO socket option. When enabled, consecutive
+   * datagrams of the same size from the same sender may be delivered by a
+   * single receive. Use basic_datagram_socket::async_receive_segments_from to
+   * obtain the size of the original datagrams.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::udp::socket socket(my_context);
+   * ...
+   * boost::asio::ip::udp::generic_receive_offload option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::udp::socket socket(my_context);
+   * ...
+   * boost::asio::ip::udp::generic_receive_offload option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined generic_receive_offload;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    BOOST_ASIO_OS_DEF(IPPROTO_UDP), UDP_GRO> generic_receive_offload;
+#endif
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+       //   || defined(GENERATING_DOCUMENTATION)
+
   /// Compare two protocols for equality.
   friend bool operator==(const udp& p1, const udp& p2)
   {
@@ -397,6 +397,125 @@ public:
       reuse_address;
 #endif
 
+#if defined(SO_REUSEPORT) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to allow multiple sockets to be bound to the same address
+  /// and port, with incoming connections or datagrams distributed among them.
+  /**
+   * Implements the SOL_SOCKET/SO_REUSEPORT socket option.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * boost::asio::socket_base::reuse_port option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * boost::asio::socket_base::reuse_port option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined reuse_port;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    BOOST_ASIO_OS_DEF(SOL_SOCKET), SO_REUSEPORT> reuse_port;
+#endif
+#endif // defined(SO_REUSEPORT) || defined(GENERATING_DOCUMENTATION)
+
+#if defined(SO_INCOMING_CPU) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option for the CPU associated with a socket.
+  /**
+   * Implements the SOL_SOCKET/SO_INCOMING_CPU socket option. When set on
+   * sockets that share a port using the @c reuse_port option, the kernel
+   * prefers the socket whose CPU matches the CPU that is processing the
+   * incoming packet.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * boost::asio::socket_base::incoming_cpu option(3);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::socket socket(my_context);
+   * ...
+   * boost::asio::socket_base::incoming_cpu option;
+   * socket.get_option(option);
+   * int cpu = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined incoming_cpu;
+#else
+  typedef boost::asio::detail::socket_option::integer<
+    BOOST_ASIO_OS_DEF(SOL_SOCKET), SO_INCOMING_CPU> incoming_cpu;
+#endif
+#endif // defined(SO_INCOMING_CPU) || defined(GENERATING_DOCUMENTATION)
+
+#if defined(SO_ZEROCOPY) || defined(GENERATING_DOCUMENTATION)
+  /// Socket option to send large buffers without copying them.
+  /**
+   * Implements the SOL_SOCKET/SO_ZEROCOPY socket option. While the option is
+   * set, sends of at least @c BOOST_ASIO_ZERO_COPY_THRESHOLD bytes are made
+   * without copying the data into the kernel, where the implementation
+   * supports it: using @c IORING_OP_SENDMSG_ZC with io_uring, or
+   * @c MSG_ZEROCOPY with epoll. The completion handler is not invoked until
+   * the kernel has released the pages, and so the buffers may be reused as
+   * soon as the handler runs. Smaller sends are copied as usual.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::socket socket(my_context);
+   * ...
+   * boost::asio::socket_base::zero_copy option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::socket socket(my_context);
+   * ...
+   * boost::asio::socket_base::zero_copy option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @note If a zero-copy send is cancelled, or the socket is closed, after the
+   * data has been passed to the kernel, the buffers may still be in use when
+   * the handler is invoked.
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined zero_copy;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    BOOST_ASIO_OS_DEF(SOL_SOCKET), SO_ZEROCOPY> zero_copy;
+#endif
+#endif // defined(SO_ZEROCOPY) || defined(GENERATING_DOCUMENTATION)
+
   /// Socket option to specify whether the socket lingers on close if unsent
   /// data is present.
   /**
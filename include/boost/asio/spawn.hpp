@@ -30,6 +30,12 @@
 # include <boost/coroutine/all.hpp>
 #endif // defined(BOOST_ASIO_HAS_BOOST_COROUTINE)
 
+#if defined(BOOST_ASIO_HAS_BOOST_CONTEXT_FIBER)
+# include <boost/context/stack_context.hpp>
+# include <boost/context/stack_traits.hpp>
+# include <boost/asio/detail/stack_pool.hpp>
+#endif // defined(BOOST_ASIO_HAS_BOOST_CONTEXT_FIBER)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
@@ -337,6 +343,110 @@ public:
 /// coroutine.
 typedef basic_yield_context<any_io_executor> yield_context;
 
+#if defined(BOOST_ASIO_HAS_BOOST_CONTEXT_FIBER) \
+  || defined(GENERATING_DOCUMENTATION)
+
+/// A stack allocator that recycles the stacks of stackful coroutines.
+/**
+ * The @c pooled_stack_allocator class satisfies the stack-allocator concept
+ * defined by the Boost.Context library. Stacks are obtained directly from the
+ * operating system, and are kept in a pool for reuse when their coroutines
+ * finish, so that starting a short-lived coroutine costs about as much as a
+ * heap allocation rather than a pair of system calls and a round of page
+ * faults. Copies of an allocator share the same pool.
+ *
+ * A stack may optionally be protected by a guard page, so that overflowing
+ * it faults instead of silently corrupting memory. Guard pages are supported
+ * on POSIX platforms.
+ *
+ * An allocator may also track how much of each stack is used, by filling new
+ * stacks with a known value and checking how much of it has been overwritten
+ * when a stack is returned to the pool. The greatest usage seen is available
+ * from high_watermark(), as a guide to choosing a safe stack size.
+ *
+ * Stacks are first touched by the thread that runs the coroutine. Creating
+ * one allocator for each thread that runs coroutines keeps the stacks in each
+ * pool local to the NUMA node of that thread.
+ *
+ * @par Example
+ * @code
+ * boost::asio::pooled_stack_allocator stacks(64 * 1024, 128,
+ *     boost::asio::pooled_stack_allocator::guard_page);
+ *
+ * boost::asio::spawn(my_strand, std::allocator_arg, stacks,
+ *     do_request, boost::asio::detached);
+ * @endcode
+ */
+class pooled_stack_allocator
+{
+public:
+  /// Bitmask type for the options that control how stacks are allocated.
+  typedef int flags;
+
+  /// Protect the lowest page of each stack from access.
+  static constexpr int guard_page = 1;
+
+  /// Track the greatest amount of stack that is used.
+  static constexpr int track_usage = 2;
+
+  /// Construct an allocator with its own pool.
+  /**
+   * @param stack_size The usable size of each stack, in bytes. It is rounded
+   * up to a whole number of pages.
+   *
+   * @param max_pooled The maximum number of stacks that are kept in the pool
+   * for reuse. Stacks returned when the pool is full are freed.
+   *
+   * @param options A bitmask of the flags that control how stacks are
+   * allocated.
+   */
+  explicit pooled_stack_allocator(
+      std::size_t stack_size = boost::context::stack_traits::default_size(),
+      std::size_t max_pooled = 64, flags options = guard_page)
+    : pool_(detail::make_shared<detail::stack_pool>(stack_size, max_pooled,
+          (options & guard_page) != 0, (options & track_usage) != 0))
+  {
+  }
+
+  /// Allocate a stack.
+  boost::context::stack_context allocate()
+  {
+    boost::context::stack_context sctx;
+    sctx.size = pool_->mapped_size();
+    sctx.sp = pool_->allocate();
+    return sctx;
+  }
+
+  /// Return a stack to the pool.
+  void deallocate(boost::context::stack_context& sctx) noexcept
+  {
+    pool_->deallocate(sctx.sp);
+  }
+
+  /// Get the number of stacks currently held in the pool for reuse.
+  std::size_t pooled() const
+  {
+    return pool_->pooled();
+  }
+
+  /// Get the greatest number of bytes used by any stack.
+  /**
+   * Only stacks that have been returned to the allocator are included.
+   * Returns 0 unless the allocator was constructed with the @c track_usage
+   * flag.
+   */
+  std::size_t high_watermark() const noexcept
+  {
+    return pool_->high_watermark();
+  }
+
+private:
+  detail::shared_ptr<detail::stack_pool> pool_;
+};
+
+#endif // defined(BOOST_ASIO_HAS_BOOST_CONTEXT_FIBER)
+       //   || defined(GENERATING_DOCUMENTATION)
+
 /**
  * @defgroup spawn boost::asio::spawn
  *
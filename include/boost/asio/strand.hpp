@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/chrono.hpp>
 #include <boost/asio/detail/strand_executor_service.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 #include <boost/asio/execution/blocking.hpp>
@@ -345,6 +346,77 @@ public:
     return detail::strand_executor_service::running_in_this_thread(impl_);
   }
 
+  /// Limit the number of handlers the strand runs each time it is scheduled.
+  /**
+   * By default, each time the strand is scheduled on the underlying executor
+   * it runs the handlers that were waiting at that point. Handlers submitted
+   * while they run cause the strand to be scheduled again, which hands it
+   * back to the underlying executor and possibly to another thread.
+   *
+   * With a quantum, the strand instead keeps running newly submitted
+   * handlers on the same thread until it has run @c max_handlers handlers,
+   * after which any remaining handlers are handed off. This improves cache
+   * locality for busy strands, at the expense of fairness to other work
+   * queued on the underlying executor.
+   *
+   * @param max_handlers The maximum number of handlers to run each time the
+   * strand is scheduled. A value of 0 restores the default behaviour.
+   *
+   * @note The quantum is shared by all copies of the strand.
+   */
+  void set_quantum(std::size_t max_handlers)
+  {
+    detail::strand_executor_service::set_quantum(impl_, max_handlers, 0);
+  }
+
+  /// Limit the number of handlers, and the time, the strand runs each time it
+  /// is scheduled.
+  /**
+   * As for set_quantum(std::size_t), except that the strand also hands off
+   * the remaining handlers once it has spent at least @c max_time running
+   * handlers.
+   *
+   * @param max_handlers The maximum number of handlers to run each time the
+   * strand is scheduled. A value of 0 disables the handler limit.
+   *
+   * @param max_time The maximum time to spend running handlers each time the
+   * strand is scheduled. A zero duration disables the time limit.
+   *
+   * @note When both limits are disabled, the strand returns to the default
+   * behaviour.
+   */
+  template <typename Rep, typename Period>
+  void set_quantum(std::size_t max_handlers,
+      const chrono::duration<Rep, Period>& max_time)
+  {
+    detail::strand_executor_service::set_quantum(impl_, max_handlers,
+        static_cast<long>(
+          chrono::duration_cast<chrono::microseconds>(max_time).count()));
+  }
+
+  /// Get the number of handlers waiting on the strand.
+  /**
+   * @return The number of handlers that have been submitted to the strand and
+   * have not yet run. The handlers run since the strand was last scheduled
+   * are included until the strand finishes running, so the value is
+   * approximate while the strand is running.
+   */
+  std::size_t queue_depth() const noexcept
+  {
+    return detail::strand_executor_service::queue_depth(impl_);
+  }
+
+  /// Get the number of times the strand has been handed off.
+  /**
+   * @return The number of times the strand has finished running handlers
+   * while more handlers were waiting, and so has scheduled itself again on
+   * the underlying executor.
+   */
+  std::size_t handoff_count() const noexcept
+  {
+    return detail::strand_executor_service::handoff_count(impl_);
+  }
+
   /// Compare two strands for equality.
   /**
    * Two strands are equal if they refer to the same ordered, non-concurrent
@@ -0,0 +1,67 @@
+//
+// timer_wheel_traits.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
+#define BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/wait_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Wait traits that keep timers in a hierarchical timing wheel.
+/**
+ * By default, the pending waits of all timers of a given type are ordered in
+ * a heap, so starting, cancelling and re-arming a wait take time logarithmic
+ * in the number of timers. Timers that use these wait traits are instead
+ * hashed into a hierarchical timing wheel, where these operations take
+ * constant time. This suits programs with very many timers that are re-armed
+ * far more often than they expire, such as per-connection idle timeouts.
+ *
+ * Expiry times are rounded up to a whole number of ticks, so a wait may
+ * complete up to one tick later than it would with the default traits. It
+ * never completes early.
+ *
+ * @tparam Clock The clock type.
+ *
+ * @tparam TickMicroseconds The granularity of the wheel, in microseconds.
+ * Must be greater than zero.
+ *
+ * @par Example
+ * @code
+ * typedef boost::asio::basic_waitable_timer<
+ *     boost::asio::chrono::steady_clock,
+ *     boost::asio::timer_wheel_traits<
+ *       boost::asio::chrono::steady_clock>> idle_timer;
+ * @endcode
+ */
+template <typename Clock, long TickMicroseconds = 1000>
+struct timer_wheel_traits
+  : wait_traits<Clock>
+{
+  static_assert(TickMicroseconds > 0, "tick must be positive");
+
+  /// The granularity of the wheel, in microseconds.
+  static constexpr long timer_wheel_tick_usec = TickMicroseconds;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
@@ -0,0 +1,130 @@
+//
+// transfer_file.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_TRANSFER_FILE_HPP
+#define BOOST_ASIO_TRANSFER_FILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_SENDFILE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/**
+ * @defgroup async_transfer_file boost::asio::async_transfer_file
+ *
+ * @brief The @c async_transfer_file function is a composed asynchronous
+ * operation that sends a range of a file on a stream socket, without copying
+ * the data through user space.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to send a range of a file on a stream
+/// socket.
+/**
+ * This function is used to asynchronously send the specified range of a
+ * file's contents on a stream socket. It is an initiating function for an
+ * @ref asynchronous_operation, and always returns immediately. The operation
+ * continues until the whole range has been sent or an error occurs, and
+ * completes once.
+ *
+ * The data is transferred by the kernel: spliced through a pipe where the
+ * io_uring backend is the default, and otherwise sent using @c sendfile each
+ * time the socket becomes writable. This avoids reading each chunk into a
+ * user buffer and then writing it to the socket.
+ *
+ * @param file The file from which the data is sent, such as a
+ * basic_random_access_file or basic_stream_file. Its native handle must remain
+ * open until the completion handler is called. The file's current position,
+ * if any, is neither used nor changed.
+ *
+ * @param offset The offset within the file at which the range begins.
+ *
+ * @param length The number of bytes to send.
+ *
+ * @param socket The socket to which the data is sent. The socket must remain
+ * valid until the completion handler is called.
+ *
+ * @param token The @ref completion_token that will be used to produce a
+ * completion handler, which will be called when the transfer completes.
+ * Potential completion tokens include @ref use_future, @ref use_awaitable,
+ * @ref yield_context, or a function object with the correct completion
+ * signature. The function signature of the completion handler must be:
+ * @code void handler(
+ *   // Result of operation.
+ *   const boost::system::error_code& error,
+ *
+ *   // Number of bytes sent. If an error occurred, this is the number of
+ *   // bytes sent before the failure.
+ *   std::size_t bytes_transferred
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the completion handler will not be invoked from within this function.
+ * On immediate completion, invocation of the handler will be performed in a
+ * manner equivalent to using boost::asio::post().
+ *
+ * @par Completion Signature
+ * @code void(boost::system::error_code, std::size_t) @endcode
+ *
+ * @par Example
+ * @code
+ * boost::asio::random_access_file file(ctx, "index.html",
+ *     boost::asio::random_access_file::read_only);
+ * boost::asio::async_transfer_file(file, 0, file.size(), socket, handler);
+ * @endcode
+ *
+ * @par Per-Operation Cancellation
+ * This asynchronous operation supports cancellation for the following
+ * boost::asio::cancellation_type values:
+ *
+ * @li @c cancellation_type::terminal
+ *
+ * @li @c cancellation_type::partial
+ *
+ * @li @c cancellation_type::total
+ */
+template <typename File, typename Protocol, typename Executor,
+    BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code,
+      std::size_t)) WriteToken = default_completion_token_t<Executor>>
+inline auto async_transfer_file(File& file, uint64_t offset, uint64_t length,
+    basic_stream_socket<Protocol, Executor>& socket,
+    WriteToken&& token = default_completion_token_t<Executor>())
+  -> decltype(
+    socket.async_send_file(file, offset, length,
+      static_cast<WriteToken&&>(token)))
+{
+  return socket.async_send_file(file, offset, length,
+      static_cast<WriteToken&&>(token));
+}
+
+/*@}*/
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_TRANSFER_FILE_HPP
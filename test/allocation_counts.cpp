@@ -0,0 +1,617 @@
+//
+// allocation_counts.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Route the library's own aligned allocations through operator new, so that
+// they are counted below.
+#define BOOST_ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+#define BOOST_ASIO_DISABLE_BOOST_ALIGN 1
+
+#include <boost/asio/any_completion_executor.hpp>
+#include <boost/asio/any_completion_handler.hpp>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/deferred.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/experimental/parallel_group.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <array>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// Every allocation made through the global operator new is counted, so that
+// the number of allocations made by each asynchronous operation can be
+// checked against a budget.
+
+namespace allocation_counts {
+
+struct heap_usage
+{
+  std::size_t allocations;
+  std::size_t bytes;
+};
+
+static heap_usage counted = { 0, 0 };
+
+static void* counted_alloc(std::size_t size)
+{
+  ++counted.allocations;
+  counted.bytes += size;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+} // namespace allocation_counts
+
+// GCC cannot see that the replacement operators below pair malloc with free.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+# pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif // defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+
+void* operator new(std::size_t size)
+{
+  return allocation_counts::counted_alloc(size);
+}
+
+void* operator new[](std::size_t size)
+{
+  return allocation_counts::counted_alloc(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+//------------------------------------------------------------------------------
+
+namespace allocation_counts {
+
+using boost::asio::steady_timer;
+using boost::system::error_code;
+
+// The number of operations run before counting starts, to let the recycling
+// caches fill, and the number of operations that are counted.
+constexpr std::size_t warmup = 16;
+constexpr std::size_t iterations = 256;
+
+// Drives one cell of the matrix: an operation is started, and started again
+// from its completion handler, until enough operations have been counted.
+class meter
+{
+public:
+  explicit meter(const char* name)
+    : name_(name),
+      count_(0),
+      start_(counted),
+      end_(counted)
+  {
+  }
+
+  // Called before starting each operation. Returns false when all of the
+  // operations have run.
+  bool next()
+  {
+    if (count_ == warmup)
+      start_ = counted;
+    if (count_ == warmup + iterations)
+    {
+      end_ = counted;
+      return false;
+    }
+    ++count_;
+    return true;
+  }
+
+  // Check that the operation stayed within its budget of allocations. A
+  // budget of zero requires an allocation-free steady state.
+  void check(std::size_t budget) const
+  {
+    BOOST_ASIO_CHECK(count_ == warmup + iterations);
+
+    std::size_t allocations = end_.allocations - start_.allocations;
+    std::size_t bytes = end_.bytes - start_.bytes;
+
+    BOOST_ASIO_TEST_IOSTREAM << "  " << name_ << ": "
+      << static_cast<double>(allocations) / iterations << " allocations, "
+      << static_cast<double>(bytes) / iterations << " bytes per operation"
+      << std::endl;
+
+#if defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING) \
+  || defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+    // Memory is not recycled in this build, so the budgets are not enforced.
+    BOOST_ASIO_WARN_MESSAGE(allocations <= budget * iterations,
+        name_ << " exceeds its budget of " << budget
+        << " allocations per operation");
+#else // defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+      //   || defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+    BOOST_ASIO_CHECK_MESSAGE(allocations <= budget * iterations,
+        name_ << " exceeds its budget of " << budget
+        << " allocations per operation");
+#endif // defined(BOOST_ASIO_DISABLE_SMALL_BLOCK_RECYCLING)
+       //   || defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  }
+
+private:
+  const char* name_;
+  std::size_t count_;
+  heap_usage start_;
+  heap_usage end_;
+};
+
+// A completion handler that starts the next operation.
+template <typename Op>
+struct repeat
+{
+  meter* m;
+  Op* op;
+
+  void operator()()
+  {
+    if (m->next())
+      (*op)(*this);
+  }
+
+  void operator()(const error_code&)
+  {
+    (*this)();
+  }
+
+  void operator()(const error_code&, std::size_t)
+  {
+    (*this)();
+  }
+};
+
+// Run an operation repeatedly until it has been counted.
+template <typename Op>
+void run_callbacks(boost::asio::io_context& ioc, const char* name,
+    Op op, std::size_t budget)
+{
+  meter m(name);
+  repeat<Op> r = { &m, &op };
+  r();
+  ioc.restart();
+  ioc.run();
+  m.check(budget);
+}
+
+// An initiating function that erases the type of its completion handler.
+template <typename CompletionToken>
+auto async_erased_wait(steady_timer& timer, CompletionToken&& token)
+  -> decltype(
+    boost::asio::async_initiate<CompletionToken, void(error_code)>(
+      std::declval<void(*)(
+        boost::asio::any_completion_handler<void(error_code)>,
+        steady_timer*)>(), token, &timer))
+{
+  return boost::asio::async_initiate<CompletionToken, void(error_code)>(
+      [](boost::asio::any_completion_handler<void(error_code)> handler,
+        steady_timer* t)
+      {
+        t->async_wait(std::move(handler));
+      }, token, &timer);
+}
+
+//------------------------------------------------------------------------------
+
+struct post_callback
+{
+  boost::asio::io_context* ioc;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    boost::asio::post(*ioc, next);
+  }
+};
+
+struct post_deferred
+{
+  boost::asio::io_context* ioc;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    boost::asio::post(*ioc, boost::asio::deferred)(next);
+  }
+};
+
+struct timer_callback
+{
+  steady_timer* timer;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    timer->expires_at(steady_timer::time_point::min());
+    timer->async_wait(next);
+  }
+};
+
+struct timer_deferred
+{
+  steady_timer* timer;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    timer->expires_at(steady_timer::time_point::min());
+    timer->async_wait(boost::asio::deferred)(next);
+  }
+};
+
+struct timer_any_completion_handler
+{
+  steady_timer* timer;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    timer->expires_at(steady_timer::time_point::min());
+    async_erased_wait(*timer, next);
+  }
+};
+
+struct post_converted_executor
+{
+  boost::asio::any_io_executor ex;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    boost::asio::any_completion_executor converted(ex);
+    BOOST_ASIO_CHECK(converted != nullptr);
+    boost::asio::post(ex, next);
+  }
+};
+
+struct timer_parallel_group
+{
+  steady_timer* timer1;
+  steady_timer* timer2;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    timer1->expires_at(steady_timer::time_point::min());
+    timer2->expires_at(steady_timer::time_point::min());
+    boost::asio::experimental::make_parallel_group(
+        timer1->async_wait(boost::asio::deferred),
+        timer2->async_wait(boost::asio::deferred)
+      ).async_wait(boost::asio::experimental::wait_for_all(),
+        [next](std::array<std::size_t, 2>,
+          error_code, error_code) mutable
+        {
+          next();
+        });
+  }
+};
+
+void post_test()
+{
+  boost::asio::io_context ioc(1);
+
+  post_callback op1 = { &ioc };
+  run_callbacks(ioc, "post, callback", op1, 0);
+
+  post_deferred op2 = { &ioc };
+  run_callbacks(ioc, "post, deferred", op2, 0);
+
+  // Converting an any_io_executor to an any_completion_executor wraps it in
+  // a shared target, whose memory is recycled.
+  post_converted_executor op3 = { ioc.get_executor() };
+  run_callbacks(ioc, "post, converted any_io_executor", op3, 0);
+}
+
+void timer_test()
+{
+  boost::asio::io_context ioc(1);
+  steady_timer timer1(ioc);
+  steady_timer timer2(ioc);
+
+  timer_callback op1 = { &timer1 };
+  run_callbacks(ioc, "steady_timer::async_wait, callback", op1, 0);
+
+  timer_deferred op2 = { &timer1 };
+  run_callbacks(ioc, "steady_timer::async_wait, deferred", op2, 0);
+
+  timer_any_completion_handler op3 = { &timer1 };
+  run_callbacks(ioc,
+      "steady_timer::async_wait, any_completion_handler", op3, 0);
+
+  timer_parallel_group op4 = { &timer1, &timer2 };
+  run_callbacks(ioc, "steady_timer::async_wait, parallel_group", op4, 0);
+}
+
+//------------------------------------------------------------------------------
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+using boost::asio::local::stream_protocol;
+
+// Each operation writes a message on one socket and reads it on the other.
+struct socket_pair
+{
+  explicit socket_pair(boost::asio::io_context& ioc)
+    : writer(ioc),
+      reader(ioc)
+  {
+    boost::asio::local::connect_pair(writer, reader);
+  }
+
+  stream_protocol::socket writer;
+  stream_protocol::socket reader;
+  char write_data[64];
+  char read_data[64];
+};
+
+template <typename Next>
+struct read_after_write
+{
+  socket_pair* s;
+  Next next;
+
+  void operator()(const error_code&, std::size_t)
+  {
+    s->reader.async_read_some(boost::asio::buffer(s->read_data), next);
+  }
+};
+
+struct socket_callback
+{
+  socket_pair* s;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    read_after_write<Next> handler = { s, next };
+    s->writer.async_write_some(boost::asio::buffer(s->write_data), handler);
+  }
+};
+
+struct socket_deferred
+{
+  socket_pair* s;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    socket_pair* sp = s;
+    s->writer.async_write_some(boost::asio::buffer(s->write_data),
+        boost::asio::deferred(
+          [sp](error_code, std::size_t)
+          {
+            return sp->reader.async_read_some(
+                boost::asio::buffer(sp->read_data), boost::asio::deferred);
+          }))(next);
+  }
+};
+
+template <typename Next>
+struct composed_read_after_write
+{
+  socket_pair* s;
+  Next next;
+
+  void operator()(const error_code&, std::size_t)
+  {
+    boost::asio::async_read(s->reader,
+        boost::asio::buffer(s->read_data), next);
+  }
+};
+
+struct composed_callback
+{
+  socket_pair* s;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    composed_read_after_write<Next> handler = { s, next };
+    boost::asio::async_write(s->writer,
+        boost::asio::buffer(s->write_data), handler);
+  }
+};
+
+struct composed_parallel_group
+{
+  socket_pair* s;
+
+  template <typename Next>
+  void operator()(Next next)
+  {
+    boost::asio::experimental::make_parallel_group(
+        boost::asio::async_write(s->writer,
+          boost::asio::buffer(s->write_data), boost::asio::deferred),
+        boost::asio::async_read(s->reader,
+          boost::asio::buffer(s->read_data), boost::asio::deferred)
+      ).async_wait(boost::asio::experimental::wait_for_all(),
+        [next](std::array<std::size_t, 2>, error_code, std::size_t,
+          error_code, std::size_t) mutable
+        {
+          next();
+        });
+  }
+};
+
+void socket_test()
+{
+  boost::asio::io_context ioc(1);
+  socket_pair s(ioc);
+
+  socket_callback op1 = { &s };
+  run_callbacks(ioc, "async_read_some, callback", op1, 0);
+
+  socket_deferred op2 = { &s };
+  run_callbacks(ioc, "async_read_some, deferred", op2, 0);
+
+  composed_callback op3 = { &s };
+  run_callbacks(ioc, "async_read, callback", op3, 0);
+
+  composed_parallel_group op4 = { &s };
+  run_callbacks(ioc, "async_read, parallel_group", op4, 0);
+}
+
+#else // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+void socket_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+//------------------------------------------------------------------------------
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+using boost::asio::awaitable;
+using boost::asio::use_awaitable;
+
+awaitable<void> post_awaitable(meter& m)
+{
+  auto ex = co_await boost::asio::this_coro::executor;
+  while (m.next())
+    co_await boost::asio::post(ex, use_awaitable);
+}
+
+awaitable<void> timer_awaitable(meter& m, steady_timer& timer)
+{
+  while (m.next())
+  {
+    timer.expires_at(steady_timer::time_point::min());
+    co_await timer.async_wait(use_awaitable);
+  }
+}
+
+awaitable<void> timer_erased_awaitable(meter& m, steady_timer& timer)
+{
+  while (m.next())
+  {
+    timer.expires_at(steady_timer::time_point::min());
+    co_await async_erased_wait(timer, use_awaitable);
+  }
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+awaitable<void> socket_awaitable(meter& m, socket_pair& s)
+{
+  while (m.next())
+  {
+    co_await s.writer.async_write_some(
+        boost::asio::buffer(s.write_data), use_awaitable);
+    co_await s.reader.async_read_some(
+        boost::asio::buffer(s.read_data), use_awaitable);
+  }
+}
+
+awaitable<void> composed_awaitable(meter& m, socket_pair& s)
+{
+  while (m.next())
+  {
+    co_await boost::asio::async_write(s.writer,
+        boost::asio::buffer(s.write_data), use_awaitable);
+    co_await boost::asio::async_read(s.reader,
+        boost::asio::buffer(s.read_data), use_awaitable);
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+// Run a coroutine that loops over an operation until it has been counted.
+template <typename Coroutine>
+void run_coroutine(boost::asio::io_context& ioc, const char* name,
+    Coroutine coroutine, std::size_t budget)
+{
+  meter m(name);
+  boost::asio::co_spawn(ioc, coroutine(m), boost::asio::detached);
+  ioc.restart();
+  ioc.run();
+  m.check(budget);
+}
+
+void awaitable_test()
+{
+  boost::asio::io_context ioc(1);
+  steady_timer timer(ioc);
+
+  run_coroutine(ioc, "post, use_awaitable",
+      [](meter& m){ return post_awaitable(m); }, 0);
+
+  run_coroutine(ioc, "steady_timer::async_wait, use_awaitable",
+      [&](meter& m){ return timer_awaitable(m, timer); }, 0);
+
+  run_coroutine(ioc,
+      "steady_timer::async_wait, any_completion_handler, use_awaitable",
+      [&](meter& m){ return timer_erased_awaitable(m, timer); }, 0);
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  socket_pair s(ioc);
+
+  run_coroutine(ioc, "async_read_some, use_awaitable",
+      [&](meter& m){ return socket_awaitable(m, s); }, 0);
+
+  run_coroutine(ioc, "async_read, use_awaitable",
+      [&](meter& m){ return composed_awaitable(m, s); }, 0);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+#else // defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+void awaitable_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+} // namespace allocation_counts
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "allocation_counts",
+  BOOST_ASIO_TEST_CASE(allocation_counts::post_test)
+  BOOST_ASIO_TEST_CASE(allocation_counts::timer_test)
+  BOOST_ASIO_TEST_CASE(allocation_counts::socket_test)
+  BOOST_ASIO_TEST_CASE(allocation_counts::awaitable_test)
+)
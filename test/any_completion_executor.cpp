@@ -18,6 +18,9 @@
 
 #include <cstring>
 #include <functional>
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/system_executor.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include "unit_test.hpp"
@@ -453,6 +456,61 @@ void any_completion_executor_execute_test()
   BOOST_ASIO_CHECK(count == 5);
 }
 
+void any_completion_executor_conversion_test()
+{
+  int count = 0;
+  io_context ioc;
+  boost::asio::nullptr_t null_ptr = boost::asio::nullptr_t();
+  boost::asio::any_io_executor io_ex(ioc.get_executor());
+  boost::asio::any_completion_executor saved;
+
+  // Converting inside a running io_context takes the shared target's memory
+  // from the thread's recycling cache.
+  boost::asio::post(ioc,
+      [&]()
+      {
+        boost::asio::any_completion_executor ex1(io_ex);
+
+        BOOST_ASIO_CHECK(ex1.target<void>() != 0);
+        BOOST_ASIO_CHECK(ex1 != null_ptr);
+
+        boost::asio::any_completion_executor ex2(std::nothrow, io_ex);
+
+        BOOST_ASIO_CHECK(ex2.target<void>() != 0);
+        BOOST_ASIO_CHECK(ex2 != null_ptr);
+        BOOST_ASIO_CHECK(ex2 == ex1);
+
+        // The io_context's executor runs the function immediately.
+        ex1.execute(bindns::bind(increment, &count));
+        BOOST_ASIO_CHECK(count == 1);
+
+        saved = ex2;
+      });
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+  BOOST_ASIO_CHECK(saved != null_ptr);
+
+  // A converted executor remains usable, and is destroyed, outside the
+  // io_context.
+  saved.execute(bindns::bind(increment, &count));
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 2);
+
+  saved = null_ptr;
+  BOOST_ASIO_CHECK(saved == null_ptr);
+
+  // Converting outside any io_context also succeeds.
+  boost::asio::any_completion_executor ex3(io_ex);
+
+  BOOST_ASIO_CHECK(ex3.target<void>() != 0);
+  BOOST_ASIO_CHECK(ex3 != null_ptr);
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "any_completion_executor",
@@ -462,4 +520,5 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(any_completion_executor_swap_test)
   BOOST_ASIO_TEST_CASE(any_completion_executor_query_test)
   BOOST_ASIO_TEST_CASE(any_completion_executor_execute_test)
+  BOOST_ASIO_TEST_CASE(any_completion_executor_conversion_test)
 )
@@ -56,6 +56,20 @@ struct concrete_handler<R(Arg1, Arg2)>
   }
 };
 
+template <typename R, typename Arg1, typename Arg2, typename Arg3>
+struct concrete_handler<R(Arg1, Arg2, Arg3)>
+{
+  concrete_handler()
+  {
+  }
+
+  void operator()(typename boost::asio::decay<Arg1>::type,
+      typename boost::asio::decay<Arg2>::type,
+      typename boost::asio::decay<Arg3>::type)
+  {
+  }
+};
+
 template <typename Signature>
 struct immediate_concrete_handler : concrete_handler<Signature>
 {
@@ -18,8 +18,143 @@
 
 #include "unit_test.hpp"
 
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/detail/thread.hpp>
+
+boost::asio::awaitable<int> nested_coroutine(int depth)
+{
+  // Give the frames a size typical of coroutines that keep some local state.
+  char padding[64];
+  padding[0] = static_cast<char>(depth);
+  if (depth > 0)
+    co_return padding[0] + co_await nested_coroutine(depth - 1);
+  co_await boost::asio::post(boost::asio::use_awaitable);
+  co_return padding[0];
+}
+
+boost::asio::awaitable<void> request_loop(int requests, int* total)
+{
+  for (int i = 0; i < requests; ++i)
+    *total += co_await nested_coroutine(6);
+}
+
+void awaitable_frame_pool_test()
+{
+  using boost::asio::awaitable_frame_statistics;
+  using boost::asio::get_awaitable_frame_statistics;
+
+  boost::asio::io_context ioc;
+  int total = 0;
+
+  awaitable_frame_statistics before = get_awaitable_frame_statistics();
+
+  boost::asio::co_spawn(ioc, request_loop(1000, &total),
+      boost::asio::detached);
+  ioc.run();
+
+  awaitable_frame_statistics after = get_awaitable_frame_statistics();
+
+  BOOST_ASIO_CHECK(total == 1000 * 21);
+
+  // After the first request, every frame in the call chain is reused from
+  // the pool rather than allocated from the heap.
+  std::size_t allocations = (after.hits - before.hits)
+    + (after.misses - before.misses);
+  BOOST_ASIO_CHECK(allocations >= 1000 * 7);
+  BOOST_ASIO_CHECK(after.misses - before.misses <= 10);
+  BOOST_ASIO_CHECK(after.bytes - before.bytes >= allocations * 64);
+}
+
+void awaitable_frame_statistics_live_test()
+{
+  using boost::asio::awaitable_frame_statistics;
+  using boost::asio::get_awaitable_frame_statistics;
+
+  boost::asio::io_context ioc;
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+    work = boost::asio::make_work_guard(ioc);
+  int total = 0;
+  std::atomic<bool> done(false);
+
+  awaitable_frame_statistics before = get_awaitable_frame_statistics();
+
+  boost::asio::co_spawn(ioc, request_loop(100, &total),
+      [&done](std::exception_ptr) { done = true; });
+  boost::asio::detail::thread runner([&ioc]{ ioc.run(); });
+
+  while (!done)
+    std::this_thread::yield();
+
+  // The frames allocated by the thread are counted while it is still running
+  // the io_context.
+  awaitable_frame_statistics after = get_awaitable_frame_statistics();
+  std::size_t allocations = (after.hits - before.hits)
+    + (after.misses - before.misses);
+  BOOST_ASIO_CHECK(allocations >= 100 * 7);
+
+  work.reset();
+  runner.join();
+  BOOST_ASIO_CHECK(total == 100 * 21);
+}
+
+void awaitable_frame_statistics_depot_test()
+{
+  using boost::asio::awaitable_frame_statistics;
+  using boost::asio::get_awaitable_frame_statistics;
+
+  // Frames pooled by a thread are handed to the shared depot when the thread
+  // stops running the io_context.
+  {
+    boost::asio::io_context ioc;
+    int total = 0;
+    boost::asio::co_spawn(ioc, request_loop(10, &total),
+        boost::asio::detached);
+    ioc.run();
+  }
+
+  awaitable_frame_statistics before = get_awaitable_frame_statistics();
+
+  // A thread that is not running an io_context takes a frame from the depot,
+  // which is counted as a hit.
+  {
+    boost::asio::awaitable<int> a = nested_coroutine(0);
+  }
+
+  awaitable_frame_statistics after = get_awaitable_frame_statistics();
+  BOOST_ASIO_CHECK(after.hits - before.hits == 1);
+  BOOST_ASIO_CHECK(after.misses == before.misses);
+}
+
+#else // defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+void awaitable_frame_pool_test()
+{
+}
+
+void awaitable_frame_statistics_live_test()
+{
+}
+
+void awaitable_frame_statistics_depot_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_CO_AWAIT)
+
 BOOST_ASIO_TEST_SUITE
 (
   "awaitable",
-  BOOST_ASIO_TEST_CASE(null_test)
+  BOOST_ASIO_TEST_CASE(awaitable_frame_pool_test)
+  BOOST_ASIO_TEST_CASE(awaitable_frame_statistics_live_test)
+  BOOST_ASIO_TEST_CASE(awaitable_frame_statistics_depot_test)
 )
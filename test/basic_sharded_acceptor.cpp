@@ -0,0 +1,186 @@
+//
+// basic_sharded_acceptor.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/basic_sharded_acceptor.hpp>
+
+#include <functional>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// basic_sharded_acceptor_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that all public member functions on the class
+// basic_sharded_acceptor compile and link correctly. Runtime failures are
+// ignored.
+
+namespace basic_sharded_acceptor_compile {
+
+void test()
+{
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+  try
+  {
+    io_context_group group(2, false);
+    io_context ioc;
+    io_context::executor_type executors[2] =
+      { ioc.get_executor(), ioc.get_executor() };
+    boost::system::error_code ec;
+
+    // basic_sharded_acceptor constructors.
+
+    basic_sharded_acceptor<ip::tcp> acceptor1(group,
+        ip::tcp::endpoint(ip::tcp::v4(), 0));
+    basic_sharded_acceptor<ip::tcp> acceptor2(group,
+        ip::tcp::endpoint(ip::tcp::v4(), 0), true, 16);
+    basic_sharded_acceptor<ip::tcp, io_context::executor_type> acceptor3(
+        executors, executors + 2, ip::tcp::endpoint(ip::tcp::v4(), 0));
+    basic_sharded_acceptor<ip::tcp> acceptor4(std::move(acceptor2));
+
+    // basic_sharded_acceptor operators.
+
+    acceptor1 = std::move(acceptor4);
+
+    // basic_sharded_acceptor functions.
+
+    std::size_t n = acceptor1.size();
+    (void)n;
+
+    basic_sharded_acceptor<ip::tcp>::acceptor_type& a1 = acceptor1.shard(0);
+    (void)a1;
+
+    const basic_sharded_acceptor<ip::tcp>& const_acceptor1 = acceptor1;
+    const basic_sharded_acceptor<ip::tcp>::acceptor_type& a2
+      = const_acceptor1.shard(0);
+    (void)a2;
+
+    ip::tcp::endpoint ep = acceptor1.local_endpoint();
+    (void)ep;
+
+    acceptor1.cancel();
+    acceptor1.close();
+    acceptor3.close(ec);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+} // namespace basic_sharded_acceptor_compile
+
+//------------------------------------------------------------------------------
+
+// basic_sharded_acceptor_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that connections to the shared endpoint are
+// accepted by the shards.
+
+namespace basic_sharded_acceptor_runtime {
+
+using namespace boost::asio;
+namespace ip = boost::asio::ip;
+
+typedef basic_sharded_acceptor<ip::tcp> acceptor_set;
+
+struct accept_loop
+{
+  acceptor_set::acceptor_type* acceptor_;
+  boost::asio::detail::atomic_count* accepted_;
+
+  void start()
+  {
+    acceptor_->async_accept(*this);
+  }
+
+  void operator()(const boost::system::error_code& ec, ip::tcp::socket)
+  {
+    if (!ec)
+    {
+      ++(*accepted_);
+      start();
+    }
+  }
+};
+
+void close_shard(acceptor_set* acceptors, std::size_t index)
+{
+  boost::system::error_code ec;
+  acceptors->shard(index).close(ec);
+}
+
+void test()
+{
+  io_context_group group(2, false);
+  acceptor_set acceptors(group,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  BOOST_ASIO_CHECK(acceptors.size() == 2);
+  BOOST_ASIO_CHECK(acceptors.local_endpoint().port() != 0);
+  BOOST_ASIO_CHECK(acceptors.shard(0).local_endpoint()
+      == acceptors.shard(1).local_endpoint());
+
+  boost::asio::detail::atomic_count accepted(0);
+  for (std::size_t i = 0; i < acceptors.size(); ++i)
+  {
+    accept_loop loop = { &acceptors.shard(i), &accepted };
+    boost::asio::post(acceptors.shard(i).get_executor(),
+        std::bind(&accept_loop::start, loop));
+  }
+
+  io_context ioc;
+  const int num_clients = 8;
+  ip::tcp::socket clients[num_clients] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc),
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc) };
+  for (int i = 0; i < num_clients; ++i)
+    clients[i].connect(acceptors.local_endpoint());
+
+  for (int i = 0; i < 1000 && accepted < num_clients; ++i)
+  {
+    steady_timer timer(ioc, boost::asio::chrono::milliseconds(10));
+    timer.wait();
+  }
+
+  BOOST_ASIO_CHECK(accepted == num_clients);
+
+  for (std::size_t i = 0; i < acceptors.size(); ++i)
+  {
+    boost::asio::post(acceptors.shard(i).get_executor(),
+        std::bind(close_shard, &acceptors, i));
+  }
+
+  group.join();
+}
+
+} // namespace basic_sharded_acceptor_runtime
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "basic_sharded_acceptor",
+  BOOST_ASIO_COMPILE_TEST_CASE(basic_sharded_acceptor_compile::test)
+  BOOST_ASIO_TEST_CASE(basic_sharded_acceptor_runtime::test)
+)
@@ -0,0 +1,98 @@
+//
+// buffer_lease.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/buffer_lease.hpp>
+
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// buffer_lease_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a buffer_lease returns its buffer exactly
+// once, however ownership is transferred.
+
+namespace buffer_lease_runtime {
+
+void count_release(void* owner, unsigned int id, void* data)
+{
+  BOOST_ASIO_CHECK(id == 42);
+  BOOST_ASIO_CHECK(data != 0);
+  ++*static_cast<int*>(owner);
+}
+
+void test()
+{
+  using boost::asio::buffer_lease;
+
+  char data[16] = "0123456789";
+  int releases = 0;
+
+  buffer_lease lease1;
+  BOOST_ASIO_CHECK(!lease1.valid());
+  BOOST_ASIO_CHECK(lease1.size() == 0);
+  BOOST_ASIO_CHECK(lease1.data().size() == 0);
+  lease1.release();
+
+  {
+    buffer_lease lease2(&count_release, &releases, 42, data, 10);
+    BOOST_ASIO_CHECK(lease2.valid());
+    BOOST_ASIO_CHECK(lease2.size() == 10);
+    BOOST_ASIO_CHECK(lease2.data().data() == data);
+    BOOST_ASIO_CHECK(lease2.data().size() == 10);
+
+    buffer_lease lease3(static_cast<buffer_lease&&>(lease2));
+    BOOST_ASIO_CHECK(!lease2.valid());
+    BOOST_ASIO_CHECK(lease2.size() == 0);
+    BOOST_ASIO_CHECK(lease3.valid());
+    BOOST_ASIO_CHECK(lease3.size() == 10);
+
+    lease1 = static_cast<buffer_lease&&>(lease3);
+    BOOST_ASIO_CHECK(!lease3.valid());
+    BOOST_ASIO_CHECK(lease1.valid());
+    BOOST_ASIO_CHECK(releases == 0);
+  }
+
+  BOOST_ASIO_CHECK(releases == 0);
+
+  lease1 = buffer_lease(&count_release, &releases, 42, data, 5);
+  BOOST_ASIO_CHECK(releases == 1);
+  BOOST_ASIO_CHECK(lease1.size() == 5);
+
+  lease1.release();
+  BOOST_ASIO_CHECK(releases == 2);
+  BOOST_ASIO_CHECK(!lease1.valid());
+  BOOST_ASIO_CHECK(lease1.size() == 0);
+
+  lease1.release();
+  BOOST_ASIO_CHECK(releases == 2);
+
+  {
+    buffer_lease lease4(&count_release, &releases, 42, data, 10);
+  }
+
+  BOOST_ASIO_CHECK(releases == 3);
+}
+
+} // namespace buffer_lease_runtime
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "buffer_lease",
+  BOOST_ASIO_TEST_CASE(buffer_lease_runtime::test)
+)
@@ -0,0 +1,209 @@
+//
+// connection_arena.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/connection_arena.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <boost/asio/bind_allocator.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/write.hpp>
+#include "unit_test.hpp"
+
+void connection_arena_reuse_test()
+{
+  boost::asio::connection_arena arena(1024);
+  BOOST_ASIO_CHECK(arena.bytes_reserved() == 0);
+
+  // Memory returned to the arena is reused for allocations of a similar
+  // size, without obtaining more memory from the heap.
+  void* p1 = arena.allocate(100);
+  void* p2 = arena.allocate(200);
+  std::size_t reserved = arena.bytes_reserved();
+  BOOST_ASIO_CHECK(reserved >= 1024);
+  arena.deallocate(p1, 100);
+  arena.deallocate(p2, 200);
+  for (int i = 0; i < 100; ++i)
+  {
+    void* q1 = arena.allocate(120);
+    void* q2 = arena.allocate(150);
+    BOOST_ASIO_CHECK(q1 == p1);
+    BOOST_ASIO_CHECK(q2 == p2);
+    arena.deallocate(q2, 150);
+    arena.deallocate(q1, 120);
+  }
+  BOOST_ASIO_CHECK(arena.bytes_reserved() == reserved);
+
+  // Allocations that do not fit in a block get a block of their own.
+  void* p3 = arena.allocate(4000);
+  BOOST_ASIO_CHECK(arena.bytes_reserved() > reserved + 4000);
+  arena.deallocate(p3, 4000);
+
+  // Over-aligned and very large allocations go directly to the heap.
+  reserved = arena.bytes_reserved();
+  void* p4 = arena.allocate(64, 256);
+  BOOST_ASIO_CHECK(reinterpret_cast<std::size_t>(p4) % 256 == 0);
+  void* p5 = arena.allocate(1 << 20);
+  BOOST_ASIO_CHECK(arena.bytes_reserved() == reserved);
+  arena.deallocate(p4, 64, 256);
+  arena.deallocate(p5, 1 << 20);
+}
+
+void connection_arena_allocator_test()
+{
+  boost::asio::connection_arena arena1;
+  boost::asio::connection_arena arena2;
+
+  boost::asio::connection_arena::allocator_type a1 = arena1.get_allocator();
+  boost::asio::connection_arena_allocator<int> a2(a1);
+  boost::asio::connection_arena_allocator<int> a3(arena2);
+
+  BOOST_ASIO_CHECK(a1 == boost::asio::connection_arena::allocator_type(a2));
+  BOOST_ASIO_CHECK(a2 != a3);
+
+  std::vector<int, boost::asio::connection_arena_allocator<int> > v(a2);
+  for (int i = 0; i < 100; ++i)
+    v.push_back(i);
+  BOOST_ASIO_CHECK(v.size() == 100);
+  BOOST_ASIO_CHECK(arena1.bytes_reserved() > 0);
+  BOOST_ASIO_CHECK(arena2.bytes_reserved() == 0);
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+void connection_arena_composed_op_test()
+{
+  using boost::asio::local::stream_protocol;
+
+  boost::asio::io_context ioc;
+  stream_protocol::socket s1(ioc);
+  stream_protocol::socket s2(ioc);
+  boost::asio::local::connect_pair(s1, s2);
+
+  boost::asio::connection_arena arena;
+  std::string line;
+  char data[5];
+  std::size_t reserved = 0;
+
+  // Repeated reads and writes on the same connection reach a steady state
+  // in which no more memory is taken from the heap.
+  for (int i = 0; i < 10; ++i)
+  {
+    int completed = 0;
+    boost::asio::async_write(s1,
+        boost::asio::buffer("hello\nworld", 11),
+        boost::asio::bind_allocator(arena.get_allocator(),
+          [&](const boost::system::error_code& ec, std::size_t n)
+          {
+            BOOST_ASIO_CHECK(!ec);
+            BOOST_ASIO_CHECK(n == 11);
+            ++completed;
+          }));
+    boost::asio::async_read_until(s2,
+        boost::asio::dynamic_buffer(line), '\n',
+        boost::asio::bind_allocator(arena.get_allocator(),
+          [&](const boost::system::error_code& ec, std::size_t n)
+          {
+            BOOST_ASIO_CHECK(!ec);
+            line.erase(0, n);
+            boost::asio::async_read(s2,
+                boost::asio::buffer(data,
+                  sizeof(data) - (std::min)(line.size(), sizeof(data))),
+                boost::asio::bind_allocator(arena.get_allocator(),
+                  [&](const boost::system::error_code& ec2, std::size_t)
+                  {
+                    BOOST_ASIO_CHECK(!ec2);
+                    line.clear();
+                    ++completed;
+                  }));
+          }));
+
+    ioc.restart();
+    ioc.run();
+    BOOST_ASIO_CHECK(completed == 2);
+
+    if (i == 0)
+      reserved = arena.bytes_reserved();
+  }
+
+  BOOST_ASIO_CHECK(reserved > 0);
+  BOOST_ASIO_CHECK(arena.bytes_reserved() == reserved);
+}
+
+#else // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+void connection_arena_composed_op_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+boost::asio::awaitable<int> arena_coroutine()
+{
+  co_return 42;
+}
+
+void connection_arena_co_spawn_test()
+{
+  boost::asio::io_context ioc;
+  boost::asio::connection_arena arena;
+
+  // The entry point frame of a spawned thread is allocated using the
+  // allocator associated with its completion handler.
+  int result = 0;
+  for (int i = 0; i < 10; ++i)
+  {
+    boost::asio::co_spawn(ioc, arena_coroutine(),
+        boost::asio::bind_allocator(arena.get_allocator(),
+          [&](std::exception_ptr e, int r)
+          {
+            BOOST_ASIO_CHECK(!e);
+            result += r;
+          }));
+    ioc.restart();
+    ioc.run();
+  }
+
+  BOOST_ASIO_CHECK(result == 420);
+#if !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+  BOOST_ASIO_CHECK(arena.bytes_reserved() > 0);
+#endif // !defined(BOOST_ASIO_DISABLE_AWAITABLE_FRAME_RECYCLING)
+}
+
+#else // defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+void connection_arena_co_spawn_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "connection_arena",
+  BOOST_ASIO_TEST_CASE(connection_arena_reuse_test)
+  BOOST_ASIO_TEST_CASE(connection_arena_allocator_test)
+  BOOST_ASIO_TEST_CASE(connection_arena_composed_op_test)
+  BOOST_ASIO_TEST_CASE(connection_arena_co_spawn_test)
+)
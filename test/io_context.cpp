@@ -16,20 +16,34 @@
 // Test that header file is self-contained.
 #include <boost/asio/io_context.hpp>
 
+#include <atomic>
 #include <functional>
 #include <sstream>
+#include <vector>
 #include <boost/asio/bind_executor.hpp>
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/post.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
 #include <boost/asio/detail/thread.hpp>
 #include "unit_test.hpp"
 
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+# include <boost/asio/detail/io_uring_service.hpp>
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+
 #if defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
 # include <boost/asio/deadline_timer.hpp>
 #else // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
 # include <boost/asio/steady_timer.hpp>
 #endif // defined(BOOST_ASIO_HAS_BOOST_DATE_TIME)
 
+#if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+# include <unistd.h>
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
 using namespace boost::asio;
 namespace bindns = std;
 
@@ -274,6 +288,275 @@ void io_context_test()
   BOOST_ASIO_CHECK(exception_count == 2);
 }
 
+void record_order(std::vector<int>* order, int i)
+{
+  order->push_back(i);
+}
+
+void atomic_increment(std::atomic<int>* count)
+{
+  ++(*count);
+}
+
+void io_context_run_budget_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  // Creating a timer ensures that the reactor task is in the queue.
+  timer t(ioc);
+
+  ioc.set_run_budget(10);
+  for (int i = 0; i < 1000; ++i)
+    boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  ioc.run();
+
+  // The reactor must have been forced to run part way through the handlers.
+  BOOST_ASIO_CHECK(count == 1000);
+  BOOST_ASIO_CHECK(ioc.run_budget_handler_triggers() > 0);
+  BOOST_ASIO_CHECK(ioc.run_budget_time_triggers() == 0);
+
+  // A disabled budget leaves the queue order untouched.
+  io_context::count_type triggers = ioc.run_budget_handler_triggers();
+  ioc.set_run_budget(0);
+  ioc.restart();
+  count = 0;
+  for (int i = 0; i < 1000; ++i)
+    boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 1000);
+  BOOST_ASIO_CHECK(ioc.run_budget_handler_triggers() == triggers);
+
+  // A time limit on its own still runs every handler.
+  ioc.set_run_budget(0, boost::asio::chrono::microseconds(1));
+  ioc.restart();
+  count = 0;
+  for (int i = 0; i < 1000; ++i)
+    boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 1000);
+  BOOST_ASIO_CHECK(ioc.run_budget_handler_triggers() == triggers);
+
+  // Running the task out of turn leaves the order of the handlers unchanged.
+  std::vector<int> order;
+  ioc.set_run_budget(7);
+  ioc.restart();
+  for (int i = 0; i < 1000; ++i)
+    boost::asio::post(ioc, bindns::bind(record_order, &order, i));
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(order.size() == 1000);
+  for (std::size_t i = 0; i < order.size(); ++i)
+    BOOST_ASIO_CHECK(order[i] == static_cast<int>(i));
+  BOOST_ASIO_CHECK(ioc.run_budget_handler_triggers() > triggers);
+
+  // Polling is subject to the budget too.
+  triggers = ioc.run_budget_handler_triggers();
+  ioc.restart();
+  count = 0;
+  for (int i = 0; i < 1000; ++i)
+    boost::asio::post(ioc, bindns::bind(increment, &count));
+
+  ioc.poll();
+
+  BOOST_ASIO_CHECK(count == 1000);
+  BOOST_ASIO_CHECK(ioc.run_budget_handler_triggers() > triggers);
+
+  // Several threads share the task while they run the handlers.
+  std::atomic<int> shared_count(0);
+  ioc.restart();
+  for (int i = 0; i < 100000; ++i)
+    boost::asio::post(ioc, bindns::bind(atomic_increment, &shared_count));
+
+  boost::asio::detail::thread th1(bindns::bind(io_context_run, &ioc));
+  boost::asio::detail::thread th2(bindns::bind(io_context_run, &ioc));
+  boost::asio::detail::thread th3(bindns::bind(io_context_run, &ioc));
+  ioc.run();
+  th1.join();
+  th2.join();
+  th3.join();
+
+  BOOST_ASIO_CHECK(shared_count == 100000);
+}
+
+void record_time(chrono::steady_clock::time_point* t)
+{
+  *t = chrono::steady_clock::now();
+}
+
+void io_context_timer_slack_test()
+{
+  io_context ioc;
+  ioc.set_timer_slack(chrono::milliseconds(50));
+
+  const int num_timers = 10;
+  chrono::steady_clock::time_point completed[num_timers];
+  timer* timers[num_timers];
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int i = 0; i < num_timers; ++i)
+  {
+    timers[i] = new timer(ioc, chronons::milliseconds(i + 1));
+    timers[i]->async_wait(bindns::bind(record_time, &completed[i]));
+  }
+
+  ioc.run();
+
+  // No timer completes early, and the wakeup for the first timer is deferred
+  // until the others have expired, so that all complete in one batch.
+  for (int i = 0; i < num_timers; ++i)
+  {
+    BOOST_ASIO_CHECK(completed[i] - start >= chrono::milliseconds(i + 1));
+    BOOST_ASIO_CHECK(completed[i] - start >= chrono::milliseconds(num_timers));
+    delete timers[i];
+  }
+
+  // With the slack removed, timers still complete.
+  ioc.set_timer_slack(chrono::milliseconds(0));
+  ioc.restart();
+  int count = 0;
+  timer t(ioc, chronons::milliseconds(1));
+  t.async_wait(bindns::bind(increment, &count));
+  ioc.run();
+  BOOST_ASIO_CHECK(count == 1);
+}
+
+#if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+void wait_for_ready_pipes(io_context& ioc, int num_pipes, int* count)
+{
+  std::vector<posix::stream_descriptor*> descriptors;
+  for (int i = 0; i < num_pipes; ++i)
+  {
+    int fds[2];
+    BOOST_ASIO_CHECK(::pipe(fds) == 0);
+    BOOST_ASIO_CHECK(::write(fds[1], "x", 1) == 1);
+    descriptors.push_back(new posix::stream_descriptor(ioc, fds[0]));
+    descriptors.push_back(new posix::stream_descriptor(ioc, fds[1]));
+    descriptors[2 * i]->async_wait(posix::stream_descriptor::wait_read,
+        bindns::bind(increment, count));
+  }
+
+  ioc.restart();
+  ioc.run();
+
+  for (std::size_t i = 0; i < descriptors.size(); ++i)
+    delete descriptors[i];
+}
+
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+void io_context_event_batch_test()
+{
+  io_context ioc;
+  io_context::wait_statistics stats = ioc.get_wait_statistics();
+  BOOST_ASIO_CHECK(stats.waits == 0);
+  BOOST_ASIO_CHECK(stats.events == 0);
+  BOOST_ASIO_CHECK(stats.full_batches == 0);
+
+#if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // More descriptors are ready than fit in the default batch, so the first
+  // wait returns a full batch and the batch grows.
+  std::size_t initial_batch_size = stats.batch_size;
+  const int num_pipes = 200;
+  BOOST_ASIO_CHECK(initial_batch_size < std::size_t(num_pipes));
+
+  int count = 0;
+  wait_for_ready_pipes(ioc, num_pipes, &count);
+  BOOST_ASIO_CHECK(count == num_pipes);
+
+  stats = ioc.get_wait_statistics();
+  BOOST_ASIO_CHECK(stats.waits >= 2);
+  BOOST_ASIO_CHECK(stats.events >= std::size_t(num_pipes));
+  BOOST_ASIO_CHECK(stats.full_batches >= 1);
+  BOOST_ASIO_CHECK(stats.batch_size > initial_batch_size);
+
+  // A configured batch size is applied on the next wait, and the batch does
+  // not grow beyond the configured maximum.
+  ioc.set_event_batch_size(4, 16);
+  io_context::wait_statistics previous_stats = stats;
+  count = 0;
+  wait_for_ready_pipes(ioc, 40, &count);
+  BOOST_ASIO_CHECK(count == 40);
+
+  stats = ioc.get_wait_statistics();
+  BOOST_ASIO_CHECK(stats.waits > previous_stats.waits);
+  BOOST_ASIO_CHECK(stats.events >= previous_stats.events + 40);
+  BOOST_ASIO_CHECK(stats.full_batches > previous_stats.full_batches);
+  BOOST_ASIO_CHECK(stats.batch_size == 16);
+#else // defined(BOOST_ASIO_HAS_EPOLL)
+      //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Without an epoll-based reactor the setting has no effect and the
+  // statistics remain zero.
+  ioc.set_event_batch_size(4, 16);
+  stats = ioc.get_wait_statistics();
+  BOOST_ASIO_CHECK(stats.waits == 0);
+  BOOST_ASIO_CHECK(stats.batch_size == 0);
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void ping_pong(io_context* from, io_context* to, int* count)
+{
+  if (++(*count) < 1000)
+    boost::asio::post(*to, bindns::bind(ping_pong, to, from, count));
+  else
+  {
+    from->stop();
+    to->stop();
+  }
+}
+
+void io_context_cross_context_post_test()
+{
+  io_context ioc1;
+  io_context ioc2;
+  int count = 0;
+
+  // Creating the timers ensures that each thread waits in its context's task,
+  // so that every post to the other context must wake that task.
+  timer t1(ioc1);
+  timer t2(ioc2);
+  executor_work_guard<io_context::executor_type> w1 = make_work_guard(ioc1);
+  executor_work_guard<io_context::executor_type> w2 = make_work_guard(ioc2);
+
+  boost::asio::post(ioc1, bindns::bind(ping_pong, &ioc1, &ioc2, &count));
+
+  boost::asio::detail::thread th1(bindns::bind(io_context_run, &ioc1));
+  boost::asio::detail::thread th2(bindns::bind(io_context_run, &ioc2));
+  th1.join();
+  th2.join();
+
+  BOOST_ASIO_CHECK(count == 1000);
+
+#if defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+  // Every post from a handler is sent from the posting context's ring to the
+  // other context's ring. Polling each context processes the completions of
+  // the final messages sent from it.
+  ioc1.restart();
+  ioc1.poll();
+  ioc2.restart();
+  ioc2.poll();
+
+  using boost::asio::detail::io_uring_service;
+  io_uring_service& s1 = boost::asio::use_service<io_uring_service>(ioc1);
+  io_uring_service& s2 = boost::asio::use_service<io_uring_service>(ioc2);
+  if (s1.msg_ring_supported() && s2.msg_ring_supported())
+  {
+    BOOST_ASIO_CHECK(s1.msg_ring_operations() == 500);
+    BOOST_ASIO_CHECK(s2.msg_ring_operations() == 499);
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_MSG_RING)
+}
+
 class test_service : public boost::asio::io_context::service
 {
 public:
@@ -560,6 +843,10 @@ BOOST_ASIO_TEST_SUITE
 (
   "io_context",
   BOOST_ASIO_TEST_CASE(io_context_test)
+  BOOST_ASIO_TEST_CASE(io_context_run_budget_test)
+  BOOST_ASIO_TEST_CASE(io_context_timer_slack_test)
+  BOOST_ASIO_TEST_CASE(io_context_event_batch_test)
+  BOOST_ASIO_TEST_CASE(io_context_cross_context_post_test)
   BOOST_ASIO_TEST_CASE(io_context_service_test)
   BOOST_ASIO_TEST_CASE(io_context_executor_query_test)
   BOOST_ASIO_TEST_CASE(io_context_executor_execute_test)
@@ -0,0 +1,178 @@
+//
+// io_context_group.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/io_context_group.hpp>
+
+#include <functional>
+#include <boost/asio/post.hpp>
+#include <boost/system/system_error.hpp>
+#include "unit_test.hpp"
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <sys/resource.h>
+# include <unistd.h>
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+using namespace boost::asio;
+namespace bindns = std;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void check_running_in_this_thread(io_context_group* group,
+    std::size_t index, bool* result)
+{
+  *result = group->get_context(index).get_executor().running_in_this_thread();
+}
+
+void io_context_group_test()
+{
+  io_context_group group(3);
+
+  BOOST_ASIO_CHECK(group.size() == 3);
+
+  int counts[3] = { 0, 0, 0 };
+  for (int i = 0; i < 30; ++i)
+  {
+    std::size_t index = static_cast<std::size_t>(i) % group.size();
+    boost::asio::post(group.get_context(index),
+        bindns::bind(increment, &counts[index]));
+  }
+
+  // Handlers run on the thread that owns their context.
+  bool running[3] = { false, false, false };
+  for (std::size_t i = 0; i < group.size(); ++i)
+  {
+    boost::asio::post(group.get_context(i),
+        bindns::bind(check_running_in_this_thread, &group, i, &running[i]));
+  }
+
+  group.join();
+
+  BOOST_ASIO_CHECK(counts[0] == 10);
+  BOOST_ASIO_CHECK(counts[1] == 10);
+  BOOST_ASIO_CHECK(counts[2] == 10);
+  BOOST_ASIO_CHECK(running[0] && running[1] && running[2]);
+}
+
+void io_context_group_executor_test()
+{
+  io_context_group group(4, false);
+
+  for (std::size_t i = 0; i < group.size(); ++i)
+    BOOST_ASIO_CHECK(group.get_cpu(i) == -1);
+
+  // Round-robin selection visits every context.
+  bool seen[4] = { false, false, false, false };
+  for (std::size_t i = 0; i < group.size(); ++i)
+  {
+    io_context::executor_type ex = group.get_executor();
+    for (std::size_t j = 0; j < group.size(); ++j)
+      if (ex == group.get_context(j).get_executor())
+        seen[j] = true;
+  }
+
+  BOOST_ASIO_CHECK(seen[0] && seen[1] && seen[2] && seen[3]);
+
+  // Keyed selection is stable.
+  BOOST_ASIO_CHECK(group.get_executor_for(7) == group.get_executor_for(7));
+  BOOST_ASIO_CHECK(group.get_executor_for(7)
+      == group.get_context(7 % group.size()).get_executor());
+
+  int count = 0;
+  boost::asio::post(group.get_executor_for(42),
+      bindns::bind(increment, &count));
+
+  group.stop();
+  group.join();
+
+  BOOST_ASIO_CHECK(count <= 1);
+}
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+// Get the lowest descriptor number that is not in use.
+int lowest_free_descriptor()
+{
+  int fd = ::dup(STDERR_FILENO);
+  if (fd >= 0)
+    ::close(fd);
+  return fd;
+}
+
+// Try to construct a group while descriptors are limited. Returns true if
+// the constructor reported a system_error.
+bool construct_with_descriptor_limit(rlim_t limit, std::size_t num_contexts)
+{
+  struct rlimit saved;
+  if (::getrlimit(RLIMIT_NOFILE, &saved) != 0)
+    return false;
+
+  struct rlimit limited = saved;
+  limited.rlim_cur = limit;
+  if (::setrlimit(RLIMIT_NOFILE, &limited) != 0)
+    return false;
+
+  bool failed = false;
+  try
+  {
+    io_context_group group(num_contexts, false);
+  }
+  catch (boost::system::system_error&)
+  {
+    failed = true;
+  }
+
+  ::setrlimit(RLIMIT_NOFILE, &saved);
+  return failed;
+}
+
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+void io_context_group_construction_failure_test()
+{
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+  int first_free = lowest_free_descriptor();
+  BOOST_ASIO_CHECK(first_free >= 0);
+
+  // No io_context can create its reactor.
+  BOOST_ASIO_CHECK(construct_with_descriptor_limit(first_free, 4));
+  BOOST_ASIO_CHECK(lowest_free_descriptor() == first_free);
+
+  // Some io_context objects are created, and their threads are started, but
+  // there are too few descriptors for all of them. The threads that started
+  // are stopped and joined, and their io_context objects destroyed.
+  BOOST_ASIO_CHECK(construct_with_descriptor_limit(first_free + 4, 8));
+  BOOST_ASIO_CHECK(lowest_free_descriptor() == first_free);
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+  // A group can still be constructed once descriptors are available.
+  io_context_group group(2, false);
+  int count = 0;
+  boost::asio::post(group.get_context(0), bindns::bind(increment, &count));
+  group.join();
+  BOOST_ASIO_CHECK(count == 1);
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "io_context_group",
+  BOOST_ASIO_TEST_CASE(io_context_group_test)
+  BOOST_ASIO_TEST_CASE(io_context_group_executor_test)
+  BOOST_ASIO_TEST_CASE(io_context_group_construction_failure_test)
+)
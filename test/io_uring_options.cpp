@@ -0,0 +1,95 @@
+//
+// io_uring_options.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/io_uring_options.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// io_uring_options_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the io_uring options are held per execution
+// context, starting from the defaults.
+
+namespace io_uring_options_runtime {
+
+void test()
+{
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  using boost::asio::io_uring_options;
+
+  boost::asio::io_context ioc1;
+  boost::asio::io_context ioc2;
+
+  io_uring_options& options1 =
+    boost::asio::use_service<io_uring_options>(ioc1);
+  BOOST_ASIO_CHECK(options1.ring_size() == BOOST_ASIO_IO_URING_RING_SIZE);
+  BOOST_ASIO_CHECK(options1.completion_queue_size() == 0);
+  BOOST_ASIO_CHECK(!options1.submission_queue_polling());
+  BOOST_ASIO_CHECK(options1.submission_queue_polling_idle() == 0);
+  BOOST_ASIO_CHECK(options1.submission_queue_polling_cpu() == -1);
+  BOOST_ASIO_CHECK(!options1.cooperative_task_run());
+  BOOST_ASIO_CHECK(!options1.single_issuer());
+  BOOST_ASIO_CHECK(!options1.defer_task_run());
+  BOOST_ASIO_CHECK(options1.submit_batch_size()
+      == BOOST_ASIO_IO_URING_SUBMIT_BATCH_SIZE);
+  BOOST_ASIO_CHECK(options1.complete_batch_size()
+      == BOOST_ASIO_IO_URING_COMPLETE_BATCH_SIZE);
+
+  options1.ring_size(256);
+  options1.completion_queue_size(1024);
+  options1.submission_queue_polling(true);
+  options1.submission_queue_polling_idle(2000);
+  options1.submission_queue_polling_cpu(1);
+  options1.cooperative_task_run(true);
+  options1.single_issuer(true);
+  options1.defer_task_run(true);
+  options1.submit_batch_size(16);
+  options1.complete_batch_size(32);
+
+  io_uring_options& options2 =
+    boost::asio::use_service<io_uring_options>(ioc1);
+  BOOST_ASIO_CHECK(&options2 == &options1);
+  BOOST_ASIO_CHECK(options2.ring_size() == 256);
+  BOOST_ASIO_CHECK(options2.completion_queue_size() == 1024);
+  BOOST_ASIO_CHECK(options2.submission_queue_polling());
+  BOOST_ASIO_CHECK(options2.submission_queue_polling_idle() == 2000);
+  BOOST_ASIO_CHECK(options2.submission_queue_polling_cpu() == 1);
+  BOOST_ASIO_CHECK(options2.cooperative_task_run());
+  BOOST_ASIO_CHECK(options2.single_issuer());
+  BOOST_ASIO_CHECK(options2.defer_task_run());
+  BOOST_ASIO_CHECK(options2.submit_batch_size() == 16);
+  BOOST_ASIO_CHECK(options2.complete_batch_size() == 32);
+
+  io_uring_options& options3 =
+    boost::asio::use_service<io_uring_options>(ioc2);
+  BOOST_ASIO_CHECK(&options3 != &options1);
+  BOOST_ASIO_CHECK(options3.ring_size() == BOOST_ASIO_IO_URING_RING_SIZE);
+  BOOST_ASIO_CHECK(!options3.submission_queue_polling());
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+}
+
+} // namespace io_uring_options_runtime
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "io_uring_options",
+  BOOST_ASIO_TEST_CASE(io_uring_options_runtime::test)
+)
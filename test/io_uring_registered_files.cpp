@@ -0,0 +1,211 @@
+//
+// io_uring_registered_files.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Use a small registered file table so that the tests can fill it.
+#define BOOST_ASIO_IO_URING_REGISTERED_FILES 4
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <cstring>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+# include <boost/asio/detail/io_uring_service.hpp>
+# include <unistd.h>
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+//------------------------------------------------------------------------------
+
+// io_uring_registered_files_slot test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the descriptors of I/O objects are placed in
+// the registered file table, that a slot is reused once its I/O object has
+// been closed, and that descriptors are used directly once the table is full.
+
+namespace io_uring_registered_files_slot {
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+
+using boost::asio::detail::io_uring_service;
+
+void close_io_object(io_uring_service& service,
+    io_uring_service::per_io_object_data& io_obj, int descriptor)
+{
+  service.deregister_io_object(io_obj);
+  service.cleanup_io_object(io_obj);
+  ::close(descriptor);
+}
+
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+
+void test()
+{
+#if defined(BOOST_ASIO_HAS_IO_URING)
+  const int table_size = BOOST_ASIO_IO_URING_REGISTERED_FILES;
+  const int num_objects = table_size + 2;
+
+  boost::asio::io_context ioc;
+  io_uring_service& service =
+    boost::asio::use_service<io_uring_service>(ioc);
+
+  int descriptors[num_objects];
+  io_uring_service::per_io_object_data io_objs[num_objects];
+  bool used[table_size] = { false };
+  for (int i = 0; i < num_objects; ++i)
+  {
+    descriptors[i] = ::dup(STDERR_FILENO);
+    BOOST_ASIO_CHECK(descriptors[i] >= 0);
+    service.register_io_object(io_objs[i], descriptors[i]);
+  }
+
+  // Each of the first objects occupies a distinct slot in the table.
+  for (int i = 0; i < table_size; ++i)
+  {
+    int slot = io_uring_service::registered_file(io_objs[i]);
+    BOOST_ASIO_CHECK(slot >= 0 && slot < table_size);
+    if (slot >= 0 && slot < table_size)
+    {
+      BOOST_ASIO_CHECK(!used[slot]);
+      used[slot] = true;
+    }
+  }
+
+  // Once the table is full, descriptors are used directly.
+  for (int i = table_size; i < num_objects; ++i)
+    BOOST_ASIO_CHECK(io_uring_service::registered_file(io_objs[i]) == -1);
+
+  // Closing an object frees its slot for the next object to be opened.
+  int freed_slot = io_uring_service::registered_file(io_objs[1]);
+  close_io_object(service, io_objs[1], descriptors[1]);
+
+  descriptors[1] = ::dup(STDERR_FILENO);
+  BOOST_ASIO_CHECK(descriptors[1] >= 0);
+  service.register_io_object(io_objs[1], descriptors[1]);
+  BOOST_ASIO_CHECK(io_uring_service::registered_file(io_objs[1])
+      == freed_slot);
+
+  // Closing an object that uses its descriptor directly frees no slot.
+  close_io_object(service, io_objs[table_size],
+      descriptors[table_size]);
+
+  descriptors[table_size] = ::dup(STDERR_FILENO);
+  BOOST_ASIO_CHECK(descriptors[table_size] >= 0);
+  service.register_io_object(io_objs[table_size], descriptors[table_size]);
+  BOOST_ASIO_CHECK(io_uring_service::registered_file(
+        io_objs[table_size]) == -1);
+
+  for (int i = 0; i < num_objects; ++i)
+    close_io_object(service, io_objs[i], descriptors[i]);
+
+  // An object without a descriptor does not occupy a slot.
+  io_uring_service::per_io_object_data io_obj;
+  service.register_io_object(io_obj, -1);
+  BOOST_ASIO_CHECK(io_uring_service::registered_file(io_obj) == -1);
+  service.deregister_io_object(io_obj);
+  service.cleanup_io_object(io_obj);
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+}
+
+} // namespace io_uring_registered_files_slot
+
+//------------------------------------------------------------------------------
+
+// io_uring_registered_files_io test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that I/O succeeds both on sockets whose
+// descriptors are in the registered file table and on those opened after the
+// table has filled, and on sockets opened into slots that have been reused.
+
+namespace io_uring_registered_files_io {
+
+using namespace boost::asio;
+typedef local::stream_protocol::socket socket_type;
+
+const char message[] = "registered file table";
+
+void exchange(io_context& ioc, socket_type* sockets, int num_pairs)
+{
+  char buffers[16][sizeof(message)];
+  int written = 0;
+  int read = 0;
+
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    std::memset(buffers[i], 0, sizeof(message));
+    async_read(sockets[2 * i + 1], buffer(buffers[i]),
+        [&read](const boost::system::error_code& e, std::size_t n)
+        {
+          BOOST_ASIO_CHECK(!e);
+          BOOST_ASIO_CHECK(n == sizeof(message));
+          ++read;
+        });
+    async_write(sockets[2 * i], buffer(message),
+        [&written](const boost::system::error_code& e, std::size_t n)
+        {
+          BOOST_ASIO_CHECK(!e);
+          BOOST_ASIO_CHECK(n == sizeof(message));
+          ++written;
+        });
+  }
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(written == num_pairs);
+  BOOST_ASIO_CHECK(read == num_pairs);
+  for (int i = 0; i < num_pairs; ++i)
+    BOOST_ASIO_CHECK(std::memcmp(buffers[i], message, sizeof(message)) == 0);
+}
+
+void test()
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  // Twice as many sockets as there are slots in the table.
+  const int num_pairs = BOOST_ASIO_IO_URING_REGISTERED_FILES;
+
+  io_context ioc;
+  socket_type sockets[2 * num_pairs] = {
+    socket_type(ioc), socket_type(ioc), socket_type(ioc), socket_type(ioc),
+    socket_type(ioc), socket_type(ioc), socket_type(ioc), socket_type(ioc) };
+  for (int i = 0; i < num_pairs; ++i)
+    local::connect_pair(sockets[2 * i], sockets[2 * i + 1]);
+
+  exchange(ioc, sockets, num_pairs);
+
+  // Reopen half of the sockets, so that they take the freed slots.
+  for (int i = 0; i < num_pairs / 2; ++i)
+  {
+    sockets[2 * i].close();
+    sockets[2 * i + 1].close();
+    local::connect_pair(sockets[2 * i], sockets[2 * i + 1]);
+  }
+
+  exchange(ioc, sockets, num_pairs);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace io_uring_registered_files_io
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "io_uring_registered_files",
+  BOOST_ASIO_TEST_CASE(io_uring_registered_files_slot::test)
+  BOOST_ASIO_TEST_CASE(io_uring_registered_files_io::test)
+)
@@ -19,10 +19,20 @@
 // Test that header file is self-contained.
 #include <boost/asio/ip/tcp.hpp>
 
+#include <atomic>
 #include <cstring>
 #include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/detail/thread_group.hpp>
 #include <boost/asio/read.hpp>
+#include <boost/asio/strand.hpp>
 #include <boost/asio/write.hpp>
 #include "../unit_test.hpp"
 #include "../archetypes/async_result.hpp"
@@ -171,6 +181,13 @@ private:
   receive_handler(const receive_handler&);
 };
 
+struct receive_stream_handler
+{
+  receive_stream_handler() {}
+  void operator()(const boost::system::error_code&,
+      boost::asio::buffer_lease) {}
+};
+
 struct write_some_handler
 {
   write_some_handler() {}
@@ -475,6 +492,32 @@ void test()
     int i19 = socket1.async_receive(null_buffers(), in_flags, lazy);
     (void)i19;
 
+    boost::asio::chrono::steady_clock::time_point deadline
+      = boost::asio::chrono::steady_clock::now();
+    socket1.async_receive(buffer(mutable_char_buffer), deadline,
+        receive_handler());
+    socket1.async_receive(mutable_buffers, deadline, receive_handler());
+    socket1.async_receive(buffer(mutable_char_buffer), in_flags, deadline,
+        receive_handler());
+    socket1.async_receive(mutable_buffers, in_flags, deadline,
+        receive_handler());
+    socket1.async_receive(buffer(mutable_char_buffer), deadline, immediate);
+    socket1.async_receive(mutable_buffers, in_flags, deadline, immediate);
+    int i28 = socket1.async_receive(buffer(mutable_char_buffer),
+        deadline, lazy);
+    (void)i28;
+    int i29 = socket1.async_receive(mutable_buffers, in_flags, deadline, lazy);
+    (void)i29;
+
+    socket1.async_receive_stream(receive_stream_handler());
+    socket1.async_receive_stream(in_flags, receive_stream_handler());
+    socket1.async_receive_stream(
+        bind_executor(ioc_ex, receive_stream_handler()));
+    cancellation_signal stream_signal;
+    socket1.async_receive_stream(in_flags,
+        bind_cancellation_slot(stream_signal.slot(),
+          receive_stream_handler()));
+
     socket1.write_some(buffer(mutable_char_buffer));
     socket1.write_some(buffer(const_char_buffer));
     socket1.write_some(mutable_buffers);
@@ -526,6 +569,14 @@ void test()
     (void)i26;
     int i27 = socket1.async_read_some(null_buffers(), lazy);
     (void)i27;
+
+    socket1.async_read_some(buffer(mutable_char_buffer), deadline,
+        read_some_handler());
+    socket1.async_read_some(mutable_buffers, deadline, read_some_handler());
+    socket1.async_read_some(buffer(mutable_char_buffer), deadline, immediate);
+    int i30 = socket1.async_read_some(buffer(mutable_char_buffer),
+        deadline, lazy);
+    (void)i30;
   }
   catch (std::exception&)
   {
@@ -593,6 +644,61 @@ void handle_read_eof(const boost::system::error_code& err,
   BOOST_ASIO_CHECK(bytes_transferred == 0);
 }
 
+void handle_read_timeout(const boost::system::error_code& err,
+    size_t bytes_transferred, bool* called)
+{
+  *called = true;
+  BOOST_ASIO_CHECK(err == boost::asio::error::timed_out);
+  BOOST_ASIO_CHECK(bytes_transferred == 0);
+}
+
+void handle_transfer(const boost::system::error_code& err,
+    size_t bytes_transferred, size_t expected_bytes, bool* called)
+{
+  *called = true;
+  BOOST_ASIO_CHECK(!err);
+  BOOST_ASIO_CHECK(bytes_transferred == expected_bytes);
+}
+
+struct receive_stream_handler
+{
+  std::string* received_;
+  boost::system::error_code* final_error_;
+
+  void operator()(const boost::system::error_code& err,
+      boost::asio::buffer_lease lease)
+  {
+    if (!err)
+    {
+      BOOST_ASIO_CHECK(lease.valid());
+      BOOST_ASIO_CHECK(lease.size() > 0);
+      received_->append(static_cast<const char*>(lease.data().data()),
+          lease.size());
+    }
+    else
+    {
+      BOOST_ASIO_CHECK(!lease.valid());
+      BOOST_ASIO_CHECK(lease.size() == 0);
+      *final_error_ = err;
+    }
+  }
+};
+
+struct receive_stream_strand_handler
+{
+  boost::asio::strand<boost::asio::io_context::executor_type>* strand_;
+  std::string* received_;
+  boost::system::error_code* final_error_;
+
+  void operator()(const boost::system::error_code& err,
+      boost::asio::buffer_lease lease)
+  {
+    BOOST_ASIO_CHECK(strand_->running_in_this_thread());
+    receive_stream_handler{received_, final_error_}(err,
+        static_cast<boost::asio::buffer_lease&&>(lease));
+  }
+};
+
 void test()
 {
   using namespace std; // For memcmp.
@@ -690,12 +796,248 @@ void test()
   ioc.restart();
   ioc.run();
   BOOST_ASIO_CHECK(read_eof_completed);
+
+  // A stream receive delivers data until the peer closes the socket.
+
+  client_side_socket.close();
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  std::string received;
+  boost::system::error_code final_error;
+  receive_stream_handler handler = { &received, &final_error };
+  client_side_socket.async_receive_stream(handler);
+
+  boost::asio::write(server_side_socket, boost::asio::buffer(write_data));
+
+  ioc.restart();
+  while (received.size() < sizeof(write_data) && ioc.run_one())
+  {
+  }
+
+  BOOST_ASIO_CHECK(received.size() == sizeof(write_data));
+  BOOST_ASIO_CHECK(memcmp(received.data(), write_data,
+        sizeof(write_data)) == 0);
+  BOOST_ASIO_CHECK(!final_error);
+
+  boost::asio::write(server_side_socket, boost::asio::buffer(write_data));
+  server_side_socket.close();
+
+  ioc.run();
+  BOOST_ASIO_CHECK(received.size() == 2 * sizeof(write_data));
+  BOOST_ASIO_CHECK(final_error == boost::asio::error::eof);
+
+  // The completion token may adapt the handler. The adaptation applies to
+  // every buffer delivered, and a bound cancellation slot ends the operation
+  // without closing the socket.
+
+  client_side_socket.close();
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  boost::asio::strand<boost::asio::io_context::executor_type> s(
+      ioc.get_executor());
+  boost::asio::cancellation_signal stream_signal;
+  received.clear();
+  final_error = boost::system::error_code();
+  receive_stream_strand_handler strand_handler =
+    { &s, &received, &final_error };
+  client_side_socket.async_receive_stream(
+      boost::asio::bind_cancellation_slot(stream_signal.slot(),
+        boost::asio::bind_executor(s, strand_handler)));
+
+  boost::asio::write(server_side_socket, boost::asio::buffer(write_data));
+
+  ioc.restart();
+  while (received.size() < sizeof(write_data) && ioc.run_one())
+  {
+  }
+
+  BOOST_ASIO_CHECK(received.size() == sizeof(write_data));
+  BOOST_ASIO_CHECK(!final_error);
+
+  stream_signal.emit(boost::asio::cancellation_type::terminal);
+
+  ioc.run();
+  BOOST_ASIO_CHECK(received.size() == sizeof(write_data));
+  BOOST_ASIO_CHECK(final_error == boost::asio::error::operation_aborted);
+  BOOST_ASIO_CHECK(client_side_socket.is_open());
+  server_side_socket.close();
+
+  // A read that receives no data before its deadline should fail with
+  // timed_out, while a read with data available should succeed.
+
+  client_side_socket.close();
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  bool read_timeout_completed = false;
+  client_side_socket.async_read_some(boost::asio::buffer(read_buffer),
+      boost::asio::chrono::steady_clock::now()
+        + boost::asio::chrono::milliseconds(50),
+      bindns::bind(handle_read_timeout,
+        _1, _2, &read_timeout_completed));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(read_timeout_completed);
+
+  boost::asio::write(server_side_socket, boost::asio::buffer(write_data));
+
+  bool read_deadline_completed = false;
+  client_side_socket.async_receive(boost::asio::buffer(read_buffer),
+      boost::asio::chrono::steady_clock::now()
+        + boost::asio::chrono::seconds(10),
+      bindns::bind(handle_transfer, _1, _2,
+        sizeof(write_data), &read_deadline_completed));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(read_deadline_completed);
+  BOOST_ASIO_CHECK(memcmp(read_buffer, write_data, sizeof(write_data)) == 0);
+
+  server_side_socket.close();
+
+#if defined(SO_ZEROCOPY)
+  // A large write on a socket with zero-copy sends enabled.
+
+  client_side_socket.close();
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  boost::system::error_code zero_copy_ec;
+  server_side_socket.set_option(socket_base::zero_copy(true), zero_copy_ec);
+  if (!zero_copy_ec)
+  {
+    std::vector<char> zero_copy_data(256 * 1024);
+    for (size_t i = 0; i < zero_copy_data.size(); ++i)
+      zero_copy_data[i] = static_cast<char>(i % 251);
+    std::vector<char> zero_copy_buffer(zero_copy_data.size());
+
+    bool zero_copy_read_completed = false;
+    boost::asio::async_read(client_side_socket,
+        boost::asio::buffer(zero_copy_buffer),
+        bindns::bind(handle_transfer, _1, _2,
+          zero_copy_data.size(), &zero_copy_read_completed));
+
+    bool zero_copy_write_completed = false;
+    boost::asio::async_write(server_side_socket,
+        boost::asio::buffer(zero_copy_data),
+        bindns::bind(handle_transfer, _1, _2,
+          zero_copy_data.size(), &zero_copy_write_completed));
+
+    ioc.restart();
+    ioc.run();
+    BOOST_ASIO_CHECK(zero_copy_read_completed);
+    BOOST_ASIO_CHECK(zero_copy_write_completed);
+    BOOST_ASIO_CHECK(zero_copy_buffer == zero_copy_data);
+  }
+#endif // defined(SO_ZEROCOPY)
 }
 
 } // namespace ip_tcp_socket_runtime
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_socket_deadline_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that reads with a deadline complete exactly once,
+// with either data or the timed_out error, when several threads run the
+// io_context while data arrives at about the same time as the deadlines.
+
+namespace ip_tcp_socket_deadline_runtime {
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+
+using namespace boost::asio;
+namespace ip = boost::asio::ip;
+
+struct deadline_reader
+{
+  ip::tcp::socket* socket;
+  char* data;
+  int reads_left;
+  std::atomic<int>* readers_left;
+  std::atomic<int>* completions;
+  std::atomic<int>* errors;
+
+  void start()
+  {
+    socket->async_read_some(buffer(data, 1),
+        chrono::steady_clock::now()
+          + chrono::microseconds(250 * (reads_left % 4)), *this);
+  }
+
+  void operator()(const boost::system::error_code& ec, std::size_t n)
+  {
+    ++*completions;
+    if (ec ? ec != error::timed_out : n != 1)
+      ++*errors;
+    if (--reads_left > 0)
+      start();
+    else
+      --*readers_left;
+  }
+};
+
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
+void test()
+{
+#if defined(BOOST_ASIO_HAS_THREADS)
+  const int num_pairs = 8;
+  const int num_reads = 200;
+
+  io_context ioc;
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+
+  std::vector<std::unique_ptr<ip::tcp::socket>> readers;
+  std::vector<std::unique_ptr<ip::tcp::socket>> writers;
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    readers.emplace_back(new ip::tcp::socket(ioc));
+    writers.emplace_back(new ip::tcp::socket(ioc));
+    readers.back()->connect(server_endpoint);
+    acceptor.accept(*writers.back());
+  }
+
+  char data[num_pairs] = { 0 };
+  std::atomic<int> readers_left(num_pairs);
+  std::atomic<int> completions(0);
+  std::atomic<int> errors(0);
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    deadline_reader reader = { readers[i].get(), data + i,
+      num_reads, &readers_left, &completions, &errors };
+    reader.start();
+  }
+
+  detail::thread_group threads;
+  threads.create_threads([&ioc]{ ioc.run(); }, 4);
+
+  while (readers_left > 0)
+  {
+    for (int i = 0; i < num_pairs; ++i)
+    {
+      boost::system::error_code ec;
+      writers[i]->write_some(buffer("x", 1), ec);
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(300));
+  }
+
+  threads.join();
+
+  BOOST_ASIO_CHECK(completions == num_pairs * num_reads);
+  BOOST_ASIO_CHECK(errors == 0);
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+}
+
+} // namespace ip_tcp_socket_deadline_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_acceptor_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -731,6 +1073,13 @@ private:
   move_accept_handler(const move_accept_handler&) {}
 };
 
+struct accept_many_handler
+{
+  accept_many_handler() {}
+  void operator()(
+      const boost::system::error_code&, boost::asio::ip::tcp::socket) {}
+};
+
 struct move_accept_ioc_handler
 {
   move_accept_ioc_handler() {}
@@ -935,6 +1284,13 @@ void test()
     acceptor1.async_accept(peer_endpoint, immediate);
     acceptor1.async_accept(ioc, peer_endpoint, immediate);
     acceptor1.async_accept(ioc_ex, peer_endpoint, immediate);
+
+    acceptor1.async_accept_many(accept_many_handler());
+    acceptor1.async_accept_many(
+        bind_executor(ioc.get_executor(), accept_many_handler()));
+    cancellation_signal accept_signal;
+    acceptor1.async_accept_many(
+        bind_cancellation_slot(accept_signal.slot(), accept_many_handler()));
   }
   catch (std::exception&)
   {
@@ -962,6 +1318,42 @@ void handle_connect(const boost::system::error_code& err)
   BOOST_ASIO_CHECK(!err);
 }
 
+struct accept_many_handler
+{
+  int* accepted_;
+  boost::system::error_code* final_error_;
+
+  void operator()(const boost::system::error_code& err,
+      boost::asio::ip::tcp::socket peer)
+  {
+    if (!err)
+    {
+      BOOST_ASIO_CHECK(peer.is_open());
+      ++(*accepted_);
+    }
+    else
+    {
+      BOOST_ASIO_CHECK(!peer.is_open());
+      *final_error_ = err;
+    }
+  }
+};
+
+struct accept_many_strand_handler
+{
+  boost::asio::strand<boost::asio::io_context::executor_type>* strand_;
+  int* accepted_;
+  boost::system::error_code* final_error_;
+
+  void operator()(const boost::system::error_code& err,
+      boost::asio::ip::tcp::socket peer)
+  {
+    BOOST_ASIO_CHECK(strand_->running_in_this_thread());
+    accept_many_handler{accepted_, final_error_}(err,
+        static_cast<boost::asio::ip::tcp::socket&&>(peer));
+  }
+};
+
 void test()
 {
   using namespace boost::asio;
@@ -1018,6 +1410,95 @@ void test()
   server_side_remote_endpoint = server_side_socket.remote_endpoint();
   BOOST_ASIO_CHECK(server_side_remote_endpoint.port()
       == client_endpoint.port());
+
+  client_side_socket.close();
+  server_side_socket.close();
+
+  int accepted = 0;
+  boost::system::error_code final_error;
+  accept_many_handler handler = { &accepted, &final_error };
+  acceptor.async_accept_many(handler);
+
+  const int num_clients = 3;
+  ip::tcp::socket clients[num_clients] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc) };
+  for (int i = 0; i < num_clients; ++i)
+    clients[i].async_connect(server_endpoint, &handle_connect);
+
+  ioc.restart();
+  while (accepted < num_clients && ioc.run_one())
+  {
+  }
+
+  BOOST_ASIO_CHECK(accepted == num_clients);
+  BOOST_ASIO_CHECK(!final_error);
+
+  acceptor.close();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(accepted == num_clients);
+  BOOST_ASIO_CHECK(final_error == boost::asio::error::operation_aborted);
+
+  // The completion token may adapt the handler, and the adaptation applies to
+  // every connection delivered.
+  ip::tcp::acceptor acceptor2(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  server_endpoint = acceptor2.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  strand<io_context::executor_type> s(ioc.get_executor());
+  accepted = 0;
+  final_error = boost::system::error_code();
+  accept_many_strand_handler strand_handler = { &s, &accepted, &final_error };
+  acceptor2.async_accept_many(bind_executor(s, strand_handler));
+
+  ip::tcp::socket clients2[num_clients] = {
+    ip::tcp::socket(ioc), ip::tcp::socket(ioc), ip::tcp::socket(ioc) };
+  for (int i = 0; i < num_clients; ++i)
+    clients2[i].async_connect(server_endpoint, &handle_connect);
+
+  ioc.restart();
+  while (accepted < num_clients && ioc.run_one())
+  {
+  }
+
+  BOOST_ASIO_CHECK(accepted == num_clients);
+  BOOST_ASIO_CHECK(!final_error);
+
+  acceptor2.close();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(final_error == boost::asio::error::operation_aborted);
+
+  // A bound cancellation slot ends the operation without closing the
+  // acceptor.
+  ip::tcp::acceptor acceptor3(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  server_endpoint = acceptor3.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  cancellation_signal accept_signal;
+  accepted = 0;
+  final_error = boost::system::error_code();
+  accept_many_handler handler3 = { &accepted, &final_error };
+  acceptor3.async_accept_many(
+      bind_cancellation_slot(accept_signal.slot(), handler3));
+
+  ip::tcp::socket client3(ioc);
+  client3.async_connect(server_endpoint, &handle_connect);
+
+  ioc.restart();
+  while (accepted < 1 && ioc.run_one())
+  {
+  }
+
+  BOOST_ASIO_CHECK(accepted == 1);
+  BOOST_ASIO_CHECK(!final_error);
+
+  accept_signal.emit(cancellation_type::terminal);
+  ioc.run();
+
+  BOOST_ASIO_CHECK(accepted == 1);
+  BOOST_ASIO_CHECK(final_error == boost::asio::error::operation_aborted);
+  BOOST_ASIO_CHECK(acceptor3.is_open());
 }
 
 } // namespace ip_tcp_acceptor_runtime
@@ -1327,6 +1808,7 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(ip_tcp_runtime::test)
   BOOST_ASIO_COMPILE_TEST_CASE(ip_tcp_socket_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
+  BOOST_ASIO_TEST_CASE(ip_tcp_socket_deadline_runtime::test)
   BOOST_ASIO_COMPILE_TEST_CASE(ip_tcp_acceptor_compile::test)
   BOOST_ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
   BOOST_ASIO_COMPILE_TEST_CASE(ip_tcp_resolver_compile::test)
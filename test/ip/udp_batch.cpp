@@ -0,0 +1,316 @@
+//
+// udp_batch.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/ip/udp.hpp>
+
+#include <cstring>
+#include <functional>
+#include <vector>
+#include <boost/asio/io_context.hpp>
+#include "../unit_test.hpp"
+#include "../archetypes/async_result.hpp"
+
+//------------------------------------------------------------------------------
+
+// ip_udp_batch_compile test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the member functions and socket options of
+// ip::udp::socket that transfer batches or trains of datagrams compile and
+// link correctly. Runtime failures are ignored.
+
+namespace ip_udp_batch_compile {
+
+struct send_handler
+{
+  send_handler() {}
+  void operator()(const boost::system::error_code&, std::size_t) {}
+  send_handler(send_handler&&) {}
+private:
+  send_handler(const send_handler&);
+};
+
+struct receive_handler
+{
+  receive_handler() {}
+  void operator()(const boost::system::error_code&, std::size_t) {}
+  receive_handler(receive_handler&&) {}
+private:
+  receive_handler(const receive_handler&);
+};
+
+struct receive_segments_handler
+{
+  receive_segments_handler() {}
+  void operator()(const boost::system::error_code&,
+      std::size_t, std::size_t) {}
+  receive_segments_handler(receive_segments_handler&&) {}
+private:
+  receive_segments_handler(const receive_segments_handler&);
+};
+
+void test()
+{
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+#if defined(BOOST_ASIO_HAS_MMSG) || defined(BOOST_ASIO_HAS_UDP_GSO)
+  try
+  {
+    io_context ioc;
+    char mutable_char_buffer[128] = "";
+    const char const_char_buffer[128] = "";
+    socket_base::message_flags in_flags = 0;
+    archetypes::immediate_handler immediate;
+    archetypes::lazy_handler lazy;
+
+    ip::udp::socket socket1(ioc, ip::udp::endpoint(ip::udp::v4(), 0));
+    ip::udp::endpoint endpoint;
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+    ip::udp::socket::send_slot send_slots[2] = {
+      { buffer(const_char_buffer), endpoint, 0 },
+      { buffer(const_char_buffer), endpoint, 0 }
+    };
+    socket1.async_send_many_to(send_slots, 2, send_handler());
+    socket1.async_send_many_to(send_slots, 2, in_flags, send_handler());
+    socket1.async_send_many_to(send_slots, 2, immediate);
+    socket1.async_send_many_to(send_slots, 2, in_flags, immediate);
+    int i1 = socket1.async_send_many_to(send_slots, 2, lazy);
+    (void)i1;
+    int i2 = socket1.async_send_many_to(send_slots, 2, in_flags, lazy);
+    (void)i2;
+
+    ip::udp::socket::receive_slot receive_slots[2] = {
+      { buffer(mutable_char_buffer), endpoint, 0 },
+      { buffer(mutable_char_buffer), endpoint, 0 }
+    };
+    socket1.async_receive_many_from(receive_slots, 2, receive_handler());
+    socket1.async_receive_many_from(receive_slots, 2,
+        in_flags, receive_handler());
+    socket1.async_receive_many_from(receive_slots, 2, immediate);
+    socket1.async_receive_many_from(receive_slots, 2, in_flags, immediate);
+    int i3 = socket1.async_receive_many_from(receive_slots, 2, lazy);
+    (void)i3;
+    int i4 = socket1.async_receive_many_from(receive_slots, 2,
+        in_flags, lazy);
+    (void)i4;
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+    ip::udp::segment_size segment_size_option(1200);
+    socket1.set_option(segment_size_option);
+    socket1.get_option(segment_size_option);
+    ip::udp::generic_receive_offload receive_offload_option(true);
+    socket1.set_option(receive_offload_option);
+    socket1.get_option(receive_offload_option);
+
+    socket1.async_send_segments_to(buffer(mutable_char_buffer), 4,
+        ip::udp::endpoint(ip::udp::v4(), 0), send_handler());
+    socket1.async_send_segments_to(buffer(const_char_buffer), 4,
+        ip::udp::endpoint(ip::udp::v4(), 0), in_flags, send_handler());
+    socket1.async_send_segments_to(buffer(const_char_buffer), 4,
+        ip::udp::endpoint(ip::udp::v4(), 0), immediate);
+    socket1.async_send_segments_to(buffer(const_char_buffer), 4,
+        ip::udp::endpoint(ip::udp::v4(), 0), in_flags, immediate);
+    int i5 = socket1.async_send_segments_to(buffer(const_char_buffer), 4,
+        ip::udp::endpoint(ip::udp::v4(), 0), lazy);
+    (void)i5;
+    int i6 = socket1.async_send_segments_to(buffer(const_char_buffer), 4,
+        ip::udp::endpoint(ip::udp::v4(), 0), in_flags, lazy);
+    (void)i6;
+
+    socket1.async_receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, receive_segments_handler());
+    socket1.async_receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, in_flags, receive_segments_handler());
+    socket1.async_receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, immediate);
+    socket1.async_receive_segments_from(buffer(mutable_char_buffer),
+        endpoint, in_flags, immediate);
+    int i7 = socket1.async_receive_segments_from(
+        buffer(mutable_char_buffer), endpoint, lazy);
+    (void)i7;
+    int i8 = socket1.async_receive_segments_from(
+        buffer(mutable_char_buffer), endpoint, in_flags, lazy);
+    (void)i8;
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+  }
+  catch (std::exception&)
+  {
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG) || defined(BOOST_ASIO_HAS_UDP_GSO)
+}
+
+} // namespace ip_udp_batch_compile
+
+//------------------------------------------------------------------------------
+
+// ip_udp_batch_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the member functions of
+// ip::udp::socket that transfer batches or trains of datagrams.
+
+namespace ip_udp_batch_runtime {
+
+void handle_send(size_t expected_bytes_sent,
+    const boost::system::error_code& err, size_t bytes_sent)
+{
+  BOOST_ASIO_CHECK(!err);
+  BOOST_ASIO_CHECK(expected_bytes_sent == bytes_sent);
+}
+
+void handle_recv(size_t expected_bytes_recvd,
+    const boost::system::error_code& err, size_t bytes_recvd)
+{
+  BOOST_ASIO_CHECK(!err);
+  BOOST_ASIO_CHECK(expected_bytes_recvd == bytes_recvd);
+}
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+
+void handle_recv_segments(size_t* total_bytes_recvd,
+    size_t* recvd_segment_size, const boost::system::error_code& err,
+    size_t bytes_recvd, size_t segment_size)
+{
+  BOOST_ASIO_CHECK(!err);
+  *total_bytes_recvd += bytes_recvd;
+  *recvd_segment_size = segment_size;
+}
+
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+
+void test()
+{
+#if defined(BOOST_ASIO_HAS_MMSG) || defined(BOOST_ASIO_HAS_UDP_GSO)
+  using namespace std; // For memcmp.
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc;
+
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::endpoint sender_endpoint = s1.local_endpoint();
+
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::endpoint target_endpoint = s2.local_endpoint();
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+  char send_msg[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+  // Send a batch of datagrams of different sizes and receive them as a batch.
+
+  const std::size_t batch_size = 4;
+  ip::udp::socket::send_slot send_slots[batch_size];
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    send_slots[i].buffer = buffer(send_msg, i + 1);
+    send_slots[i].endpoint = target_endpoint;
+    send_slots[i].size = 0;
+  }
+
+  char batch_msgs[batch_size + 1][sizeof(send_msg)];
+  ip::udp::socket::receive_slot receive_slots[batch_size + 1];
+  for (std::size_t i = 0; i < batch_size + 1; ++i)
+  {
+    receive_slots[i].buffer = buffer(batch_msgs[i], sizeof(batch_msgs[i]));
+    receive_slots[i].size = 0;
+  }
+
+  s1.async_send_many_to(send_slots, batch_size,
+      bindns::bind(handle_send, batch_size, _1, _2));
+
+  ioc.restart();
+  ioc.run();
+
+  for (std::size_t i = 0; i < batch_size; ++i)
+    BOOST_ASIO_CHECK(send_slots[i].size == i + 1);
+
+  s2.async_receive_many_from(receive_slots, batch_size + 1,
+      bindns::bind(handle_recv, batch_size, _1, _2));
+
+  ioc.restart();
+  ioc.run();
+
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    BOOST_ASIO_CHECK(receive_slots[i].size == i + 1);
+    BOOST_ASIO_CHECK(memcmp(send_msg, batch_msgs[i], i + 1) == 0);
+    BOOST_ASIO_CHECK(receive_slots[i].endpoint == sender_endpoint);
+  }
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+
+#if defined(BOOST_ASIO_HAS_UDP_GSO)
+  // Send a buffer as a train of segments. Whether or not the receiver
+  // coalesces them, every segment but the last has the requested size.
+
+  const size_t segment_size = 100;
+  const size_t train_size = 5 * segment_size + 20;
+  std::vector<char> train(train_size);
+  for (size_t i = 0; i < train_size; ++i)
+    train[i] = static_cast<char>(i % 101);
+
+  boost::system::error_code gro_ec;
+  s2.set_option(ip::udp::generic_receive_offload(true), gro_ec);
+
+  s1.async_send_segments_to(buffer(train), segment_size, target_endpoint,
+      bindns::bind(handle_send, train_size, _1, _2));
+
+  ioc.restart();
+  ioc.run();
+
+  std::vector<char> received(train_size);
+  size_t total_bytes_recvd = 0;
+  ip::udp::endpoint segments_endpoint;
+  while (total_bytes_recvd < train_size)
+  {
+    size_t offset = total_bytes_recvd;
+    size_t recvd_segment_size = 0;
+    s2.async_receive_segments_from(
+        buffer(&received[offset], train_size - offset), segments_endpoint,
+        bindns::bind(handle_recv_segments, &total_bytes_recvd,
+          &recvd_segment_size, _1, _2, bindns::placeholders::_3));
+
+    ioc.restart();
+    ioc.run();
+
+    BOOST_ASIO_CHECK(total_bytes_recvd > offset);
+    if (total_bytes_recvd <= offset)
+      break;
+    BOOST_ASIO_CHECK(recvd_segment_size == segment_size
+        || total_bytes_recvd == train_size);
+    BOOST_ASIO_CHECK(segments_endpoint == sender_endpoint);
+  }
+
+  BOOST_ASIO_CHECK(total_bytes_recvd == train_size);
+  BOOST_ASIO_CHECK(memcmp(&train[0], &received[0], train_size) == 0);
+#endif // defined(BOOST_ASIO_HAS_UDP_GSO)
+#endif // defined(BOOST_ASIO_HAS_MMSG) || defined(BOOST_ASIO_HAS_UDP_GSO)
+}
+
+} // namespace ip_udp_batch_runtime
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "ip/udp_batch",
+  BOOST_ASIO_COMPILE_TEST_CASE(ip_udp_batch_compile::test)
+  BOOST_ASIO_TEST_CASE(ip_udp_batch_runtime::test)
+)
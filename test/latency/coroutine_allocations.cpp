@@ -0,0 +1,171 @@
+//
+// coroutine_allocations.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Route the library's own aligned allocations through operator new, so that
+// they are counted below.
+#define BOOST_ASIO_DISABLE_STD_ALIGNED_ALLOC 1
+#define BOOST_ASIO_DISABLE_BOOST_ALIGN 1
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+using boost::asio::awaitable;
+using boost::asio::use_awaitable;
+using boost::asio::ip::tcp;
+
+// GCC cannot see that the replacement operators below pair malloc with free.
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+# pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif // defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+
+// Count every allocation made through the global operator new.
+static std::size_t heap_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+  ++heap_allocations;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+// The request handling of the cpp20 echo server examples, with the read and
+// write wrapped in a chain of nested coroutines, as when a server splits a
+// request into layers of awaitable functions.
+awaitable<std::size_t> echo_once(tcp::socket& socket, int depth)
+{
+  if (depth > 0)
+    co_return co_await echo_once(socket, depth - 1);
+
+  char data[64];
+  std::size_t n = co_await socket.async_read_some(
+      boost::asio::buffer(data), use_awaitable);
+  co_await boost::asio::async_write(socket,
+      boost::asio::buffer(data, n), use_awaitable);
+  co_return n;
+}
+
+awaitable<void> echo(tcp::socket socket, int depth)
+{
+  try
+  {
+    for (;;)
+      co_await echo_once(socket, depth);
+  }
+  catch (std::exception&)
+  {
+  }
+}
+
+awaitable<void> client(tcp::socket socket, int requests,
+    std::size_t* allocations)
+{
+  char data[64] = "ping";
+  for (int i = 0; i < requests; ++i)
+  {
+    // Leave out the first request, which fills the caches.
+    if (i == 1)
+      *allocations = heap_allocations;
+
+    co_await boost::asio::async_write(socket,
+        boost::asio::buffer(data, 4), use_awaitable);
+    co_await boost::asio::async_read(socket,
+        boost::asio::buffer(data, 4), use_awaitable);
+  }
+  *allocations = heap_allocations - *allocations;
+  socket.close();
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr, "Usage: coroutine_allocations <requests> <depth>\n");
+    return 1;
+  }
+
+  int requests = std::atoi(argv[1]);
+  int depth = std::atoi(argv[2]);
+  if (requests < 2)
+  {
+    std::fprintf(stderr, "At least two requests are needed\n");
+    return 1;
+  }
+
+  boost::asio::io_context io_context(1);
+
+  tcp::acceptor acceptor(io_context,
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+  tcp::socket client_socket(io_context);
+  client_socket.connect(acceptor.local_endpoint());
+  tcp::socket server_socket = acceptor.accept();
+
+  boost::asio::awaitable_frame_statistics before =
+    boost::asio::get_awaitable_frame_statistics();
+
+  std::size_t allocations = 0;
+  co_spawn(io_context, echo(std::move(server_socket), depth),
+      boost::asio::detached);
+  co_spawn(io_context, client(std::move(client_socket),
+        requests, &allocations), boost::asio::detached);
+  io_context.run();
+
+  boost::asio::awaitable_frame_statistics after =
+    boost::asio::get_awaitable_frame_statistics();
+
+  std::size_t hits = after.hits - before.hits;
+  std::size_t misses = after.misses - before.misses;
+  std::size_t frames = hits + misses;
+  std::size_t bytes = after.bytes - before.bytes;
+
+  std::printf("requests:                 %d\n", requests);
+  std::printf("heap allocations/request: %.3f\n",
+      static_cast<double>(allocations) / (requests - 1));
+  std::printf("frames/request:           %.3f\n",
+      static_cast<double>(frames) / requests);
+  std::printf("frame pool hits:          %lu\n",
+      static_cast<unsigned long>(hits));
+  std::printf("frame pool misses:        %lu\n",
+      static_cast<unsigned long>(misses));
+  std::printf("average frame size:       %lu bytes\n",
+      static_cast<unsigned long>(frames ? bytes / frames : 0));
+
+  return 0;
+}
+
+#else // defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+int main()
+{
+  std::fprintf(stderr, "Coroutine support is required\n");
+  return 1;
+}
+
+#endif // defined(BOOST_ASIO_HAS_CO_AWAIT)
@@ -0,0 +1,91 @@
+//
+// io_uring_setup.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef IO_URING_SETUP_HPP
+#define IO_URING_SETUP_HPP
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/io_uring_options.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Applies the io_uring options named on the command line, so that the effect
+// of each on latency can be compared. Returns false if an option is not
+// recognised.
+inline bool setup_io_uring(boost::asio::io_context& io_context,
+    int argc, char* argv[])
+{
+  for (int i = 0; i < argc; ++i)
+  {
+    const char* arg = argv[i];
+    const char* value = std::strchr(arg, '=');
+    std::size_t name_length = value ? value - arg : std::strlen(arg);
+    std::size_t n = value ? std::strtoul(value + 1, 0, 10) : 0;
+
+#if defined(BOOST_ASIO_HAS_IO_URING)
+    boost::asio::io_uring_options& options =
+      boost::asio::use_service<boost::asio::io_uring_options>(io_context);
+
+    if (name_length == 4 && std::strncmp(arg, "ring", 4) == 0 && value)
+      options.ring_size(n);
+    else if (name_length == 2 && std::strncmp(arg, "cq", 2) == 0 && value)
+      options.completion_queue_size(n);
+    else if (std::strcmp(arg, "sqpoll") == 0)
+      options.submission_queue_polling(true);
+    else if (name_length == 11
+        && std::strncmp(arg, "sqpoll_idle", 11) == 0 && value)
+    {
+      options.submission_queue_polling(true);
+      options.submission_queue_polling_idle(static_cast<unsigned int>(n));
+    }
+    else if (name_length == 10
+        && std::strncmp(arg, "sqpoll_cpu", 10) == 0 && value)
+    {
+      options.submission_queue_polling(true);
+      options.submission_queue_polling_cpu(static_cast<int>(n));
+    }
+    else if (std::strcmp(arg, "coop_taskrun") == 0)
+      options.cooperative_task_run(true);
+    else if (std::strcmp(arg, "single_issuer") == 0)
+      options.single_issuer(true);
+    else if (std::strcmp(arg, "defer_taskrun") == 0)
+      options.defer_task_run(true);
+    else if (name_length == 12
+        && std::strncmp(arg, "submit_batch", 12) == 0 && value)
+      options.submit_batch_size(n);
+    else if (name_length == 14
+        && std::strncmp(arg, "complete_batch", 14) == 0 && value)
+      options.complete_batch_size(n);
+    else
+#else // defined(BOOST_ASIO_HAS_IO_URING)
+    (void)io_context;
+    (void)name_length;
+    (void)n;
+#endif // defined(BOOST_ASIO_HAS_IO_URING)
+    {
+      std::fprintf(stderr, "Unsupported io_uring option: %s\n", arg);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Describes the io_uring options accepted by setup_io_uring.
+inline const char* io_uring_usage()
+{
+  return "io_uring options:\n"
+    "  ring=<n> cq=<n> sqpoll sqpoll_idle=<ms> sqpoll_cpu=<n>\n"
+    "  coop_taskrun single_issuer defer_taskrun\n"
+    "  submit_batch=<n> complete_batch=<n>\n";
+}
+
+#endif // IO_URING_SETUP_HPP
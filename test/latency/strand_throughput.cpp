@@ -0,0 +1,159 @@
+//
+// strand_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/strand.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+typedef boost::asio::strand<boost::asio::io_context::executor_type> strand;
+
+enum mode { mode_post, mode_dispatch, mode_mixed };
+
+// Handlers hop from strand to strand, so that every strand is submitted to
+// from many threads at once. Each strand counts the handlers it runs without
+// synchronisation, which also checks that the strand serialises them.
+struct strand_state
+{
+  explicit strand_state(boost::asio::io_context& io_context)
+    : strand_(boost::asio::make_strand(io_context)),
+      count_(0),
+      running_(false)
+  {
+  }
+
+  strand strand_;
+  long count_;
+  std::atomic<bool> running_;
+};
+
+struct benchmark
+{
+  std::vector<strand_state*> strands_;
+  mode mode_;
+  std::atomic<long> violations_;
+};
+
+class hop
+{
+public:
+  hop(benchmark* b, std::size_t index, int remaining)
+    : benchmark_(b),
+      index_(index),
+      remaining_(remaining)
+  {
+  }
+
+  void operator()()
+  {
+    strand_state& s = *benchmark_->strands_[index_];
+    if (s.running_.exchange(true))
+      ++benchmark_->violations_;
+    ++s.count_;
+    s.running_ = false;
+
+    if (--remaining_ > 0)
+    {
+      index_ = (index_ * 7919 + remaining_) % benchmark_->strands_.size();
+      strand& next = benchmark_->strands_[index_]->strand_;
+      bool use_post = benchmark_->mode_ == mode_post
+        || (benchmark_->mode_ == mode_mixed && remaining_ % 2 == 0);
+      if (use_post)
+        boost::asio::post(next, *this);
+      else
+        boost::asio::dispatch(next, *this);
+    }
+  }
+
+private:
+  benchmark* benchmark_;
+  std::size_t index_;
+  int remaining_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 5 && argc != 6)
+  {
+    std::fprintf(stderr,
+        "Usage: strand_throughput <threads> <strands> "
+        "<hops> {post|dispatch|mixed} [quantum]\n");
+    return 1;
+  }
+
+  int num_threads = std::atoi(argv[1]);
+  std::size_t num_strands = std::atoi(argv[2]);
+  int hops = std::atoi(argv[3]);
+  mode m = mode_mixed;
+  if (std::strcmp(argv[4], "post") == 0)
+    m = mode_post;
+  else if (std::strcmp(argv[4], "dispatch") == 0)
+    m = mode_dispatch;
+  std::size_t quantum = argc > 5 ? std::atoi(argv[5]) : 0;
+
+  boost::asio::io_context io_context(num_threads);
+
+  benchmark b;
+  for (std::size_t i = 0; i < num_strands; ++i)
+  {
+    b.strands_.push_back(new strand_state(io_context));
+    b.strands_[i]->strand_.set_quantum(quantum);
+  }
+  b.mode_ = m;
+  b.violations_ = 0;
+
+  // Start one chain of handlers on each strand.
+  for (std::size_t i = 0; i < num_strands; ++i)
+    boost::asio::post(b.strands_[i]->strand_, hop(&b, i, hops));
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.push_back(std::thread([&io_context]{ io_context.run(); }));
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  std::chrono::steady_clock::duration elapsed =
+    std::chrono::steady_clock::now() - start;
+
+  long total = 0;
+  std::size_t handoffs = 0;
+  for (std::size_t i = 0; i < num_strands; ++i)
+  {
+    total += b.strands_[i]->count_;
+    handoffs += b.strands_[i]->strand_.handoff_count();
+    delete b.strands_[i];
+  }
+
+  double usec = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+  std::printf("handlers: %ld\n", total);
+  std::printf("handoffs: %lu\n", static_cast<unsigned long>(handoffs));
+  std::printf("elapsed:  %.0f usec\n", usec);
+  std::printf("rate:     %.0f handlers/sec\n",
+      usec > 0 ? total * 1000000.0 / usec : 0.0);
+
+  if (total != static_cast<long>(num_strands) * hops || b.violations_ != 0)
+  {
+    std::fprintf(stderr, "strand serialisation check failed\n");
+    return 1;
+  }
+
+  return 0;
+}
@@ -17,6 +17,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <vector>
+#include "io_uring_setup.hpp"
 
 using boost::asio::ip::tcp;
 
@@ -83,11 +84,12 @@ private:
 
 int main(int argc, char* argv[])
 {
-  if (argc != 5)
+  if (argc < 5)
   {
     std::fprintf(stderr,
         "Usage: tcp_server <port> <nconns> "
-        "<bufsize> {spin|block}\n");
+        "<bufsize> {spin|block} [io_uring options...]\n%s",
+        io_uring_usage());
     return 1;
   }
 
@@ -97,6 +99,9 @@ int main(int argc, char* argv[])
   bool spin = (std::strcmp(argv[4], "spin") == 0);
 
   boost::asio::io_context io_context(1);
+  if (!setup_io_uring(io_context, argc - 5, argv + 5))
+    return 1;
+
   tcp::acceptor acceptor(io_context, tcp::endpoint(tcp::v4(), port));
   std::vector<boost::shared_ptr<tcp_server> > servers;
 
@@ -16,6 +16,7 @@
 #include <cstring>
 #include <vector>
 #include "allocator.hpp"
+#include "io_uring_setup.hpp"
 
 using boost::asio::ip::udp;
 
@@ -94,11 +95,12 @@ private:
 
 int main(int argc, char* argv[])
 {
-  if (argc != 5)
+  if (argc < 5)
   {
     std::fprintf(stderr,
         "Usage: udp_server <port1> <nports> "
-        "<bufsize> {spin|block}\n");
+        "<bufsize> {spin|block} [io_uring options...]\n%s",
+        io_uring_usage());
     return 1;
   }
 
@@ -108,6 +110,9 @@ int main(int argc, char* argv[])
   bool spin = (std::strcmp(argv[4], "spin") == 0);
 
   boost::asio::io_context io_context(1);
+  if (!setup_io_uring(io_context, argc - 5, argv + 5))
+    return 1;
+
   std::vector<boost::shared_ptr<udp_server> > servers;
 
   for (unsigned short i = 0; i < num_ports; ++i)
@@ -17,8 +17,11 @@
 #include <boost/asio/recycling_allocator.hpp>
 
 #include "unit_test.hpp"
+#include <functional>
 #include <vector>
 #include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 
 void recycling_allocator_test()
 {
@@ -73,8 +76,56 @@ void recycling_allocator_test()
   BOOST_ASIO_CHECK(v.size() == 42);
 }
 
+void recycle_sizes(std::vector<char*>* blocks)
+{
+  boost::asio::recycling_allocator<char> a;
+
+  // Memory freed by a thread running an io_context is reused by the same
+  // thread for blocks of the same size class, across a range of sizes.
+  for (std::size_t size = 1; size <= 4096; size = size * 3 + 1)
+  {
+    char* p = a.allocate(size);
+    a.deallocate(p, size);
+    char* q = a.allocate(size);
+    BOOST_ASIO_CHECK(q == p);
+    blocks->push_back(q);
+  }
+}
+
+void release_sizes(std::vector<char*>* blocks)
+{
+  boost::asio::recycling_allocator<char> a;
+
+  std::size_t i = 0;
+  for (std::size_t size = 1; size <= 4096; size = size * 3 + 1)
+    a.deallocate((*blocks)[i++], size);
+}
+
+void recycling_allocator_reuse_test()
+{
+  std::vector<char*> blocks;
+
+  boost::asio::io_context ioc1;
+  boost::asio::post(ioc1, std::bind(recycle_sizes, &blocks));
+  ioc1.run();
+
+  // Blocks allocated on one thread may be freed on another.
+  boost::asio::io_context ioc2;
+  boost::asio::post(ioc2, std::bind(release_sizes, &blocks));
+  ioc2.run();
+
+  // Memory freed outside of any io_context is shared by all threads.
+  boost::asio::recycling_allocator<char> a;
+  char* p = a.allocate(1000);
+  a.deallocate(p, 1000);
+  char* q = a.allocate(1000);
+  BOOST_ASIO_CHECK(q == p);
+  a.deallocate(q, 1000);
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "recycling_allocator",
   BOOST_ASIO_TEST_CASE(recycling_allocator_test)
+  BOOST_ASIO_TEST_CASE(recycling_allocator_reuse_test)
 )
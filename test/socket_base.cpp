@@ -144,6 +144,43 @@ void test()
     (void)static_cast<bool>(!reuse_address1);
     (void)static_cast<bool>(reuse_address1.value());
 
+#if defined(SO_REUSEPORT)
+    // reuse_port class.
+
+    socket_base::reuse_port reuse_port1(true);
+    sock.set_option(reuse_port1);
+    socket_base::reuse_port reuse_port2;
+    sock.get_option(reuse_port2);
+    reuse_port1 = true;
+    (void)static_cast<bool>(reuse_port1);
+    (void)static_cast<bool>(!reuse_port1);
+    (void)static_cast<bool>(reuse_port1.value());
+#endif // defined(SO_REUSEPORT)
+
+#if defined(SO_INCOMING_CPU)
+    // incoming_cpu class.
+
+    socket_base::incoming_cpu incoming_cpu1(0);
+    sock.set_option(incoming_cpu1);
+    socket_base::incoming_cpu incoming_cpu2;
+    sock.get_option(incoming_cpu2);
+    incoming_cpu1 = 0;
+    (void)static_cast<int>(incoming_cpu1.value());
+#endif // defined(SO_INCOMING_CPU)
+
+#if defined(SO_ZEROCOPY)
+    // zero_copy class.
+
+    socket_base::zero_copy zero_copy1(true);
+    sock.set_option(zero_copy1);
+    socket_base::zero_copy zero_copy2;
+    sock.get_option(zero_copy2);
+    zero_copy1 = true;
+    (void)static_cast<bool>(zero_copy1);
+    (void)static_cast<bool>(!zero_copy1);
+    (void)static_cast<bool>(zero_copy1.value());
+#endif // defined(SO_ZEROCOPY)
+
     // linger class.
 
     socket_base::linger linger1(true, 30);
@@ -576,6 +613,32 @@ void test()
   BOOST_ASIO_CHECK(!static_cast<bool>(reuse_address4));
   BOOST_ASIO_CHECK(!reuse_address4);
 
+#if defined(SO_REUSEPORT)
+  // reuse_port class.
+
+  socket_base::reuse_port reuse_port1(true);
+  BOOST_ASIO_CHECK(reuse_port1.value());
+  BOOST_ASIO_CHECK(static_cast<bool>(reuse_port1));
+  BOOST_ASIO_CHECK(!!reuse_port1);
+  udp_sock.set_option(reuse_port1, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::reuse_port reuse_port2;
+  udp_sock.get_option(reuse_port2, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  BOOST_ASIO_CHECK(reuse_port2.value());
+
+  socket_base::reuse_port reuse_port3(false);
+  BOOST_ASIO_CHECK(!reuse_port3.value());
+  udp_sock.set_option(reuse_port3, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::reuse_port reuse_port4;
+  udp_sock.get_option(reuse_port4, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  BOOST_ASIO_CHECK(!reuse_port4.value());
+#endif // defined(SO_REUSEPORT)
+
   // linger class.
 
   socket_base::linger linger1(true, 60);
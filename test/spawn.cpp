@@ -0,0 +1,243 @@
+//
+// spawn.cpp
+// ~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/spawn.hpp>
+
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_BOOST_CONTEXT_FIBER)
+
+#include <cstring>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+
+//------------------------------------------------------------------------------
+
+// pooled_stack_allocator_spawn test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that coroutines run on stacks taken from a
+// pooled_stack_allocator, and that their stacks are returned to the pool when
+// they finish.
+
+namespace pooled_stack_allocator_spawn {
+
+using boost::asio::pooled_stack_allocator;
+
+void yield_several_times(int* count, boost::asio::yield_context yield)
+{
+  for (int i = 0; i < 3; ++i)
+    boost::asio::post(yield);
+  ++*count;
+}
+
+void test()
+{
+  boost::asio::io_context ioc;
+  pooled_stack_allocator stacks(64 * 1024, 8);
+  int count = 0;
+
+  for (int i = 0; i < 4; ++i)
+  {
+    boost::asio::spawn(ioc, std::allocator_arg, stacks,
+        [&count](boost::asio::yield_context yield)
+        {
+          yield_several_times(&count, yield);
+        }, boost::asio::detached);
+  }
+
+  BOOST_ASIO_CHECK(stacks.pooled() == 0);
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 4);
+  BOOST_ASIO_CHECK(stacks.pooled() == 4);
+}
+
+} // namespace pooled_stack_allocator_spawn
+
+//------------------------------------------------------------------------------
+
+// pooled_stack_allocator_reuse test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a coroutine started after another has
+// finished takes the stack that the first coroutine returned to the pool.
+
+namespace pooled_stack_allocator_reuse {
+
+using boost::asio::pooled_stack_allocator;
+
+void test()
+{
+  boost::asio::io_context ioc;
+  pooled_stack_allocator stacks(64 * 1024, 8);
+  char* locals[2] = { 0, 0 };
+  std::size_t pooled_while_running[2] = { 1, 1 };
+
+  for (int i = 0; i < 2; ++i)
+  {
+    boost::asio::spawn(ioc, std::allocator_arg, stacks,
+        [&, i](boost::asio::yield_context yield)
+        {
+          char local = 0;
+          locals[i] = &local;
+          pooled_while_running[i] = stacks.pooled();
+          boost::asio::post(yield);
+        }, boost::asio::detached);
+
+    ioc.restart();
+    ioc.run();
+
+    BOOST_ASIO_CHECK(stacks.pooled() == 1);
+  }
+
+  // The second coroutine took the only pooled stack.
+  BOOST_ASIO_CHECK(pooled_while_running[0] == 0);
+  BOOST_ASIO_CHECK(pooled_while_running[1] == 0);
+
+  // Both coroutines ran on the same stack.
+  BOOST_ASIO_CHECK(locals[0] != 0);
+  BOOST_ASIO_CHECK(locals[0] == locals[1]);
+}
+
+} // namespace pooled_stack_allocator_reuse
+
+//------------------------------------------------------------------------------
+
+// pooled_stack_allocator_max_pooled test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that no more than max_pooled stacks are kept for
+// reuse when more coroutines than that finish.
+
+namespace pooled_stack_allocator_max_pooled {
+
+using boost::asio::pooled_stack_allocator;
+
+void test()
+{
+  boost::asio::io_context ioc;
+  pooled_stack_allocator stacks(64 * 1024, 2);
+  int count = 0;
+
+  // All of the coroutines are alive at once, so each has its own stack.
+  for (int i = 0; i < 5; ++i)
+  {
+    boost::asio::spawn(ioc, std::allocator_arg, stacks,
+        [&count](boost::asio::yield_context yield)
+        {
+          boost::asio::post(yield);
+          ++count;
+        }, boost::asio::detached);
+  }
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 5);
+  BOOST_ASIO_CHECK(stacks.pooled() == 2);
+
+  // A copy of the allocator shares its pool.
+  pooled_stack_allocator copy(stacks);
+  boost::context::stack_context sctx = copy.allocate();
+  BOOST_ASIO_CHECK(stacks.pooled() == 1);
+  copy.deallocate(sctx);
+  BOOST_ASIO_CHECK(stacks.pooled() == 2);
+}
+
+} // namespace pooled_stack_allocator_max_pooled
+
+//------------------------------------------------------------------------------
+
+// pooled_stack_allocator_high_watermark test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that the greatest stack usage is reported when
+// the allocator tracks usage, and that nothing is reported otherwise.
+
+namespace pooled_stack_allocator_high_watermark {
+
+using boost::asio::pooled_stack_allocator;
+
+const std::size_t stack_size = 64 * 1024;
+const std::size_t buffer_size = 16 * 1024;
+
+void use_stack(char* volatile* sink, boost::asio::yield_context yield)
+{
+  char buffer[buffer_size];
+  std::memset(buffer, 1, sizeof(buffer));
+  *sink = buffer;
+  boost::asio::post(yield);
+}
+
+void run_one(boost::asio::io_context& ioc, pooled_stack_allocator& stacks)
+{
+  char* volatile sink = 0;
+  boost::asio::spawn(ioc, std::allocator_arg, stacks,
+      [&sink](boost::asio::yield_context yield)
+      {
+        use_stack(&sink, yield);
+      }, boost::asio::detached);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(sink != 0);
+}
+
+void test()
+{
+  boost::asio::io_context ioc;
+
+  pooled_stack_allocator tracked(stack_size, 8,
+      pooled_stack_allocator::guard_page
+        | pooled_stack_allocator::track_usage);
+  BOOST_ASIO_CHECK(tracked.high_watermark() == 0);
+
+  run_one(ioc, tracked);
+
+  std::size_t watermark = tracked.high_watermark();
+  BOOST_ASIO_CHECK(watermark >= buffer_size);
+  BOOST_ASIO_CHECK(watermark <= stack_size);
+
+  // A reused stack does not lower the watermark.
+  run_one(ioc, tracked);
+  BOOST_ASIO_CHECK(tracked.high_watermark() >= watermark);
+
+  pooled_stack_allocator untracked(stack_size, 8);
+  run_one(ioc, untracked);
+  BOOST_ASIO_CHECK(untracked.high_watermark() == 0);
+}
+
+} // namespace pooled_stack_allocator_high_watermark
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "spawn",
+  BOOST_ASIO_TEST_CASE(pooled_stack_allocator_spawn::test)
+  BOOST_ASIO_TEST_CASE(pooled_stack_allocator_reuse::test)
+  BOOST_ASIO_TEST_CASE(pooled_stack_allocator_max_pooled::test)
+  BOOST_ASIO_TEST_CASE(pooled_stack_allocator_high_watermark::test)
+)
+
+#else // defined(BOOST_ASIO_HAS_BOOST_CONTEXT_FIBER)
+
+BOOST_ASIO_TEST_SUITE
+(
+  "spawn",
+  BOOST_ASIO_TEST_CASE(null_test)
+)
+
+#endif // defined(BOOST_ASIO_HAS_BOOST_CONTEXT_FIBER)
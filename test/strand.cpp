@@ -448,6 +448,62 @@ void strand_execute_test()
   BOOST_ASIO_CHECK(count == 1);
 }
 
+void repost_increment(strand<io_context::executor_type>* s,
+    int* count, int limit)
+{
+  BOOST_ASIO_CHECK(s->running_in_this_thread());
+  if (++(*count) < limit)
+    post(*s, bindns::bind(repost_increment, s, count, limit));
+}
+
+std::size_t handoffs_for_chain(int length, std::size_t max_handlers)
+{
+  io_context ioc;
+  strand<io_context::executor_type> s = make_strand(ioc);
+  if (max_handlers != 0)
+    s.set_quantum(max_handlers);
+
+  int count = 0;
+  post(s, bindns::bind(repost_increment, &s, &count, length));
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == length);
+  BOOST_ASIO_CHECK(s.queue_depth() == 0);
+  return s.handoff_count();
+}
+
+void strand_quantum_test()
+{
+  // By default, a handler posted from within the strand runs only after the
+  // strand has been handed off to the underlying executor.
+  BOOST_ASIO_CHECK(handoffs_for_chain(11, 0) == 10);
+
+  // With a quantum, the strand keeps running on the same thread.
+  BOOST_ASIO_CHECK(handoffs_for_chain(11, 100) == 0);
+  BOOST_ASIO_CHECK(handoffs_for_chain(11, 4) == 2);
+  BOOST_ASIO_CHECK(handoffs_for_chain(11, 1) == 10);
+
+  // A time limit alone also keeps the strand running.
+  io_context ioc;
+  strand<io_context::executor_type> s = make_strand(ioc);
+  s.set_quantum(0, chrono::seconds(60));
+  int count = 0;
+  post(s, bindns::bind(repost_increment, &s, &count, 11));
+  ioc.run();
+  BOOST_ASIO_CHECK(count == 11);
+  BOOST_ASIO_CHECK(s.handoff_count() == 0);
+
+  // The queue depth counts the handlers waiting to run.
+  count = 0;
+  for (int i = 0; i < 5; ++i)
+    post(s, bindns::bind(increment, &count));
+  BOOST_ASIO_CHECK(s.queue_depth() == 5);
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(count == 5);
+  BOOST_ASIO_CHECK(s.queue_depth() == 0);
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "strand",
@@ -455,4 +511,5 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_COMPILE_TEST_CASE(strand_conversion_test)
   BOOST_ASIO_TEST_CASE(strand_query_test)
   BOOST_ASIO_TEST_CASE(strand_execute_test)
+  BOOST_ASIO_TEST_CASE(strand_quantum_test)
 )
@@ -488,6 +488,96 @@ void system_timer_op_cancel_test()
   BOOST_ASIO_CHECK(ioc.stopped());
 }
 
+struct reschedule_record
+{
+  boost::asio::system_timer::time_point completed;
+  boost::system::error_code ec;
+  int calls;
+};
+
+void record_completion(reschedule_record* r,
+    const boost::system::error_code& ec)
+{
+  r->completed = now();
+  r->ec = ec;
+  ++r->calls;
+}
+
+void push_back_timer(boost::asio::system_timer* ticker,
+    boost::asio::system_timer* t, int* ticks,
+    boost::asio::system_timer::time_point* last_expiry)
+{
+  t->reschedule_after(boost::asio::chrono::milliseconds(50));
+  *last_expiry = t->expiry();
+  if (--(*ticks) > 0)
+  {
+    ticker->expires_after(boost::asio::chrono::milliseconds(10));
+    ticker->async_wait(bindns::bind(push_back_timer,
+          ticker, t, ticks, last_expiry));
+  }
+}
+
+void system_timer_reschedule_test()
+{
+  using boost::asio::chrono::milliseconds;
+  using boost::asio::chrono::seconds;
+
+  boost::asio::io_context ioc;
+
+  // Pushing the expiry back repeatedly while the wait is pending leads to a
+  // single successful completion at the final expiry time.
+  reschedule_record r1 = {};
+  boost::asio::system_timer t1(ioc, milliseconds(30));
+  t1.async_wait(bindns::bind(record_completion, &r1, bindns::placeholders::_1));
+
+  int ticks = 5;
+  boost::asio::system_timer::time_point last_expiry;
+  boost::asio::system_timer ticker(ioc, milliseconds(10));
+  ticker.async_wait(bindns::bind(push_back_timer,
+        &ticker, &t1, &ticks, &last_expiry));
+
+  // Bringing the expiry forward applies to every pending wait.
+  reschedule_record r2 = {};
+  reschedule_record r3 = {};
+  boost::asio::system_timer t2(ioc, seconds(60));
+  t2.async_wait(bindns::bind(record_completion, &r2, bindns::placeholders::_1));
+  t2.async_wait(bindns::bind(record_completion, &r3, bindns::placeholders::_1));
+  t2.reschedule_after(milliseconds(20));
+  boost::asio::system_timer::time_point t2_expiry = t2.expiry();
+
+  // A timer without pending waits simply takes on the new expiry.
+  boost::asio::system_timer t3(ioc);
+  t3.reschedule_after(milliseconds(40));
+  BOOST_ASIO_CHECK(t3.expiry() > now());
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(ticks == 0);
+  BOOST_ASIO_CHECK(r1.calls == 1);
+  BOOST_ASIO_CHECK(!r1.ec);
+  BOOST_ASIO_CHECK(r1.completed >= last_expiry);
+  BOOST_ASIO_CHECK(r2.calls == 1);
+  BOOST_ASIO_CHECK(!r2.ec);
+  BOOST_ASIO_CHECK(r2.completed >= t2_expiry);
+  BOOST_ASIO_CHECK(r2.completed < t2_expiry + seconds(30));
+  BOOST_ASIO_CHECK(r3.calls == 1);
+  BOOST_ASIO_CHECK(!r3.ec);
+
+  // Cancellation still finds a wait whose expiry has been pushed back.
+  reschedule_record r4 = {};
+  boost::asio::system_timer t4(ioc, milliseconds(10));
+  t4.async_wait(bindns::bind(record_completion, &r4, bindns::placeholders::_1));
+  t4.reschedule_after(seconds(60));
+  boost::asio::system_timer canceller(ioc, milliseconds(20));
+  canceller.async_wait(bindns::bind(cancel_timer, &t4));
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(r4.calls == 1);
+  BOOST_ASIO_CHECK(r4.ec == boost::asio::error::operation_aborted);
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "system_timer",
@@ -497,4 +587,5 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(system_timer_thread_test)
   BOOST_ASIO_TEST_CASE(system_timer_move_test)
   BOOST_ASIO_TEST_CASE(system_timer_op_cancel_test)
+  BOOST_ASIO_TEST_CASE(system_timer_reschedule_test)
 )
@@ -0,0 +1,264 @@
+//
+// timer_wheel_traits.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/timer_wheel_traits.hpp>
+
+#include <functional>
+#include <vector>
+#include <boost/asio/basic_waitable_timer.hpp>
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/io_context.hpp>
+#include "unit_test.hpp"
+
+namespace bindns = std;
+
+// A fine tick, so that the timers below are spread over several levels of
+// the wheel without making the tests slow.
+typedef boost::asio::timer_wheel_traits<
+    boost::asio::chrono::steady_clock, 10> fine_traits;
+
+typedef boost::asio::basic_waitable_timer<
+    boost::asio::chrono::steady_clock, fine_traits> fine_timer;
+
+typedef boost::asio::basic_waitable_timer<
+    boost::asio::chrono::steady_clock,
+    boost::asio::timer_wheel_traits<
+      boost::asio::chrono::steady_clock>> default_timer;
+
+struct expiry_record
+{
+  fine_timer::time_point expiry;
+  fine_timer::time_point completed;
+  boost::system::error_code ec;
+  int calls;
+};
+
+void record_expiry(expiry_record* r, const boost::system::error_code& ec)
+{
+  r->completed = fine_timer::clock_type::now();
+  r->ec = ec;
+  ++r->calls;
+}
+
+void timer_wheel_expiry_test()
+{
+  using boost::asio::chrono::microseconds;
+
+  boost::asio::io_context ioc;
+
+  // Expiry times spread from the past to a quarter of a second ahead, in an
+  // order unrelated to when they expire.
+  const int num_timers = 200;
+  std::vector<fine_timer*> timers;
+  std::vector<expiry_record> records(num_timers);
+  fine_timer::time_point start = fine_timer::clock_type::now();
+  for (int i = 0; i < num_timers; ++i)
+  {
+    long usec = ((i * 7919L) % num_timers) * 1250L - 5000L;
+    timers.push_back(new fine_timer(ioc, start + microseconds(usec)));
+    records[i].expiry = timers[i]->expiry();
+    records[i].calls = 0;
+    timers[i]->async_wait(bindns::bind(record_expiry,
+          &records[i], bindns::placeholders::_1));
+  }
+
+  ioc.run();
+
+  // Every wait completes exactly once, and never before its expiry time.
+  for (int i = 0; i < num_timers; ++i)
+  {
+    BOOST_ASIO_CHECK(records[i].calls == 1);
+    BOOST_ASIO_CHECK(!records[i].ec);
+    BOOST_ASIO_CHECK(!(records[i].completed < records[i].expiry));
+    delete timers[i];
+  }
+}
+
+void timer_wheel_cancel_test()
+{
+  using boost::asio::chrono::milliseconds;
+
+  boost::asio::io_context ioc;
+
+  const int num_timers = 100;
+  std::vector<fine_timer*> timers;
+  std::vector<expiry_record> records(num_timers);
+  for (int i = 0; i < num_timers; ++i)
+  {
+    timers.push_back(new fine_timer(ioc, milliseconds(10 + i)));
+    records[i].calls = 0;
+    timers[i]->async_wait(bindns::bind(record_expiry,
+          &records[i], bindns::placeholders::_1));
+  }
+
+  // Cancel every other timer, and re-arm every third one further out.
+  for (int i = 0; i < num_timers; i += 2)
+    BOOST_ASIO_CHECK(timers[i]->cancel() == 1);
+  for (int i = 1; i < num_timers; i += 6)
+  {
+    BOOST_ASIO_CHECK(timers[i]->cancel() == 1);
+    timers[i]->expires_after(milliseconds(150));
+    records[i].expiry = timers[i]->expiry();
+    timers[i]->async_wait(bindns::bind(record_expiry,
+          &records[i], bindns::placeholders::_1));
+  }
+
+  ioc.run();
+
+  for (int i = 0; i < num_timers; ++i)
+  {
+    if (i % 2 == 0)
+    {
+      BOOST_ASIO_CHECK(records[i].calls == 1);
+      BOOST_ASIO_CHECK(records[i].ec == boost::asio::error::operation_aborted);
+    }
+    else if (i % 6 == 1)
+    {
+      // One aborted completion from the cancel, then the re-armed wait.
+      BOOST_ASIO_CHECK(records[i].calls == 2);
+      BOOST_ASIO_CHECK(!records[i].ec);
+      BOOST_ASIO_CHECK(!(records[i].completed < records[i].expiry));
+    }
+    else
+    {
+      BOOST_ASIO_CHECK(records[i].calls == 1);
+      BOOST_ASIO_CHECK(!records[i].ec);
+    }
+    delete timers[i];
+  }
+}
+
+void timer_wheel_move_test()
+{
+  using boost::asio::chrono::milliseconds;
+
+  boost::asio::io_context ioc;
+
+  expiry_record records[3] = {};
+  fine_timer t1(ioc, milliseconds(20));
+  fine_timer t2(ioc, milliseconds(20));
+  fine_timer t3(ioc, milliseconds(30));
+  t1.async_wait(bindns::bind(record_expiry,
+        &records[0], bindns::placeholders::_1));
+  t2.async_wait(bindns::bind(record_expiry,
+        &records[1], bindns::placeholders::_1));
+  t3.async_wait(bindns::bind(record_expiry,
+        &records[2], bindns::placeholders::_1));
+
+  // Moving a timer relinks its pending wait, including within a shared slot.
+  fine_timer t4(static_cast<fine_timer&&>(t2));
+  fine_timer t5(ioc);
+  t5 = static_cast<fine_timer&&>(t3);
+
+  // Cancelling the moved-to timer must find the wait in the wheel.
+  BOOST_ASIO_CHECK(t5.cancel() == 1);
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(records[0].calls == 1);
+  BOOST_ASIO_CHECK(!records[0].ec);
+  BOOST_ASIO_CHECK(records[1].calls == 1);
+  BOOST_ASIO_CHECK(!records[1].ec);
+  BOOST_ASIO_CHECK(records[2].calls == 1);
+  BOOST_ASIO_CHECK(records[2].ec == boost::asio::error::operation_aborted);
+}
+
+void timer_wheel_op_cancel_test()
+{
+  using boost::asio::chrono::seconds;
+
+  boost::asio::io_context ioc;
+  boost::asio::cancellation_signal cancel_signal;
+
+  expiry_record records[2] = {};
+  default_timer t(ioc, seconds(10));
+  t.async_wait(bindns::bind(record_expiry,
+        &records[0], bindns::placeholders::_1));
+  t.async_wait(
+      boost::asio::bind_cancellation_slot(cancel_signal.slot(),
+        bindns::bind(record_expiry, &records[1], bindns::placeholders::_1)));
+
+  ioc.poll();
+  cancel_signal.emit(boost::asio::cancellation_type::all);
+  ioc.poll();
+
+  BOOST_ASIO_CHECK(records[0].calls == 0);
+  BOOST_ASIO_CHECK(records[1].calls == 1);
+  BOOST_ASIO_CHECK(records[1].ec == boost::asio::error::operation_aborted);
+
+  BOOST_ASIO_CHECK(t.cancel() == 1);
+  ioc.run();
+
+  BOOST_ASIO_CHECK(records[0].calls == 1);
+  BOOST_ASIO_CHECK(records[0].ec == boost::asio::error::operation_aborted);
+}
+
+void timer_wheel_reschedule_test()
+{
+  using boost::asio::chrono::milliseconds;
+  using boost::asio::chrono::seconds;
+
+  boost::asio::io_context ioc;
+
+  // Move some expiries later and some earlier, across levels of the wheel,
+  // while their waits are pending.
+  const int num_timers = 50;
+  std::vector<fine_timer*> timers;
+  std::vector<expiry_record> records(num_timers);
+  for (int i = 0; i < num_timers; ++i)
+  {
+    timers.push_back(new fine_timer(ioc, milliseconds(i % 2 ? 5 : 5000)));
+    records[i].calls = 0;
+    timers[i]->async_wait(bindns::bind(record_expiry,
+          &records[i], bindns::placeholders::_1));
+  }
+  for (int i = 0; i < num_timers; ++i)
+  {
+    timers[i]->reschedule_after(milliseconds(20 + 2 * i));
+    records[i].expiry = timers[i]->expiry();
+  }
+
+  // A pushed back wait can still be cancelled.
+  expiry_record cancelled = {};
+  fine_timer t(ioc, milliseconds(10));
+  t.async_wait(bindns::bind(record_expiry,
+        &cancelled, bindns::placeholders::_1));
+  t.reschedule_after(seconds(60));
+  BOOST_ASIO_CHECK(t.cancel() == 1);
+
+  ioc.run();
+
+  for (int i = 0; i < num_timers; ++i)
+  {
+    BOOST_ASIO_CHECK(records[i].calls == 1);
+    BOOST_ASIO_CHECK(!records[i].ec);
+    BOOST_ASIO_CHECK(!(records[i].completed < records[i].expiry));
+    delete timers[i];
+  }
+  BOOST_ASIO_CHECK(cancelled.calls == 1);
+  BOOST_ASIO_CHECK(cancelled.ec == boost::asio::error::operation_aborted);
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "timer_wheel_traits",
+  BOOST_ASIO_TEST_CASE(timer_wheel_expiry_test)
+  BOOST_ASIO_TEST_CASE(timer_wheel_cancel_test)
+  BOOST_ASIO_TEST_CASE(timer_wheel_move_test)
+  BOOST_ASIO_TEST_CASE(timer_wheel_op_cancel_test)
+  BOOST_ASIO_TEST_CASE(timer_wheel_reschedule_test)
+)
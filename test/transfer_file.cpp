@@ -0,0 +1,189 @@
+//
+// transfer_file.cpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2023 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/transfer_file.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// transfer_file_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a range of a file is sent on a socket, and
+// that the end of the file is reported when the range extends beyond it.
+
+namespace transfer_file_runtime {
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+// A temporary file that provides the native handle expected of a file object.
+class test_file
+{
+public:
+  explicit test_file(const std::vector<char>& data)
+    : file_(std::tmpfile())
+  {
+    if (file_)
+    {
+      std::fwrite(&data[0], 1, data.size(), file_);
+      std::fflush(file_);
+    }
+  }
+
+  ~test_file()
+  {
+    if (file_)
+      std::fclose(file_);
+  }
+
+  bool is_open() const
+  {
+    return file_ != 0;
+  }
+
+  int native_handle() const
+  {
+    return fileno(file_);
+  }
+
+private:
+  test_file(const test_file&) = delete;
+  test_file& operator=(const test_file&) = delete;
+
+  std::FILE* file_;
+};
+
+void handle_transfer(const boost::system::error_code& err,
+    std::size_t bytes_transferred, boost::system::error_code* out_err,
+    std::size_t* out_bytes_transferred)
+{
+  *out_err = err;
+  *out_bytes_transferred = bytes_transferred;
+}
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+void test()
+{
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+  using namespace std; // For memcmp.
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  std::vector<char> data(1024 * 1024 + 123);
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+
+  test_file file(data);
+  BOOST_ASIO_CHECK(file.is_open());
+  if (!file.is_open())
+    return;
+
+  io_context ioc;
+
+  ip::tcp::acceptor acceptor(ioc, ip::tcp::endpoint(ip::tcp::v4(), 0));
+  ip::tcp::endpoint server_endpoint = acceptor.local_endpoint();
+  server_endpoint.address(ip::address_v4::loopback());
+
+  ip::tcp::socket client_side_socket(ioc);
+  ip::tcp::socket server_side_socket(ioc);
+
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  // Send a range from the middle of the file, larger than the socket buffers.
+
+  const std::size_t offset = 1000;
+  const std::size_t length = data.size() - 2000;
+  std::vector<char> received(length);
+
+  boost::system::error_code read_ec;
+  std::size_t read_bytes = 0;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(received),
+      bindns::bind(handle_transfer, _1, _2, &read_ec, &read_bytes));
+
+  boost::system::error_code transfer_ec;
+  std::size_t transfer_bytes = 0;
+  boost::asio::async_transfer_file(file, offset, length, server_side_socket,
+      bindns::bind(handle_transfer, _1, _2, &transfer_ec, &transfer_bytes));
+
+  ioc.run();
+  BOOST_ASIO_CHECK(!transfer_ec);
+  BOOST_ASIO_CHECK(transfer_bytes == length);
+  BOOST_ASIO_CHECK(!read_ec);
+  BOOST_ASIO_CHECK(read_bytes == length);
+  BOOST_ASIO_CHECK(memcmp(&received[0], &data[offset], length) == 0);
+
+  // A range that extends beyond the end of the file sends the data that
+  // exists and then fails with eof.
+
+  const std::size_t tail_offset = data.size() - 100;
+  std::vector<char> tail(100);
+
+  read_ec = boost::system::error_code();
+  read_bytes = 0;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(tail),
+      bindns::bind(handle_transfer, _1, _2, &read_ec, &read_bytes));
+
+  transfer_ec = boost::system::error_code();
+  transfer_bytes = 0;
+  server_side_socket.async_send_file(file, tail_offset, 1000,
+      bindns::bind(handle_transfer, _1, _2, &transfer_ec, &transfer_bytes));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(transfer_ec == boost::asio::error::eof);
+  BOOST_ASIO_CHECK(transfer_bytes == tail.size());
+  BOOST_ASIO_CHECK(!read_ec);
+  BOOST_ASIO_CHECK(read_bytes == tail.size());
+  BOOST_ASIO_CHECK(memcmp(&tail[0], &data[tail_offset], tail.size()) == 0);
+
+  // An empty range completes immediately.
+
+  transfer_ec = boost::asio::error::fault;
+  transfer_bytes = 1;
+  boost::asio::async_transfer_file(file, 0, 0, server_side_socket,
+      bindns::bind(handle_transfer, _1, _2, &transfer_ec, &transfer_bytes));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(!transfer_ec);
+  BOOST_ASIO_CHECK(transfer_bytes == 0);
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+}
+
+} // namespace transfer_file_runtime
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "transfer_file",
+  BOOST_ASIO_TEST_CASE(transfer_file_runtime::test)
+)